@@ -0,0 +1,283 @@
+/*
+Author: Dan Rehberg
+Modified Date: 10/19/2026
+*/
+#include "DatasetLoader.hpp"
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+template <typename T, typename Acc>
+std::string BasicDatasetLoader<T, Acc>::mPath;
+template <typename T, typename Acc>
+std::vector<typename BasicDatasetLoader<T, Acc>::Chunk> BasicDatasetLoader<T, Acc>::mChunks;
+template <typename T, typename Acc>
+std::vector<typename BasicDatasetLoader<T, Acc>::Failure> BasicDatasetLoader<T, Acc>::mFailures;
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc>* BasicDatasetLoader<T, Acc>::mFeatures = nullptr;
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc>* BasicDatasetLoader<T, Acc>::mTargets = nullptr;
+template <typename T, typename Acc>
+size_t BasicDatasetLoader<T, Acc>::mColumns = 0;
+template <typename T, typename Acc>
+size_t BasicDatasetLoader<T, Acc>::mTargetColumn = 0;
+template <typename T, typename Acc>
+size_t BasicDatasetLoader<T, Acc>::mTargetCount = 0;
+
+static bool blank(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+static const char* skipBlanks(const char* p, const char* end)
+{
+	while (p < end && blank(*p))++p;
+	return p;
+}
+
+//Hands each field of the line [p, end) to store(column, value), fields split by a comma or by blanks
+//	count is the fields stored, false at a field that is not a number (count is then its index)
+template <typename Acc, typename Store>
+static bool parseFields(const char* p, const char* end, size_t& count, Store store)
+{
+	count = 0;
+	p = skipBlanks(p, end);
+	while (p < end)
+	{
+		if (*p == '+')++p;//from_chars takes a leading minus only
+		Acc value;
+		std::from_chars_result result = std::from_chars(p, end, value);
+		if (result.ec == std::errc::result_out_of_range)
+		{
+			//Under a float's smallest normal, e.g., 1e-40, parsed wide and rounded as any other stored value
+			double wide;
+			result = std::from_chars(p, end, wide);
+			value = static_cast<Acc>(wide);
+		}
+		if (result.ec != std::errc())return false;
+		p = skipBlanks(result.ptr, end);
+		if (p < end && p == result.ptr && *p != ',')return false;//Something other than a separator right after the number
+		store(count++, value);
+		if (p < end && *p == ',')
+		{
+			p = skipBlanks(p + 1, end);
+			if (p == end)return false;//A trailing comma is an empty field
+		}
+	}
+	return true;
+}
+
+template <typename T, typename Acc>
+uint64_t BasicDatasetLoader<T, Acc>::prepare(const std::string& path, Dense& features, Dense& targets, size_t targetColumn,
+	size_t targetCount, bool skipHeader)
+{
+	std::ifstream in(path, std::ios::binary);
+	if (!in)throw std::runtime_error(R"(Could not open the dataset: )" + path);
+	mChunks.clear();
+	std::vector<char> block(DATASET_CHUNK_BYTES);
+	uint64_t offset = 0, lineBegin = 0, chunkStart = 0, firstData = 0;
+	size_t rows = 0, line = 1, chunkRow = 0, chunkLine = 1, firstDataLine = 0;
+	bool content = false, header = skipHeader;
+	//Closes the line ending just before next: counts it when it held anything, and starts a chunk after it
+	//	once the current one has DATASET_CHUNK_BYTES of whole lines
+	auto endLine = [&](uint64_t next)
+	{
+		if (content && header)
+		{
+			header = false;
+			chunkStart = next;
+			chunkLine = line + 1;
+		}
+		else if (content)
+		{
+			if (rows++ == 0)
+			{
+				firstData = lineBegin;
+				firstDataLine = line;
+			}
+		}
+		++line;
+		content = false;
+		lineBegin = next;
+		if (!header && next - chunkStart >= DATASET_CHUNK_BYTES)
+		{
+			mChunks.push_back(Chunk{ chunkStart, next - chunkStart, chunkRow, chunkLine });
+			chunkStart = next;
+			chunkRow = rows;
+			chunkLine = line;
+		}
+	};
+	while (in)
+	{
+		in.read(block.data(), block.size());
+		size_t n = static_cast<size_t>(in.gcount());
+		if (n == 0)break;
+		const char* b = block.data();
+		size_t i = 0;
+		while (i < n)
+		{
+			if (!content)
+			{
+				//Leading blanks decide whether the line holds anything, after that only its end matters
+				if (b[i] == '\n')
+				{
+					endLine(offset + ++i);
+					continue;
+				}
+				if (blank(b[i]))
+				{
+					++i;
+					continue;
+				}
+				content = true;
+			}
+			const char* newline = static_cast<const char*>(std::memchr(b + i, '\n', n - i));
+			if (newline == nullptr)break;
+			i = static_cast<size_t>(newline - b) + 1;
+			endLine(offset + i);
+		}
+		offset += n;
+	}
+	if (content)endLine(offset);//A last line without a newline
+	if (offset > chunkStart)mChunks.push_back(Chunk{ chunkStart, offset - chunkStart, chunkRow, chunkLine });
+	if (rows == 0)throw std::length_error(R"(The dataset has no samples: )" + path);
+	//The first sample's fields are the columns every other line must have
+	in.clear();
+	in.seekg(static_cast<std::streamoff>(firstData));
+	std::string first;
+	std::getline(in, first);
+	size_t columns = 0;
+	if (!parseFields<Acc>(first.data(), first.data() + first.size(), columns, [](size_t, Acc) {}))
+		throw std::range_error(R"(Dataset line )" + std::to_string(firstDataLine) + " of " + path + ": column " +
+			std::to_string(columns + 1) + " is not a number");
+	if (targetCount == 0 || targetColumn + targetCount > columns || targetCount >= columns)
+		throw std::range_error(R"(Dataset targets must be inside its columns and leave at least one feature: columns: )" +
+			std::to_string(columns) + " targets start at: " + std::to_string(targetColumn) + " count: " + std::to_string(targetCount));
+	features.resize(rows, columns - targetCount);
+	targets.resize(rows, targetCount);
+	mPath = path;
+	mFeatures = &features;
+	mTargets = &targets;
+	mColumns = columns;
+	mTargetColumn = targetColumn;
+	mTargetCount = targetCount;
+	mFailures.assign(mChunks.size(), Failure{ 0, 0, Failure::None });
+	return mChunks.size();
+}
+
+template <typename T, typename Acc>
+void BasicDatasetLoader<T, Acc>::parseChunks(uint64_t start, uint64_t end)
+{
+	//A chunk's bytes per thread, grown once and kept, plus its own stream so chunks are read in parallel too
+	static thread_local std::vector<char> buffer;
+	Dense& X = *mFeatures;
+	Dense& Y = *mTargets;
+	bool rowMajorX = X.layout == MatrixLayout::RowMajor, rowMajorY = Y.layout == MatrixLayout::RowMajor;
+	size_t targetEnd = mTargetColumn + mTargetCount;
+	for (uint64_t c = start; c < end; ++c)
+	{
+		const Chunk& chunk = mChunks[c];
+		Failure& failure = mFailures[c];
+		if (buffer.size() < chunk.length)buffer.resize(chunk.length);
+		std::ifstream in(mPath, std::ios::binary);
+		in.seekg(static_cast<std::streamoff>(chunk.offset));
+		in.read(buffer.data(), static_cast<std::streamsize>(chunk.length));
+		if (static_cast<uint64_t>(in.gcount()) != chunk.length)
+		{
+			failure = Failure{ chunk.firstLine, 0, Failure::Read };
+			continue;
+		}
+		const char* p = buffer.data();
+		const char* chunkEnd = p + chunk.length;
+		size_t row = chunk.firstRow, line = chunk.firstLine;
+		while (p < chunkEnd)
+		{
+			const char* newline = static_cast<const char*>(std::memchr(p, '\n', chunkEnd - p));
+			const char* lineEnd = newline == nullptr ? chunkEnd : newline;
+			if (skipBlanks(p, lineEnd) == lineEnd)
+			{
+				++line;
+				p = lineEnd + 1;
+				continue;
+			}
+			if (row >= X.rows)
+			{
+				failure = Failure{ line, 0, Failure::Read };//More samples than counted, the file changed
+				break;
+			}
+			T* x = X.data + (rowMajorX ? row * X.stride : row);
+			T* y = Y.data + (rowMajorY ? row * Y.stride : row);
+			size_t xStep = rowMajorX ? 1 : X.stride, yStep = rowMajorY ? 1 : Y.stride;
+			size_t count = 0;
+			bool parsed = parseFields<Acc>(p, lineEnd, count, [&](size_t column, Acc value)
+			{
+				if (column >= mColumns)return;//Counted, the line is reported below
+				if (column < mTargetColumn)x[column * xStep] = static_cast<T>(value);
+				else if (column < targetEnd)y[(column - mTargetColumn) * yStep] = static_cast<T>(value);
+				else x[(column - mTargetCount) * xStep] = static_cast<T>(value);
+			});
+			if (!parsed)
+			{
+				failure = Failure{ line, count + 1, Failure::Number };
+				break;
+			}
+			if (count != mColumns)
+			{
+				failure = Failure{ line, count, Failure::Columns };
+				break;
+			}
+			++row;
+			++line;
+			p = lineEnd + 1;
+		}
+	}
+}
+
+template <typename T, typename Acc>
+void BasicDatasetLoader<T, Acc>::check()
+{
+	//The first bad line in the file, whichever thread found it
+	for (const Failure& failure : mFailures)
+	{
+		if (failure.kind == Failure::Columns)throw std::length_error(R"(Dataset line )" + std::to_string(failure.line) + " of " +
+			mPath + " has " + std::to_string(failure.found) + " columns, expected " + std::to_string(mColumns));
+		if (failure.kind == Failure::Number)throw std::range_error(R"(Dataset line )" + std::to_string(failure.line) + " of " +
+			mPath + ": column " + std::to_string(failure.found) + " is not a number");
+		if (failure.kind == Failure::Read)throw std::runtime_error(R"(Could not read the dataset from line )" +
+			std::to_string(failure.line) + ", or it changed while loading: " + mPath);
+	}
+}
+
+template <typename T, typename Acc>
+void BasicDatasetLoader<T, Acc>::load(const std::string& path, Dense& features, Dense& targets, size_t targetColumn, size_t targetCount,
+	bool skipHeader)
+{
+	parseChunks(0, prepare(path, features, targets, targetColumn, targetCount, skipHeader));
+	check();
+}
+
+template <typename T, typename Acc>
+uint64_t BasicDatasetLoader<T, Acc>::setParallelLoadOps(const std::string& path, Dense& features, Dense& targets, size_t targetColumn,
+	size_t targetCount, bool skipHeader)
+{
+	return prepare(path, features, targets, targetColumn, targetCount, skipHeader);
+}
+
+template <typename T, typename Acc>
+void BasicDatasetLoader<T, Acc>::parallelRange(std::mutex&, uint64_t start, uint64_t end)
+{
+	parseChunks(start, end);
+}
+
+template <typename T, typename Acc>
+void BasicDatasetLoader<T, Acc>::checkParallelLoad()
+{
+	check();
+}
+
+template class BasicDatasetLoader<float>;
+template class BasicDatasetLoader<double>;
+template class BasicDatasetLoader<BFloat16>;
+template class BasicDatasetLoader<Float16>;
\ No newline at end of file
@@ -0,0 +1,73 @@
+/*
+Author: Dan Rehberg
+Modified Date: 10/19/2026
+Purpose: Text datasets straight into SerialMatrix, one sample per line of comma or whitespace separated numbers.
+	Two passes over the file, neither holding more than a chunk of it:
+		the first streams it to count the samples and the columns, and cuts it into chunks of whole lines,
+			so X and T are sized once before any value is parsed;
+		the second parses the chunks with std::from_chars, each chunk's rows known from the first pass,
+			so the chunks are independent tasks for a ThreadPool, writing their rows of X and T where they are.
+	Columns [targetColumn, targetColumn + targetCount) of each line are T, every other column is X, split as they are parsed.
+	Blank lines are skipped, a header line can be; a line with another column count, or a field that is not a number,
+		throws with its line number, from load or from checkParallelLoad once a dispatch returns.
+	BasicDatasetLoader<T, Acc> loads BasicSerialMatrix<T, Acc>, parsing as Acc; DatasetLoader is the float one.
+*/
+
+#ifndef __DATASET_LOADER__
+#define __DATASET_LOADER__
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "SerialMatrix.hpp"
+
+//Bytes read at a time by the counting pass, and roughly the bytes of whole lines in each parsing task
+#define DATASET_CHUNK_BYTES (1 << 22)
+
+template <typename T, typename Acc = typename MatrixAccumulator<T>::type>
+class BasicDatasetLoader
+{
+public:
+	typedef BasicSerialMatrix<T, Acc> Dense;
+	//features (X) and targets (T) are resized to the samples, their layouts kept
+	static void load(const std::string& path, Dense& features, Dense& targets, size_t targetColumn, size_t targetCount = 1,
+		bool skipHeader = false);
+	//load on the pool: the counting pass runs here, the chunks it returns are the tasks to parallelRange,
+	//	then checkParallelLoad throws for the first bad line; the matrices must stay valid until then
+	static uint64_t setParallelLoadOps(const std::string& path, Dense& features, Dense& targets, size_t targetColumn,
+		size_t targetCount = 1, bool skipHeader = false);
+	static void parallelRange(std::mutex& m, uint64_t startChunk, uint64_t endChunk);
+	static void checkParallelLoad();
+private:
+	struct Chunk
+	{
+		uint64_t offset, length;//Bytes of whole lines
+		size_t firstRow, firstLine;//First sample in it, and its line in the file counting from 1
+	};
+	struct Failure
+	{
+		enum Kind { None, Columns, Number, Read };
+		size_t line;//In the file, counting from 1
+		size_t found;//Columns on the line, or the column that is not a number
+		Kind kind;
+	};
+	static std::string mPath;//setParallelLoadOps state
+	static std::vector<Chunk> mChunks;
+	static std::vector<Failure> mFailures;//One per chunk
+	static Dense* mFeatures, * mTargets;
+	static size_t mColumns, mTargetColumn, mTargetCount;
+	static uint64_t prepare(const std::string& path, Dense& features, Dense& targets, size_t targetColumn, size_t targetCount, bool skipHeader);
+	static void parseChunks(uint64_t startChunk, uint64_t endChunk);
+	static void check();
+};
+
+typedef BasicDatasetLoader<float> DatasetLoader;
+
+extern template class BasicDatasetLoader<float>;
+extern template class BasicDatasetLoader<double>;
+extern template class BasicDatasetLoader<BFloat16>;
+extern template class BasicDatasetLoader<Float16>;
+
+#endif // !__DATASET_LOADER__
\ No newline at end of file
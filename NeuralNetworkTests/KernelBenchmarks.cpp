@@ -0,0 +1,827 @@
+/*
+Author: Dan Rehberg
+Modified Date: 10/19/2026
+*/
+#include "KernelBenchmarks.hpp"
+#include "DatasetLoader.hpp"
+#include "MatrixBufferPool.hpp"
+#include "MatrixFile.hpp"
+#include "MatrixKernels.hpp"
+#include "SerialMatrix.hpp"
+#include "SparseMatrix.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+size_t KernelBenchmarks::trialsFor(double flops)
+{
+	//Roughly a quarter second of work at 1 GFLOP/s
+	return std::max<size_t>(1, static_cast<size_t>(2.5e8 / flops));
+}
+
+template <typename Workload>
+double KernelBenchmarks::timeTrials(size_t trials, Workload workload, size_t warmUps)
+{
+	for (size_t t = 0; t < warmUps; ++t)workload();
+	std::chrono::time_point<std::chrono::steady_clock> startTime = std::chrono::steady_clock::now();
+	for (size_t t = 0; t < trials; ++t)workload();
+	std::chrono::time_point<std::chrono::steady_clock> endTime = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::milli>(endTime - startTime).count() / trials;
+}
+
+std::string KernelBenchmarks::rate(double ms, double work, const char* unit)
+{
+	std::ostringstream text;
+	text << ms << " ms (" << work / (ms * 1e6) << " " << unit << ")";
+	return text.str();
+}
+
+void KernelBenchmarks::all()
+{
+	gemm();
+	isa();
+	fusion();
+	layer();
+	tanh();
+	elementTypes();
+	parallelOps();
+	transpose();
+	strassen();
+	bufferPool();
+	layouts();
+	sparse();
+	batched();
+	matrixFile();
+	datasetLoader();
+	rvalues();
+	vectorProducts();
+}
+
+void KernelBenchmarks::gemm(size_t minSize, size_t maxSize)
+{
+	std::cout << "\nGEMM: naive dot product per element vs packed and blocked\n";
+	for (size_t n = minSize; n <= maxSize; n <<= 1)
+	{
+		std::vector<float> A(n * n), B(n * n), C0(n * n), C1(n * n);
+		for (size_t i = 0; i < n * n; ++i)
+		{
+			A[i] = static_cast<float>((i * 7) % 13) * 0.1f - 0.6f;
+			B[i] = static_cast<float>((i * 5) % 11) * 0.1f - 0.5f;
+		}
+		double flops = 2.0 * static_cast<double>(n) * static_cast<double>(n) * static_cast<double>(n);
+		size_t trials = trialsFor(flops);
+		double naive = timeTrials(trials, [&]() { MatrixKernels::gemmNaive(n, n, n, A.data(), n, B.data(), n, C0.data(), n); });
+		double blocked = timeTrials(trials, [&]()
+		{
+			MatrixKernels::gemm(n, n, n, 1.0f, A.data(), n, B.data(), n, 0.0f, C1.data(), n);
+		});
+
+		float maxError = 0.0f;
+		for (size_t i = 0; i < n * n; ++i)maxError = std::max(maxError, std::abs(C0[i] - C1[i]));
+		std::cout << n << "x" << n << ": naive " << rate(naive, flops, "GFLOP/s") << "; blocked " << rate(blocked, flops, "GFLOP/s") <<
+			"; speedup " << (naive / blocked) << "; max abs difference " << maxError << "\n";
+	}
+}
+
+void KernelBenchmarks::isa(size_t size)
+{
+	std::cout << "\nKernels per instruction set, " << size << "x" << size << " operands\n";
+	size_t count = size * size;
+	std::vector<float> A(count), B(count), C(count), row(size), reference(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		A[i] = static_cast<float>((i * 7) % 13) * 0.1f - 0.6f;
+		B[i] = static_cast<float>((i * 5) % 11) * 0.1f + 0.5f;
+	}
+	for (size_t i = 0; i < size; ++i)row[i] = static_cast<float>(i % 3) + 1.0f;
+	double flops = 2.0 * static_cast<double>(count) * static_cast<double>(size);
+	size_t gemmTrials = trialsFor(flops);
+	size_t streamTrials = trialsFor(static_cast<double>(count));
+	KernelISA best = MatrixKernels::detectISA();
+	float sink = 0.0f;
+	for (int i = 0; i <= static_cast<int>(best); ++i)
+	{
+		KernelISA isa = static_cast<KernelISA>(i);
+		MatrixKernels::setISA(isa);
+
+		double gemmTime = timeTrials(gemmTrials, [&]()
+		{
+			MatrixKernels::gemm(size, size, size, 1.0f, A.data(), size, B.data(), size, 0.0f, C.data(), size);
+		});
+		if (isa == KernelISA::Scalar)reference = C;
+		float maxError = 0.0f;
+		for (size_t j = 0; j < count; ++j)maxError = std::max(maxError, std::abs(reference[j] - C[j]));
+
+		//Streaming kernels, times per call in microseconds
+		double streams[5];
+		streams[0] = 1e3 * timeTrials(streamTrials, [&]()
+		{
+			MatrixKernels::elementwise(ElementOp::Add, count, A.data(), B.data(), C.data());
+		});
+		streams[1] = 1e3 * timeTrials(streamTrials, [&]()
+		{
+			MatrixKernels::elementwise(ElementOp::Divide, count, A.data(), B.data(), C.data());
+		});
+		streams[2] = 1e3 * timeTrials(streamTrials, [&]()
+		{
+			MatrixKernels::broadcastRow(ElementOp::Subtract, size, size, A.data(), size, row.data(), C.data(), size);
+		});
+		streams[3] = 1e3 * timeTrials(streamTrials, [&]() { MatrixKernels::square(count, A.data(), C.data()); });
+		streams[4] = 1e3 * timeTrials(streamTrials, [&]() { sink += MatrixKernels::sum(count, A.data()); });
+
+		std::cout << MatrixKernels::getISAName(isa) << ": gemm " << rate(gemmTime, flops, "GFLOP/s") <<
+			", max abs difference to scalar " << maxError << "; add " << streams[0] << " us; divide " << streams[1] <<
+			" us; broadcast subtract " << streams[2] << " us; square " << streams[3] << " us; sum " << streams[4] << " us\n";
+	}
+	MatrixKernels::setISA(best);
+	if (sink == 1.0f)std::cout << "";//Keeps the sums from being optimized out
+}
+
+void KernelBenchmarks::fusion(size_t rows, size_t columns)
+{
+	std::cout << "\nStandardization (X - mean) / std on " << rows << "x" << columns << "\n";
+	std::vector<std::vector<float>> values(rows, std::vector<float>(columns));
+	for (size_t i = 0; i < rows; ++i)
+		for (size_t j = 0; j < columns; ++j)values[i][j] = static_cast<float>((i * 7 + j) % 13);
+	SerialMatrix X(values), Y(rows, columns), S(rows, columns);
+	SerialMatrix mean, deviation;
+	size_t trials = 20;
+
+	//Column statistics as they used to be taken, the means and then a pass for the deviations from them
+	double twoPass = timeTrials(trials, [&]()
+	{
+		mean = SerialMatrix::mean(X, false);
+		std::vector<float> squares(columns, 0.0f);
+		MatrixKernels::columnSquaredDeviations(rows, columns, X.getData(), X.getStride(), mean.getData(), squares.data());
+	});
+	double onePass = timeTrials(trials, [&]() { SerialMatrix::statistics(mean, deviation, X, false); });
+	std::cout << "mean then deviations " << twoPass << " ms; statistics (Welford) " << onePass << " ms\n";
+
+	//A kernel call and full size temporary per operator, as the operators used to run
+	double separate = timeTrials(trials, [&]()
+	{
+		SerialMatrix temp = X - mean;
+		Y = temp / deviation;
+	});
+	double fused = timeTrials(trials, [&]() { S = (X - mean) / deviation; });
+
+	float maxError = 0.0f;
+	for (size_t i = 0; i < rows; ++i)
+		for (size_t j = 0; j < columns; ++j)maxError = std::max(maxError,
+			std::abs(Y.getData()[i * Y.getStride() + j] - S.getData()[i * S.getStride() + j]));
+	std::cout << "pass per operator " << separate << " ms; fused " << fused << " ms; speedup " << (separate / fused) <<
+		"; max abs difference " << maxError << "\n";
+}
+
+void KernelBenchmarks::layer(size_t rows, size_t inputs, size_t outputs)
+{
+	std::cout << "\nLayer tanh(addOnes(X) * W) on " << rows << "x" << inputs << " inputs, " << outputs << " outputs\n";
+	std::vector<std::vector<float>> x(rows, std::vector<float>(inputs)), w(inputs + 1, std::vector<float>(outputs));
+	for (size_t i = 0; i < rows; ++i)
+		for (size_t j = 0; j < inputs; ++j)x[i][j] = static_cast<float>((i * 7 + j) % 13) * 0.05f - 0.3f;
+	for (size_t i = 0; i <= inputs; ++i)
+		for (size_t j = 0; j < outputs; ++j)w[i][j] = static_cast<float>((i * 5 + j) % 11) * 0.01f - 0.05f;
+	SerialMatrix X(x), W(w), Y(rows, outputs), S(rows, outputs);
+	size_t trials = trialsFor(2.0 * rows * (inputs + 1) * outputs);
+
+	//The copy with a ones column, the product, and a pass for the activation, as forward used to run
+	double separate = timeTrials(trials, [&]()
+	{
+		Y = SerialMatrix::addOnes(X) * W;
+		Y.activateTanH();
+	});
+	double fused = timeTrials(trials, [&]() { SerialMatrix::addOnesMultiply(S, X, W, Activation::TanH); });
+
+	float maxError = 0.0f;
+	for (size_t i = 0; i < rows; ++i)
+		for (size_t j = 0; j < outputs; ++j)maxError = std::max(maxError,
+			std::abs(Y.getData()[i * Y.getStride() + j] - S.getData()[i * S.getStride() + j]));
+	std::cout << "three passes " << separate << " ms; fused " << fused << " ms; speedup " << (separate / fused) <<
+		"; max abs difference " << maxError << "\n";
+}
+
+void KernelBenchmarks::tanh(size_t count)
+{
+	std::cout << "\ntanh accuracy modes on " << count << " values over [-10, 10], error against double precision, " <<
+		"then whether NaN passes through and +-inf gives +-1\n";
+	std::vector<float> A(count), C(count);
+	for (size_t i = 0; i < count; ++i)A[i] = -10.0f + 20.0f * static_cast<float>(i) / static_cast<float>(count - 1);
+	float special[3] = { std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity(),
+		-std::numeric_limits<float>::infinity() }, saturated[3];
+	const char* names[3] = { "exact", "ulp", "fast" };
+	size_t trials = 20;
+	KernelISA best = MatrixKernels::detectISA();
+	TanHAccuracy accuracy = MatrixKernels::getTanHAccuracy();
+	for (int i = 0; i <= static_cast<int>(best); ++i)
+	{
+		MatrixKernels::setISA(static_cast<KernelISA>(i));
+		std::cout << MatrixKernels::getISAName(static_cast<KernelISA>(i)) << ":";
+		for (int mode = 0; mode < 3; ++mode)
+		{
+			MatrixKernels::setTanHAccuracy(static_cast<TanHAccuracy>(mode));
+			double time = timeTrials(trials, [&]() { MatrixKernels::activate(Activation::TanH, count, A.data(), C.data()); });
+
+			double absolute = 0.0, relative = 0.0;
+			for (size_t j = 0; j < count; ++j)
+			{
+				double exact = std::tanh(static_cast<double>(A[j]));
+				double error = std::abs(static_cast<double>(C[j]) - exact);
+				absolute = std::max(absolute, error);
+				if (exact != 0.0)relative = std::max(relative, error / std::abs(exact));
+			}
+			MatrixKernels::activate(Activation::TanH, 3, special, saturated);
+			bool passed = std::isnan(saturated[0]) && saturated[1] == 1.0f && saturated[2] == -1.0f;
+			std::cout << " " << names[mode] << " " << time << " ms (" << (static_cast<double>(count) / (time * 1e3)) <<
+				" Melem/s, max abs error " << absolute << ", max rel error " << relative << ", NaN and inf " <<
+				(passed ? "pass" : "FAIL") << ");";
+		}
+		std::cout << "\n";
+	}
+	MatrixKernels::setISA(best);
+	MatrixKernels::setTanHAccuracy(accuracy);
+}
+
+template <typename T>
+void KernelBenchmarks::elementType(const char* name, size_t rows, size_t inputs, size_t outputs, const SerialMatrix& X,
+	const SerialMatrix& W, const BasicSerialMatrix<double>& reference)
+{
+	typedef BasicSerialMatrix<T> Typed;
+	typedef typename Typed::Value Value;
+	//Rounded once into the storage type, as weights and data would be on load
+	std::vector<std::vector<Value>> x(rows, std::vector<Value>(inputs)), w(inputs + 1, std::vector<Value>(outputs));
+	for (size_t i = 0; i < rows; ++i)
+		for (size_t j = 0; j < inputs; ++j)x[i][j] = static_cast<Value>(X.at(i, j));
+	for (size_t i = 0; i <= inputs; ++i)
+		for (size_t j = 0; j < outputs; ++j)w[i][j] = static_cast<Value>(W.at(i, j));
+	Typed tX(x), tW(w), Y, Z(tX);
+	size_t trials = trialsFor(2.0 * rows * (inputs + 1) * outputs);
+	size_t streamTrials = trialsFor(2.0 * rows * inputs);
+
+	double layer = timeTrials(trials, [&]() { Typed::addOnesMultiply(Y, tX, tW, Activation::TanH); });
+	double axpy = timeTrials(streamTrials, [&]() { Typed::axpy(Z, Value(1e-6), tX); });
+
+	double maxError = 0.0;
+	for (size_t i = 0; i < rows; ++i)
+		for (size_t j = 0; j < outputs; ++j)maxError = std::max(maxError,
+			std::abs(static_cast<double>(Y.at(i, j)) - reference.at(i, j)));
+	std::cout << name << " (" << sizeof(T) << " bytes): layer " << layer << " ms; axpy " << axpy <<
+		" ms; matrix " << (tX.getStride() * rows * sizeof(T) >> 10) << " KB; max abs error to fp64 " << maxError << "\n";
+}
+
+void KernelBenchmarks::elementTypes(size_t rows, size_t inputs, size_t outputs)
+{
+	std::cout << "\nElement types, tanh(addOnes(X) * W) on " << rows << "x" << inputs << " inputs, " << outputs <<
+		" outputs and Y += a * X\n";
+	std::vector<std::vector<float>> x(rows, std::vector<float>(inputs)), w(inputs + 1, std::vector<float>(outputs));
+	std::vector<std::vector<double>> xd(rows, std::vector<double>(inputs)), wd(inputs + 1, std::vector<double>(outputs));
+	for (size_t i = 0; i < rows; ++i)
+		for (size_t j = 0; j < inputs; ++j)xd[i][j] = x[i][j] = static_cast<float>((i * 7 + j) % 13) * 0.05f - 0.3f;
+	for (size_t i = 0; i <= inputs; ++i)
+		for (size_t j = 0; j < outputs; ++j)wd[i][j] = w[i][j] = static_cast<float>((i * 5 + j) % 11) * 0.01f - 0.05f;
+	SerialMatrix X(x), W(w);
+	BasicSerialMatrix<double> reference;
+	BasicSerialMatrix<double>::addOnesMultiply(reference, BasicSerialMatrix<double>(xd), BasicSerialMatrix<double>(wd),
+		Activation::TanH);
+	elementType<float>("fp32", rows, inputs, outputs, X, W, reference);
+	elementType<double>("fp64", rows, inputs, outputs, X, W, reference);
+	elementType<BFloat16>("bf16", rows, inputs, outputs, X, W, reference);
+	elementType<Float16>("fp16", rows, inputs, outputs, X, W, reference);
+}
+
+void KernelBenchmarks::parallelOps(size_t rows, size_t columns)
+{
+	unsigned int threads = std::max(2u, std::thread::hardware_concurrency());
+	std::cout << "\nElementwise ops on " << rows << "x" << columns << ", serial vs " << threads << " pool threads\n";
+	std::vector<std::vector<float>> values(rows, std::vector<float>(columns));
+	for (size_t i = 0; i < rows; ++i)
+		for (size_t j = 0; j < columns; ++j)values[i][j] = static_cast<float>((i * 7 + j) % 13) * 0.1f - 0.6f;
+	SerialMatrix X(values), Y(values), O(rows, columns), mean, deviation;
+	SerialMatrix::statistics(mean, deviation, X, false);
+	ThreadPool pool(threads);
+	size_t trials = 10;
+	const char* names[] = { "standardize", "delta", "tanh", "transpose", "sum of squares", "column means" };
+	double serial[6], parallel[6];
+	float sink = 0.0f;
+	//Each op serial and then on the pool, the warm up call takes the allocations
+	serial[0] = timeTrials(trials, [&]() { O = (X - mean) / deviation; });
+	parallel[0] = timeTrials(trials, [&]()
+	{
+		pool.dispatch(SerialMatrix::setParallelExpressionOps(O, (X - mean) / deviation), &SerialMatrix::parallelRange);
+	});
+	serial[1] = timeTrials(trials, [&]() { O = SerialMatrix::componentwise(X, 1.0f - SerialMatrix::square(Y)); });
+	parallel[1] = timeTrials(trials, [&]()
+	{
+		pool.dispatch(SerialMatrix::setParallelExpressionOps(O, SerialMatrix::componentwise(X, 1.0f - SerialMatrix::square(Y))),
+			&SerialMatrix::parallelRange);
+	});
+	serial[2] = timeTrials(trials, [&]() { SerialMatrix::activateTanH(O, X); });
+	parallel[2] = timeTrials(trials, [&]()
+	{
+		pool.dispatch(SerialMatrix::setParallelActivationOps(O, X), &SerialMatrix::parallelRange);
+	});
+	serial[3] = timeTrials(trials, [&]() { O = X.view().transpose(); });
+	parallel[3] = timeTrials(trials, [&]()
+	{
+		pool.dispatch(SerialMatrix::setParallelTransposeOps(O, X), &SerialMatrix::parallelRange);
+	});
+	serial[4] = timeTrials(trials, [&]() { sink += SerialMatrix::mean(SerialMatrix::square(X)); });
+	parallel[4] = timeTrials(trials, [&]()
+	{
+		pool.dispatch(SerialMatrix::setParallelSumOps(SerialMatrix::square(X)), &SerialMatrix::parallelRange);
+		sink += SerialMatrix::getParallelSum();
+	});
+	serial[5] = timeTrials(trials, [&]() { mean = SerialMatrix::mean(X, false); });
+	parallel[5] = timeTrials(trials, [&]()
+	{
+		pool.dispatch(SerialMatrix::setParallelMeanOps(X, false), &SerialMatrix::parallelRange);
+		SerialMatrix::mergeParallelMean(mean);
+	});
+	for (size_t k = 0; k < 6; ++k)
+	{
+		std::cout << names[k] << ": serial " << serial[k] << " ms; pool " << parallel[k] << " ms; speedup " <<
+			(serial[k] / parallel[k]) << "\n";
+	}
+	if (sink == 1.0f)std::cout << "";//Keeps the sums from being optimized out
+}
+
+void KernelBenchmarks::transpose(size_t minSize, size_t maxSize)
+{
+	unsigned int threads = std::max(2u, std::thread::hardware_concurrency());
+	std::cout << "\nTranspose: element walk vs tiled vs " << threads << " pool threads vs in place (square)\n";
+	ThreadPool pool(threads);
+	std::vector<size_t> sizes;
+	for (size_t n = minSize; n <= maxSize; n <<= 1)sizes.push_back(n);
+	sizes.push_back(maxSize - 3);//Not a multiple of any tile or block
+	for (size_t n : sizes)
+	{
+		std::vector<float> A(n * n), B(n * n);
+		std::vector<std::vector<float>> values(n, std::vector<float>(n));
+		for (size_t i = 0; i < n * n; ++i)
+			values[i / n][i % n] = A[i] = static_cast<float>((i * 7) % 13) * 0.1f - 0.6f;
+		SerialMatrix X(values), O(n, n);
+		//Each element read once and written once
+		double bytes = 2.0 * sizeof(float) * static_cast<double>(n) * static_cast<double>(n);
+		size_t trials = trialsFor(bytes);
+		double walk = timeTrials(trials, [&]() { MatrixKernels::transposeNaive(n, n, A.data(), n, B.data(), n); });
+		double tiled = timeTrials(trials, [&]() { MatrixKernels::transpose(n, n, A.data(), n, B.data(), n); });
+		double parallel = timeTrials(trials, [&]()
+		{
+			pool.dispatch(SerialMatrix::setParallelTransposeOps(O, X), &SerialMatrix::parallelRange);
+		});
+		double inPlace = timeTrials(trials, [&]() { X.transposeInPlace(); });
+		std::cout << n << "x" << n << ": walk " << rate(walk, bytes, "GB/s") << "; tiled " << rate(tiled, bytes, "GB/s") <<
+			"; pool " << rate(parallel, bytes, "GB/s") << "; in place " << rate(inPlace, bytes, "GB/s") << "\n";
+	}
+}
+
+void KernelBenchmarks::strassen(size_t minSize, size_t maxSize)
+{
+	unsigned int threads = std::max(2u, std::thread::hardware_concurrency());
+	std::cout << "\nStrassen-Winograd: blocked gemm vs one level (cutoff n) vs cutoff " << MATRIX_STRASSEN_CUTOFF <<
+		", and on " << threads << " pool threads\n";
+	ThreadPool pool(threads);
+	size_t crossover = 0;
+	for (size_t n = minSize; n <= maxSize; n <<= 1)
+	{
+		std::vector<std::vector<double>> a(n, std::vector<double>(n)), b(n, std::vector<double>(n));
+		for (size_t i = 0; i < n; ++i)
+		{
+			for (size_t j = 0; j < n; ++j)
+			{
+				//Values a float holds exactly, so both products start from the same operands
+				a[i][j] = static_cast<float>(((i * n + j) * 7) % 13) * 0.1f - 0.6f;
+				b[i][j] = static_cast<float>(((i * n + j) * 5) % 11) * 0.1f - 0.5f;
+			}
+		}
+		BasicSerialMatrix<double> A64(a), B64(b), reference;
+		BasicSerialMatrix<double>::gemm(reference, A64, B64);
+		std::vector<std::vector<float>> af(n, std::vector<float>(n)), bf(n, std::vector<float>(n));
+		for (size_t i = 0; i < n; ++i)
+		{
+			for (size_t j = 0; j < n; ++j)
+			{
+				af[i][j] = static_cast<float>(a[i][j]);
+				bf[i][j] = static_cast<float>(b[i][j]);
+			}
+		}
+		SerialMatrix A(af), B(bf), C[4];
+		size_t trials = trialsFor(2.0 * static_cast<double>(n) * static_cast<double>(n) * static_cast<double>(n));
+		//The warm up call sizes the Strassen workspace, so it is not timed either
+		double times[4];
+		times[0] = timeTrials(trials, [&]() { SerialMatrix::gemm(C[0], A, B); });
+		times[1] = timeTrials(trials, [&]() { SerialMatrix::strassen(C[1], A, B, n); });
+		times[2] = timeTrials(trials, [&]() { SerialMatrix::strassen(C[2], A, B); });
+		times[3] = timeTrials(trials, [&]()
+		{
+			pool.dispatch(SerialMatrix::setParallelStrassenOps(C[3], A, B, n), &SerialMatrix::parallelRange);
+			SerialMatrix::mergeParallelStrassen();
+		});
+		//Relative Frobenius error of each float product against the double one
+		double errors[4] = {}, norm = 0.0;
+		for (size_t i = 0; i < n; ++i)
+		{
+			for (size_t j = 0; j < n; ++j)
+			{
+				double r = reference.at(i, j);
+				norm += r * r;
+				for (size_t k = 0; k < 4; ++k)errors[k] += (C[k].at(i, j) - r) * (C[k].at(i, j) - r);
+			}
+		}
+		if (crossover == 0 && times[1] < times[0])crossover = n;
+		std::cout << n << ": gemm " << times[0] << " ms (error " << std::sqrt(errors[0] / norm) << "); one level " << times[1] <<
+			" ms (" << std::sqrt(errors[1] / norm) << "); cutoff " << times[2] << " ms (" << std::sqrt(errors[2] / norm) <<
+			"); pool one level " << times[3] << " ms (" << std::sqrt(errors[3] / norm) << ")\n";
+	}
+	if (crossover == 0)std::cout << "One level never beat gemm up to " << maxSize << "\n";
+	else std::cout << "Crossover: one Strassen level first beats gemm at " << crossover << "\n";
+}
+
+void KernelBenchmarks::bufferPool(size_t rounds)
+{
+	std::cout << "\nMatrix buffers: MatrixBufferPool vs aligned new and delete, " << rounds << " rounds\n";
+	//Floats of the buffers a small network's epoch churns through: rows x (inputs + 1), weights, deltas, activations
+	const size_t sizes[] = { 11, 16, 60, 100, 200, 500, 1100, 4000, 16000 };
+	const size_t count = sizeof(sizes) / sizeof(sizes[0]);
+	void* buffers[count];
+	double times[2];
+	for (size_t k = 0; k < 2; ++k)
+	{
+		//A round acquires every size and releases them in reverse, reported per acquire and release in nanoseconds
+		times[k] = 1e6 / count * timeTrials(rounds, [&]()
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				buffers[i] = (k == 0) ? MatrixBufferPool::acquire(sizes[i] * sizeof(float)) :
+					::operator new[](sizes[i] * sizeof(float), std::align_val_t(MATRIX_ALIGNMENT), std::nothrow);
+				static_cast<float*>(buffers[i])[0] = static_cast<float>(i);
+			}
+			for (size_t i = count; i-- > 0;)
+			{
+				if (k == 0)MatrixBufferPool::release(buffers[i]);
+				else ::operator delete[](buffers[i], std::align_val_t(MATRIX_ALIGNMENT));
+			}
+		});
+	}
+	std::cout << "acquire and release: pool " << times[0] << " ns; new and delete " << times[1] << " ns\n";
+	//Temporaries as the matrix operators build them, untimed warm up left out so every acquire is counted
+	std::vector<std::vector<float>> values(100, std::vector<float>(10, 0.5f));
+	SerialMatrix X(values);
+	MatrixPoolStatistics before = MatrixBufferPool::threadStatistics();
+	float sink = 0.0f;
+	double pair = timeTrials(rounds / 10, [&]()
+	{
+		SerialMatrix A = SerialMatrix::addOnes(X);
+		SerialMatrix B = SerialMatrix::transpose(A);
+		sink += B.at(0, 0);
+	}, 0);
+	MatrixPoolStatistics after = MatrixBufferPool::threadStatistics();
+	std::cout << "addOnes and transpose temporaries: " << pair * 1e6 << " ns per pair; " << (after.hits - before.hits) << " hits, " <<
+		(after.misses - before.misses) << " misses\n";
+	MatrixPoolStatistics total = MatrixBufferPool::statistics();
+	std::cout << "Pool over every thread: " << total.hits << " hits, " << total.misses << " misses, " << total.bytesInUse <<
+		" bytes in use, " << total.peakBytes << " peak bytes, " << total.bytesCached << " bytes cached\n";
+	if (sink == 1.0f)std::cout << "";
+}
+
+void KernelBenchmarks::layouts(size_t rows, size_t inputs, size_t outputs)
+{
+	std::cout << "\nLayouts: products and elementwise sums over each pairing of row (R) and column (C) major, " << rows <<
+		" x " << inputs << " by " << inputs << " x " << outputs << "\n";
+	std::vector<std::vector<float>> x(rows, std::vector<float>(inputs)), w(inputs, std::vector<float>(outputs));
+	for (size_t i = 0; i < rows; ++i)
+		for (size_t j = 0; j < inputs; ++j)x[i][j] = static_cast<float>(((i * inputs + j) * 7) % 13) * 0.1f - 0.6f;
+	for (size_t i = 0; i < inputs; ++i)
+		for (size_t j = 0; j < outputs; ++j)w[i][j] = static_cast<float>(((i * outputs + j) * 5) % 11) * 0.1f - 0.5f;
+	const MatrixLayout orders[2] = { MatrixLayout::RowMajor, MatrixLayout::ColumnMajor };
+	const char names[2] = { 'R', 'C' };
+	SerialMatrix X[2] = { SerialMatrix(x), SerialMatrix(x) }, W[2] = { SerialMatrix(w), SerialMatrix(w) }, reference;
+	X[1].setLayout(MatrixLayout::ColumnMajor);
+	W[1].setLayout(MatrixLayout::ColumnMajor);
+	SerialMatrix::gemm(reference, X[0], W[0]);
+	double flops = 2.0 * static_cast<double>(rows) * static_cast<double>(inputs) * static_cast<double>(outputs);
+	size_t trials = trialsFor(flops);
+	//C = X * W, each layout of X, W and C
+	for (size_t k = 0; k < 8; ++k)
+	{
+		const SerialMatrix& A = X[k >> 2], & B = W[(k >> 1) & 1];
+		SerialMatrix C(rows, outputs, orders[k & 1]);
+		double ms = timeTrials(trials, [&]() { SerialMatrix::gemm(C, A, B); });
+		float error = 0.0f;
+		for (size_t i = 0; i < rows; ++i)
+			for (size_t j = 0; j < outputs; ++j)error = std::max(error, std::fabs(C.at(i, j) - reference.at(i, j)));
+		std::cout << names[k >> 2] << names[(k >> 1) & 1] << " -> " << names[k & 1] << ": " << rate(ms, flops, "GFLOP/s") <<
+			", max difference " << error << (k == 7 ? "\n" : "; ");
+		if ((k & 1) == 1 && k != 7)std::cout << "\n";
+	}
+	//X + X, stored alike (storage order), mixed (tiles), and converted to the destination's layout first
+	double bytes = 3.0 * sizeof(float) * static_cast<double>(rows) * static_cast<double>(inputs);
+	trials = trialsFor(bytes);
+	for (size_t k = 0; k < 8; ++k)
+	{
+		const SerialMatrix& A = X[k >> 2], & B = X[(k >> 1) & 1];
+		SerialMatrix C(rows, inputs, orders[k & 1]);
+		double ms = timeTrials(trials, [&]() { C = A + B; });
+		std::cout << names[k >> 2] << " + " << names[(k >> 1) & 1] << " -> " << names[k & 1] << ": " << rate(ms, bytes, "GB/s") <<
+			((k & 1) == 1 ? "\n" : "; ");
+	}
+	SerialMatrix converted(X[0]);
+	double ms = timeTrials(trials, [&]()
+	{
+		converted.setLayout(converted.getLayout() == MatrixLayout::RowMajor ? MatrixLayout::ColumnMajor : MatrixLayout::RowMajor);
+	}, 0);
+	std::cout << "setLayout: " << ms << " ms per conversion\n";
+}
+
+void KernelBenchmarks::sparse(size_t rows, size_t inputs, size_t outputs)
+{
+	unsigned int threads = std::max(2u, std::thread::hardware_concurrency());
+	std::cout << "\nPruned layer tanh(addOnes(X) * W) on " << rows << "x" << inputs << " inputs, " << outputs <<
+		" outputs: dense fused vs CSR and CSC weights, serial and on " << threads << " pool threads\n";
+	ThreadPool pool(threads);
+	std::vector<std::vector<float>> x(rows, std::vector<float>(inputs)), w(inputs + 1, std::vector<float>(outputs));
+	for (size_t i = 0; i < rows; ++i)
+		for (size_t j = 0; j < inputs; ++j)x[i][j] = static_cast<float>((i * 7 + j) % 13) * 0.05f - 0.3f;
+	for (size_t i = 0; i <= inputs; ++i)
+		for (size_t j = 0; j < outputs; ++j)w[i][j] = static_cast<float>((i * 37 + j * 11) % 101) * 0.002f - 0.1f;
+	SerialMatrix X(x), W(w), Y(rows, outputs), pruned;
+	size_t trials = trialsFor(2.0 * rows * (inputs + 1) * outputs);
+	std::cout << "dense " << timeTrials(trials, [&]() { SerialMatrix::addOnesMultiply(Y, X, W, Activation::TanH); }) << " ms\n";
+	const double sparsities[] = { 0.5, 0.8, 0.9, 0.95 };
+	for (double sparsity : sparsities)
+	{
+		float threshold = SparseMatrix::pruningThreshold(W.view().rowSlice(1, inputs + 1), sparsity);
+		SparseMatrix formats[2] = { SparseMatrix(W, SparseFormat::CSR, threshold, 1), SparseMatrix(W, SparseFormat::CSC, threshold, 1) };
+		//The same pruned weights multiplied densely, what the sparse products should reproduce
+		formats[0].toDense(pruned);
+		SerialMatrix reference;
+		SerialMatrix::addOnesMultiply(reference, X, pruned, Activation::TanH);
+		std::cout << sparsity * 100.0 << "% pruned (density " << formats[0].getDensity() << "):";
+		for (size_t k = 0; k < 4; ++k)
+		{
+			const SparseMatrix& S = formats[k >> 1];
+			size_t sparseTrials = std::max<size_t>(1, static_cast<size_t>(trials / std::max(0.01, S.getDensity())) / 4);
+			double ms = timeTrials(sparseTrials, [&]()
+			{
+				if ((k & 1) == 0)SparseMatrix::multiply(Y, X, S, true, Activation::TanH);
+				else pool.dispatch(SparseMatrix::setParallelMultiplyOps(Y, X, S, true, Activation::TanH), &SparseMatrix::parallelRange);
+			});
+			float maxError = 0.0f;
+			for (size_t i = 0; i < rows; ++i)
+				for (size_t j = 0; j < outputs; ++j)maxError = std::max(maxError, std::abs(Y.at(i, j) - reference.at(i, j)));
+			std::cout << " " << ((k >> 1) == 0 ? "CSR" : "CSC") << ((k & 1) == 0 ? " " : " pool ") << ms << " ms (" << maxError <<
+				")" << (k == 3 ? "\n" : ";");
+		}
+	}
+}
+
+void KernelBenchmarks::batched(size_t models, size_t rows)
+{
+	unsigned int threads = std::max(2u, std::thread::hardware_concurrency());
+	std::cout << "\nForward pass of " << models << " 1-{10, 5}-1 networks on " << rows << " shared inputs: a loop of products, "
+		"each product's rows on " << threads << " pool threads, batched serial, batched on the pool\n";
+	ThreadPool pool(threads);
+	const size_t sizes[] = { 1, 10, 5, 1 };
+	const size_t layers = 3;
+	std::vector<SerialMatrix> weights[layers];
+	std::vector<MatrixView> B[layers];
+	for (size_t l = 0; l < layers; ++l)
+	{
+		for (size_t p = 0; p < models; ++p)
+		{
+			std::vector<std::vector<float>> w(sizes[l] + 1, std::vector<float>(sizes[l + 1]));
+			for (size_t i = 0; i <= sizes[l]; ++i)
+				for (size_t j = 0; j < sizes[l + 1]; ++j)w[i][j] = static_cast<float>((p * 13 + i * 7 + j * 3) % 17) * 0.05f - 0.4f;
+			weights[l].push_back(SerialMatrix(w));
+		}
+		for (size_t p = 0; p < models; ++p)B[l].push_back(weights[l][p].view());
+	}
+	std::vector<std::vector<float>> x(rows, std::vector<float>(1));
+	for (size_t i = 0; i < rows; ++i)x[i][0] = static_cast<float>(i) * 0.1f;
+	SerialMatrix X(x);
+	std::vector<MatrixView> inputs(1, X.view());
+	//Each variant writes its own outputs, layer l of model p in out[l][p]; views of them are the next layer's inputs
+	std::vector<SerialMatrix> out[4][layers];
+	std::vector<MatrixView> A[4][layers];
+	double flops = 0.0;
+	for (size_t l = 0; l < layers; ++l)flops += 2.0 * rows * (sizes[l] + 1) * sizes[l + 1] * models;
+	size_t trials = trialsFor(flops * 4.0);
+	double times[4];
+	for (size_t k = 0; k < 4; ++k)
+	{
+		for (size_t l = 0; l < layers; ++l)
+		{
+			out[k][l].resize(models);
+			for (size_t p = 0; p < models; ++p)out[k][l][p].resize(rows, sizes[l + 1]);
+			if (l == 0)A[k][l] = inputs;
+			else for (size_t p = 0; p < models; ++p)A[k][l].push_back(out[k][l - 1][p].view());
+		}
+		times[k] = timeTrials(trials, [&]()
+		{
+			for (size_t l = 0; l < layers; ++l)
+			{
+				Activation activation = l + 1 < layers ? Activation::TanH : Activation::None;
+				if (k == 2)SerialMatrix::multiplyBatched(out[k][l], A[k][l], B[l], true, activation);
+				else if (k == 3)pool.dispatch(SerialMatrix::setParallelBatchedOps(out[k][l], A[k][l], B[l], true, activation),
+					&SerialMatrix::parallelRange);
+				else
+				{
+					for (size_t p = 0; p < models; ++p)
+					{
+						const MatrixView& a = A[k][l][l == 0 ? 0 : p];
+						if (k == 0)SerialMatrix::addOnesMultiply(out[k][l][p], a, B[l][p], activation);
+						else pool.dispatch(SerialMatrix::setParallelProductOps(out[k][l][p], a, B[l][p], true, activation),
+							&SerialMatrix::parallelProductRows);
+					}
+				}
+			}
+		});
+	}
+	float maxError = 0.0f;
+	for (size_t k = 1; k < 4; ++k)
+	{
+		for (size_t p = 0; p < models; ++p)
+			for (size_t i = 0; i < rows; ++i)maxError = std::max(maxError, std::abs(out[k][layers - 1][p].at(i, 0) - out[0][layers - 1][p].at(i, 0)));
+	}
+	std::cout << "loop " << times[0] << " ms; rows on the pool " << times[1] << " ms; batched " << times[2] <<
+		" ms; batched on the pool " << times[3] << " ms (largest difference from the loop " << maxError << ")\n";
+}
+
+void KernelBenchmarks::matrixFile(size_t rows, size_t columns)
+{
+	std::cout << "\nLoading a " << rows << "x" << columns << " dataset: nested vectors into a SerialMatrix vs a mapped MatrixFile\n";
+	const char* path = "KernelBenchmarks.matrix";
+	//As main builds X, the parsed rows are already in memory, so this is the copy alone without any parsing
+	std::vector<std::vector<float>> values(rows, std::vector<float>(columns));
+	for (size_t i = 0; i < rows; ++i)
+		for (size_t j = 0; j < columns; ++j)values[i][j] = static_cast<float>((i * 7 + j * 3) % 29) * 0.1f - 1.4f;
+	//Each step is timed once without a warm up, a second build or pass would find the pages already in
+	SerialMatrix copied;
+	MappedMatrix mapped;
+	MatrixView view;
+	float builtMean = 0.0f, mappedMean = 0.0f;
+	double buildTime = timeTrials(1, [&]() { copied = SerialMatrix(values); }, 0);
+	double builtPass = timeTrials(1, [&]() { builtMean = SerialMatrix::mean(copied); }, 0);
+	double writeTime = timeTrials(1, [&]() { MatrixFile::write(path, copied); }, 0);
+	double mapTime = timeTrials(1, [&]()
+	{
+		mapped = MappedMatrix(path);
+		view = mapped.view<float>();
+	}, 0);
+	//The first pass faults the pages in, from the page cache here since the file was just written
+	double mappedPass = timeTrials(1, [&]() { mappedMean = SerialMatrix::mean(view); }, 0);
+	float maxError = 0.0f;
+	for (size_t i = 0; i < rows; ++i)
+		for (size_t j = 0; j < columns; ++j)maxError = std::max(maxError, std::abs(view.at(i, j) - copied.at(i, j)));
+	std::cout << "nested vectors to SerialMatrix " << buildTime << " ms, first pass " << builtPass << " ms; write " <<
+		writeTime << " ms; map " << mapTime << " ms, first pass " << mappedPass << " ms (means " << builtMean << ", " << mappedMean <<
+		", largest difference " << maxError << ")\n";
+	mapped.close();
+	std::remove(path);
+}
+
+void KernelBenchmarks::datasetLoader(size_t rows, size_t columns)
+{
+	unsigned int threads = std::max(2u, std::thread::hardware_concurrency());
+	std::cout << "\nLoading a " << rows << "x" << columns << " CSV, the last column the target: >> into nested vectors then SerialMatrix, "
+		"vs DatasetLoader serial and on " << threads << " pool threads\n";
+	ThreadPool pool(threads);
+	const char* path = "KernelBenchmarks.csv";
+	{
+		std::ofstream out(path);
+		out << "feature,...,target\n";
+		for (size_t i = 0; i < rows; ++i)
+		{
+			for (size_t j = 0; j < columns; ++j)
+				out << static_cast<float>((i * 7 + j * 3) % 29) * 0.137f - 1.4f << (j + 1 < columns ? "," : "\n");
+		}
+	}
+	//Every load is timed once without a warm up, the file is in the page cache for each since it was just written
+	std::vector<std::vector<float>> x, t;
+	SerialMatrix X, T;
+	double streamTime = timeTrials(1, [&]()
+	{
+		std::ifstream in(path);
+		std::string header;
+		std::getline(in, header);
+		std::vector<float> row(columns);
+		char comma;
+		while (in >> row[0])
+		{
+			for (size_t j = 1; j < columns; ++j)in >> comma >> row[j];
+			x.push_back(std::vector<float>(row.begin(), row.end() - 1));
+			t.push_back(std::vector<float>(1, row.back()));
+		}
+		X = SerialMatrix(x);
+		T = SerialMatrix(t);
+	}, 0);
+	x = std::vector<std::vector<float>>();//Millions of small rows, freed so they do not weigh on the loads timed below
+	t = std::vector<std::vector<float>>();
+	SerialMatrix loaded[2][2];
+	double times[2];
+	for (size_t k = 0; k < 2; ++k)
+	{
+		times[k] = timeTrials(1, [&]()
+		{
+			if (k == 0)DatasetLoader::load(path, loaded[k][0], loaded[k][1], columns - 1, 1, true);
+			else
+			{
+				pool.dispatch(DatasetLoader::setParallelLoadOps(path, loaded[k][0], loaded[k][1], columns - 1, 1, true),
+					&DatasetLoader::parallelRange);
+				DatasetLoader::checkParallelLoad();
+			}
+		}, 0);
+	}
+	bool same = true;
+	for (size_t k = 0; k < 2; ++k)same = same && loaded[k][0] == X && loaded[k][1] == T;
+	std::cout << ">> and nested vectors " << streamTime << " ms; DatasetLoader " << times[0] << " ms; on the pool " << times[1] <<
+		" ms (" << (same ? "identical" : "DIFFERENT") << ")\n";
+	std::remove(path);
+}
+
+void KernelBenchmarks::rvalues(size_t rows, size_t columns, size_t rounds)
+{
+	std::cout << "\nRvalue operands: (Y * S) + M and 1 - square(Y * S) with the product named vs as the expiring temporary, " << rows <<
+		" x " << columns << " by " << columns << " x " << columns << ", " << rounds << " rounds\n";
+	std::vector<std::vector<float>> y(rows, std::vector<float>(columns)), s(columns, std::vector<float>(columns)), m(1, std::vector<float>(columns));
+	for (size_t i = 0; i < rows; ++i)
+		for (size_t j = 0; j < columns; ++j)y[i][j] = static_cast<float>(((i * columns + j) * 7) % 13) * 0.1f - 0.6f;
+	for (size_t i = 0; i < columns; ++i)
+	{
+		for (size_t j = 0; j < columns; ++j)s[i][j] = static_cast<float>(((i + 3 * j) * 5) % 11) * 0.02f - 0.1f;
+		m[0][i] = static_cast<float>(i) * 0.5f;
+	}
+	SerialMatrix Y(y), S(s), M(m), results[2][2];
+	double times[2];
+	uint64_t acquires[2];
+	for (size_t k = 0; k < 2; ++k)
+	{
+		//No warm up, each round's buffer acquires are counted
+		MatrixPoolStatistics before = MatrixBufferPool::threadStatistics();
+		times[k] = timeTrials(rounds, [&]()
+		{
+			if (k == 0)
+			{
+				SerialMatrix P = Y * S;
+				results[k][0] = SerialMatrix(P + M);
+				SerialMatrix Q = Y * S;
+				results[k][1] = SerialMatrix(1.0f - SerialMatrix::square(Q));
+			}
+			else
+			{
+				results[k][0] = SerialMatrix((Y * S) + M);
+				results[k][1] = SerialMatrix(1.0f - SerialMatrix::square(Y * S));
+			}
+		}, 0);
+		MatrixPoolStatistics after = MatrixBufferPool::threadStatistics();
+		acquires[k] = (after.hits + after.misses - before.hits - before.misses) / rounds;
+	}
+	bool same = results[0][0] == results[1][0] && results[0][1] == results[1][1];
+	std::cout << "named " << times[0] << " ms, " << acquires[0] << " buffers; temporary " << times[1] << " ms, " << acquires[1] <<
+		" buffers per round (" << (same ? "identical" : "DIFFERENT") << ")\n";
+}
+
+void KernelBenchmarks::vectorProducts(size_t size)
+{
+	std::cout << "\nVector products: naive dot product per element vs the vector kernels gemm dispatches to, " << size << " x " <<
+		size << " matrix\n";
+	std::vector<float> W(size * size), x(size), y(size), C0(size * size), C1(size * size);
+	for (size_t i = 0; i < size * size; ++i)W[i] = static_cast<float>((i * 7) % 13) * 0.1f - 0.6f;
+	for (size_t i = 0; i < size; ++i)
+	{
+		x[i] = static_cast<float>((i * 5) % 11) * 0.1f - 0.5f;
+		y[i] = static_cast<float>((i * 3) % 7) * 0.1f - 0.3f;
+	}
+	//{ m, n, k, A, lda, B, ldb }: a sample through a layer, a layer into a single output, and an outer product
+	struct Shape { const char* name; size_t m, n, k; const float* A; size_t lda; const float* B; size_t ldb; };
+	const Shape shapes[] =
+	{
+		{ "x * W (1 x n)", 1, size, size, x.data(), size, W.data(), size },
+		{ "W * x (n x 1)", size, 1, size, W.data(), size, x.data(), 1 },
+		{ "x * y (k = 1)", size, size, 1, x.data(), 1, y.data(), size }
+	};
+	for (const Shape& s : shapes)
+	{
+		double flops = 2.0 * static_cast<double>(s.m) * static_cast<double>(s.n) * static_cast<double>(s.k);
+		size_t trials = trialsFor(flops) * 4;
+		//Times per call in microseconds
+		double naive = 1e3 * timeTrials(trials, [&]() { MatrixKernels::gemmNaive(s.m, s.n, s.k, s.A, s.lda, s.B, s.ldb, C0.data(), s.n); });
+		double kernels = 1e3 * timeTrials(trials, [&]()
+		{
+			MatrixKernels::gemm(s.m, s.n, s.k, 1.0f, s.A, s.lda, s.B, s.ldb, 0.0f, C1.data(), s.n);
+		});
+		float maxError = 0.0f;
+		for (size_t i = 0; i < s.m * s.n; ++i)maxError = std::max(maxError, std::abs(C0[i] - C1[i]));
+		std::cout << s.name << ": naive " << naive << " us; vector kernels " << kernels << " us (" << (flops / (kernels * 1e3)) <<
+			" GFLOP/s); speedup " << (naive / kernels) << "; max abs difference " << maxError << "\n";
+	}
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+/*
+Author: Dan Rehberg
+Modified Date: 10/19/2026
+Purpose: Timing of the raw kernels in MatrixKernels against the implementations they replaced.
+	Enabled from main with RUN_KERNEL_BENCHMARKS, results printed to std::cout.
+*/
+
+#ifndef __KERNEL_BENCHMARKS__
+#define __KERNEL_BENCHMARKS__
+
+#include <cstddef>
+#include <string>
+#include "SerialMatrix.hpp"
+
+class KernelBenchmarks final
+{
+public:
+	KernelBenchmarks() = delete;
+	static void all();//Every benchmark below at its default sizes, what main runs with RUN_KERNEL_BENCHMARKS
+	static void gemm(size_t minSize = 16, size_t maxSize = 2048);//Square products, sizes doubled from min to max
+	static void isa(size_t size = 512);//Every kernel under each instruction set the CPU supports, size x size operands
+	static void fusion(size_t rows = 1 << 20, size_t columns = 8);//Standardization fused into one pass vs a pass per operator, and its statistics in one pass vs two
+	static void layer(size_t rows = 4096, size_t inputs = 64, size_t outputs = 64);//tanh(addOnes(X) * W) in three passes vs the fused epilogue
+	static void tanh(size_t count = 1 << 20);//Error and throughput of each TanHAccuracy on every instruction set, over [-10, 10]
+	static void elementTypes(size_t rows = 4096, size_t inputs = 512, size_t outputs = 512);//The fused layer and an axpy per storage type
+	static void parallelOps(size_t rows = 1 << 18, size_t columns = 32);//Elementwise ops and reductions serial vs on a pool of every core
+	static void transpose(size_t minSize = 64, size_t maxSize = 4096);//Element walk vs tiled vs pool vs in place, square sizes doubled plus an odd one
+	static void strassen(size_t minSize = 128, size_t maxSize = 2048);//gemm vs one Strassen level vs MATRIX_STRASSEN_CUTOFF, pool too, error against double
+	static void bufferPool(size_t rounds = 100000);//Matrix buffers from MatrixBufferPool vs aligned new and delete, then its statistics
+	static void layouts(size_t rows = 2048, size_t inputs = 512, size_t outputs = 512);//gemm and a sum for each pairing of row and column major operands and result
+	static void sparse(size_t rows = 4096, size_t inputs = 512, size_t outputs = 512);//The fused layer against pruned CSR and CSC weights, error against the dense pruned product
+	static void batched(size_t models = 1024, size_t rows = 100);//A sweep of {10, 5} networks forward: per product loop, rows on the pool, batched serial and on the pool
+	static void matrixFile(size_t rows = 1 << 20, size_t columns = 8);//Building from nested vectors vs writing then mapping a MatrixFile, a pass over each
+	static void datasetLoader(size_t rows = 1 << 20, size_t columns = 8);//A CSV read with >> into nested vectors vs DatasetLoader, serial and on a pool of every core
+	static void vectorProducts(size_t size = 1024);//Vector times matrix, matrix times vector and the outer product vs the naive dot products
+	static void rvalues(size_t rows = 4096, size_t columns = 64, size_t rounds = 20);//Expressions on a product named first vs on the temporary itself
+private:
+	static size_t trialsFor(double flops);//Enough repetitions for a stable time on small sizes
+	//The one timing loop: milliseconds per call of workload() over trials calls, after warmUps untimed ones
+	template <typename Workload>
+	static double timeTrials(size_t trials, Workload workload, size_t warmUps = 1);
+	static std::string rate(double ms, double work, const char* unit);//"ms ms (work / ms unit)", flops give GFLOP/s and bytes GB/s
+	template <typename T>
+	static void elementType(const char* name, size_t rows, size_t inputs, size_t outputs, const SerialMatrix& X,
+		const SerialMatrix& W, const BasicSerialMatrix<double>& reference);
+};
+
+#endif // !__KERNEL_BENCHMARKS__
\ No newline at end of file
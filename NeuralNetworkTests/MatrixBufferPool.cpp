@@ -0,0 +1,231 @@
+/*
+Author: Dan Rehberg
+Modified Date: 10/19/2026
+*/
+#include "MatrixBufferPool.hpp"
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <vector>
+
+//Sits in front of each buffer, one alignment's worth so the buffer keeps the alignment
+struct PoolHeader
+{
+	PoolHeader* next;//Free list link while cached
+	size_t sizeClass;
+	size_t bytes;//Class bytes, or the request of an oversized buffer
+};
+
+static_assert(sizeof(PoolHeader) <= MATRIX_POOL_ALIGNMENT, "Pool header must fit in front of the aligned buffer");
+
+//Class 0 is every request up to 64 bytes, then four classes per power of two: 80, 96, 112, 128, 160, ...
+static constexpr size_t classOf(size_t bytes)
+{
+	if (bytes <= 64)return 0;
+	size_t e = 6;
+	while (((bytes - 1) >> (e + 1)) != 0)++e;
+	return (e - 6) * 4 + (((bytes - 1) >> (e - 2)) & 3) + 1;
+}
+
+static constexpr size_t poolClasses = classOf(MATRIX_POOL_MAX_BYTES) + 1;
+
+//Counts owned and written by one thread, atomics only so statistics() may read them from another
+struct PoolCounts
+{
+	std::atomic<uint64_t> hits{ 0 }, misses{ 0 }, acquired{ 0 }, released{ 0 }, peak{ 0 }, cached{ 0 };
+};
+
+//Single writer, so a load and store is enough and no cache line is ever contended
+static void add(std::atomic<uint64_t>& counter, uint64_t value)
+{
+	counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+static void countAcquire(PoolCounts& counts, uint64_t bytes, bool hit)
+{
+	add(hit ? counts.hits : counts.misses, 1);
+	add(counts.acquired, bytes);
+	//Signed, a thread that released more than it acquired is at no bytes in use rather than at a wrapped count
+	int64_t inUse = static_cast<int64_t>(counts.acquired.load(std::memory_order_relaxed) - counts.released.load(std::memory_order_relaxed));
+	if (inUse > static_cast<int64_t>(counts.peak.load(std::memory_order_relaxed)))counts.peak.store(inUse, std::memory_order_relaxed);
+}
+
+struct PoolCache;
+
+//Live thread caches, and what exited threads counted
+static std::mutex& registryLock()
+{
+	static std::mutex lock;
+	return lock;
+}
+
+static std::vector<PoolCache*>& registry()
+{
+	static std::vector<PoolCache*> caches;
+	return caches;
+}
+
+static MatrixPoolStatistics& retired()
+{
+	static MatrixPoolStatistics counts;
+	return counts;
+}
+
+//Set once a thread's cache is destroyed, buffers released after it (static matrices at exit) go straight to the system
+static thread_local bool poolClosed = false;
+
+struct PoolCache
+{
+	PoolHeader* free[poolClasses] = {};
+	uint64_t cachedBytes = 0;
+	PoolCounts counts;
+	PoolCache()
+	{
+		std::lock_guard<std::mutex> lock(registryLock());
+		registry().push_back(this);
+	}
+	~PoolCache()
+	{
+		trim();
+		std::lock_guard<std::mutex> lock(registryLock());
+		MatrixPoolStatistics& exited = retired();
+		exited.hits += counts.hits.load();
+		exited.misses += counts.misses.load();
+		exited.bytesInUse += counts.acquired.load() - counts.released.load();
+		exited.peakBytes += counts.peak.load();
+		std::vector<PoolCache*>& caches = registry();
+		for (size_t i = 0; i < caches.size(); ++i)
+		{
+			if (caches[i] != this)continue;
+			caches[i] = caches.back();
+			caches.pop_back();
+			break;
+		}
+		poolClosed = true;
+	}
+	void trim()
+	{
+		for (size_t c = 0; c < poolClasses; ++c)
+		{
+			while (free[c] != nullptr)
+			{
+				PoolHeader* header = free[c];
+				free[c] = header->next;
+				::operator delete[](header, std::align_val_t(MATRIX_POOL_ALIGNMENT));
+			}
+		}
+		cachedBytes = 0;
+		counts.cached.store(0, std::memory_order_relaxed);
+	}
+};
+
+static thread_local PoolCache poolCache;
+
+static PoolCache* threadCache()
+{
+	return poolClosed ? nullptr : &poolCache;
+}
+
+static MatrixPoolStatistics statisticsOf(const PoolCounts& counts)
+{
+	MatrixPoolStatistics s;
+	s.hits = counts.hits.load(std::memory_order_relaxed);
+	s.misses = counts.misses.load(std::memory_order_relaxed);
+	//A thread releasing buffers others acquired can have given back more than it took
+	uint64_t acquired = counts.acquired.load(std::memory_order_relaxed), released = counts.released.load(std::memory_order_relaxed);
+	s.bytesInUse = acquired > released ? acquired - released : 0;
+	s.peakBytes = counts.peak.load(std::memory_order_relaxed);
+	s.bytesCached = counts.cached.load(std::memory_order_relaxed);
+	return s;
+}
+
+size_t MatrixBufferPool::sizeClass(size_t bytes)
+{
+	return bytes > MATRIX_POOL_MAX_BYTES ? poolClasses : classOf(bytes);
+}
+
+size_t MatrixBufferPool::classBytes(size_t sizeClass)
+{
+	if (sizeClass == 0)return 64;
+	size_t e = (sizeClass - 1) / 4 + 6;
+	return (5 + (sizeClass - 1) % 4) << (e - 2);
+}
+
+void* MatrixBufferPool::acquire(size_t bytes)
+{
+	size_t c = sizeClass(bytes);
+	PoolCache* cache = threadCache();
+	if (cache != nullptr && c < poolClasses && cache->free[c] != nullptr)
+	{
+		PoolHeader* header = cache->free[c];
+		cache->free[c] = header->next;
+		cache->cachedBytes -= header->bytes;
+		cache->counts.cached.store(cache->cachedBytes, std::memory_order_relaxed);
+		countAcquire(cache->counts, header->bytes, true);
+		return reinterpret_cast<char*>(header) + MATRIX_POOL_ALIGNMENT;
+	}
+	size_t size = c < poolClasses ? classBytes(c) : bytes;
+	void* raw = ::operator new[](MATRIX_POOL_ALIGNMENT + size, std::align_val_t(MATRIX_POOL_ALIGNMENT), std::nothrow);
+	if (raw == nullptr && cache != nullptr && cache->cachedBytes != 0)
+	{
+		//What this thread holds cached may be what the system is missing
+		cache->trim();
+		raw = ::operator new[](MATRIX_POOL_ALIGNMENT + size, std::align_val_t(MATRIX_POOL_ALIGNMENT), std::nothrow);
+	}
+	if (raw == nullptr)return nullptr;
+	PoolHeader* header = static_cast<PoolHeader*>(raw);
+	header->next = nullptr;
+	header->sizeClass = c;
+	header->bytes = size;
+	if (cache != nullptr)countAcquire(cache->counts, size, false);
+	return static_cast<char*>(raw) + MATRIX_POOL_ALIGNMENT;
+}
+
+void MatrixBufferPool::release(void* buffer)
+{
+	if (buffer == nullptr)return;
+	PoolHeader* header = reinterpret_cast<PoolHeader*>(static_cast<char*>(buffer) - MATRIX_POOL_ALIGNMENT);
+	PoolCache* cache = threadCache();
+	if (cache != nullptr)add(cache->counts.released, header->bytes);
+	if (cache == nullptr || header->sizeClass >= poolClasses || cache->cachedBytes + header->bytes > MATRIX_POOL_CACHE_BYTES)
+	{
+		::operator delete[](header, std::align_val_t(MATRIX_POOL_ALIGNMENT));
+		return;
+	}
+	header->next = cache->free[header->sizeClass];
+	cache->free[header->sizeClass] = header;
+	cache->cachedBytes += header->bytes;
+	cache->counts.cached.store(cache->cachedBytes, std::memory_order_relaxed);
+}
+
+void MatrixBufferPool::trim()
+{
+	PoolCache* cache = threadCache();
+	if (cache != nullptr)cache->trim();
+}
+
+MatrixPoolStatistics MatrixBufferPool::threadStatistics()
+{
+	PoolCache* cache = threadCache();
+	if (cache == nullptr)return MatrixPoolStatistics();
+	return statisticsOf(cache->counts);
+}
+
+MatrixPoolStatistics MatrixBufferPool::statistics()
+{
+	std::lock_guard<std::mutex> lock(registryLock());
+	MatrixPoolStatistics total = retired();
+	uint64_t acquired = 0, released = 0;
+	for (PoolCache* cache : registry())
+	{
+		MatrixPoolStatistics s = statisticsOf(cache->counts);
+		total.hits += s.hits;
+		total.misses += s.misses;
+		total.peakBytes += s.peakBytes;
+		total.bytesCached += s.bytesCached;
+		acquired += cache->counts.acquired.load(std::memory_order_relaxed);
+		released += cache->counts.released.load(std::memory_order_relaxed);
+	}
+	total.bytesInUse += acquired - released;
+	return total;
+}
\ No newline at end of file
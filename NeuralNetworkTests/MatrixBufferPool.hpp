@@ -0,0 +1,50 @@
+/*
+Author: Dan Rehberg
+Modified Date: 10/19/2026
+Purpose: Size class pool behind every SerialMatrix buffer, so the temporaries of an epoch (addOnes copies, transposes,
+	products) are recycled rather than returned to and requested from the system each time.
+	Sizes are rounded up to classes four to a power of two (at most 25% slack), each class a free list per thread:
+		a thread only ever touches its own lists, so pool workers never contend, and a buffer released on another thread
+		than the one that acquired it joins the releasing thread's lists.
+	A thread's cached buffers go back to the system when the thread exits, on trim, or once it caches more than
+		MATRIX_POOL_CACHE_BYTES; buffers over MATRIX_POOL_MAX_BYTES are never cached.
+*/
+
+#ifndef __MATRIX_BUFFER_POOL__
+#define __MATRIX_BUFFER_POOL__
+
+#include <cstddef>
+#include <cstdint>
+
+//0 to send every matrix buffer straight to aligned operator new and delete
+#define MATRIX_BUFFER_POOL 1
+//Every buffer starts on a cache line, at least MATRIX_ALIGNMENT
+#define MATRIX_POOL_ALIGNMENT 64
+//Larger buffers are allocated and released as they are asked for
+#define MATRIX_POOL_MAX_BYTES (64 << 20)
+//Most bytes one thread keeps cached, buffers released beyond it go back to the system
+#define MATRIX_POOL_CACHE_BYTES (256 << 20)
+
+struct MatrixPoolStatistics
+{
+	uint64_t hits = 0;//Acquires served from a free list
+	uint64_t misses = 0;//Acquires that went to the system, oversized ones included
+	uint64_t bytesInUse = 0;//Class bytes acquired and not yet released
+	uint64_t peakBytes = 0;//Most bytes in use at once, summed over threads for statistics()
+	uint64_t bytesCached = 0;//Held in free lists
+};
+
+class MatrixBufferPool final
+{
+public:
+	MatrixBufferPool() = delete;
+	static void* acquire(size_t bytes);//MATRIX_POOL_ALIGNMENT aligned, nullptr on failure as new (std::nothrow)
+	static void release(void* buffer);//Any thread may release any buffer from acquire, nullptr is ignored
+	static void trim();//The calling thread's cached buffers back to the system
+	static MatrixPoolStatistics threadStatistics();//The calling thread's counts
+	static MatrixPoolStatistics statistics();//Every thread that has used the pool, exited ones included
+	static size_t sizeClass(size_t bytes);//Free list a request is served from, one past the last for oversized requests
+	static size_t classBytes(size_t sizeClass);//Bytes every buffer of a class holds
+};
+
+#endif // !__MATRIX_BUFFER_POOL__
\ No newline at end of file
@@ -0,0 +1,563 @@
+/*
+Author: Dan Rehberg
+Modified Date: 10/19/2026
+Purpose: Lazy elementwise arithmetic for SerialMatrix.
+	+, -, /, componentwise, square, and the scalar on the left operators build a small tree of nodes instead of
+		a temporary matrix per operator; the tree is evaluated in one pass when it is assigned to a SerialMatrix.
+	Nodes compute in their operands' accumulator type (Value, float unless the matrices say otherwise) and the result is
+		rounded to the destination's element type as it is stored; Result is the matrix type a tree evaluates into.
+	Broadcasting follows the original operators: a right hand side with 1 row is applied to every row of the left,
+		otherwise the dimensions must match.
+	Nodes read through get(row, column) and a broadcast row is read at row 0; matrices may pad their rows (stride),
+		so a tree is only walked as one flat loop (get(0, index)) when contiguous() holds for every node in it.
+	get reads a matrix leaf in its storage order, at always reads (row, column); leaves() tells which walk a tree allows:
+		row major storage into a row major destination, column major storage into a column major one (storage dimensions),
+		and anything else a tile at a time through at, so both layouts are read within a few cache lines.
+	Matrices are held by reference, so a tree must not outlive the statement that built it (assign it, don't keep it).
+	A matrix given as an rvalue (a temporary, e.g., a product, or std::move'd) is an expiring leaf: a new matrix built from
+		the tree, or one whose storage has to change, is evaluated into that leaf's buffer and takes it, so a chain of
+		operators on a temporary allocates nothing more; the rvalue is left empty, as a moved from matrix is.
+	Matrix * matrix is still the GEMM product and evaluates any lazy operand first.
+*/
+
+#ifndef __MATRIX_EXPRESSIONS__
+#define __MATRIX_EXPRESSIONS__
+
+#include "MatrixKernels.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+//Fused loops carry no dependence between elements, even when the result overwrites one of the operands
+#if defined(__clang__)
+#define MATRIX_IVDEP _Pragma("clang loop vectorize(assume_safety)")
+#elif defined(__GNUC__)
+#define MATRIX_IVDEP _Pragma("GCC ivdep")
+#elif defined(_MSC_VER)
+#define MATRIX_IVDEP __pragma(loop(ivdep))
+#else
+#define MATRIX_IVDEP
+#endif
+
+template <typename T, typename Acc = typename MatrixAccumulator<T>::type>
+class BasicSerialMatrix;
+
+template <typename E>
+class MatrixExpression
+{
+public:
+	const E& self() const
+	{
+		return static_cast<const E&>(*this);
+	}
+};
+
+//What an expression's leaves are, or'd up the tree, see evaluateLayout
+enum ExpressionLeaf : unsigned int
+{
+	LeafRowMajor = 1,//A row major matrix
+	LeafColumnMajor = 2,//A column major matrix
+	LeafView = 4,//Reads (row, column) through get as well
+	LeafBroadcast = 8//A node repeating a row
+};
+
+//Matrices are held by reference, nodes by value (they are a few pointers and sizes)
+template <typename E>
+struct ExpressionOperand
+{
+	typedef const E type;
+};
+
+template <typename T, typename Acc>
+struct ExpressionOperand<BasicSerialMatrix<T, Acc>>
+{
+	typedef const BasicSerialMatrix<T, Acc>& type;
+};
+
+template <ElementOp Op>
+struct ElementFunction;
+
+template <>
+struct ElementFunction<ElementOp::Add>
+{
+	template <typename V>
+	static V apply(V a, V b) { return a + b; }
+};
+
+template <>
+struct ElementFunction<ElementOp::Subtract>
+{
+	template <typename V>
+	static V apply(V a, V b) { return a - b; }
+};
+
+template <>
+struct ElementFunction<ElementOp::Multiply>
+{
+	template <typename V>
+	static V apply(V a, V b) { return a * b; }
+};
+
+template <>
+struct ElementFunction<ElementOp::Divide>
+{
+	template <typename V>
+	static V apply(V a, V b) { return a / b; }
+};
+
+//lhs op rhs; rhs may be a broadcast row unless built by componentwise
+template <typename L, typename R, ElementOp Op>
+class MatrixBinary : public MatrixExpression<MatrixBinary<L, R, Op>>
+{
+public:
+	typedef typename std::common_type<typename L::Value, typename R::Value>::type Value;
+	typedef typename L::Result Result;
+	MatrixBinary(const L& left, const R& right, bool allowBroadcast = true) : lhs(left), rhs(right), broadcast(false)
+	{
+		std::pair<size_t, size_t> l = lhs.getDimensions(), r = rhs.getDimensions();
+		if (!allowBroadcast)
+		{
+			if (l != r)throw std::length_error(R"(Componentwise multiplication of
+		matrices requires the matrices have the same dimensions;
+		A has: )" + std::to_string(l.first) + ", " + std::to_string(l.second) + " while B has: " +
+				std::to_string(r.first) + ", " + std::to_string(r.second));
+		}
+		//row or columns modifications only -- might extend, needed to run the NN for now
+		else if (r.first == 1)
+		{
+			if (r.second != l.second)
+				throw std::range_error(R"(Right matrix with 1 row must match column size with left
+				matrix\n\t right matrix column size is: )" + std::to_string(r.second));
+			broadcast = (l.first != 1);
+		}
+		else if (l != r)throw std::range_error(R"(Right matrix needs like dimensions,
+		or 1 row with same columns
+		\n\t right matrix has dimensions: )" + std::to_string(r.first) + ", " +
+			std::to_string(r.second));
+	}
+	std::pair<size_t, size_t> getDimensions() const { return lhs.getDimensions(); }
+	size_t getCapacity() const { return lhs.getCapacity(); }
+	bool contiguous() const { return !broadcast && lhs.contiguous() && rhs.contiguous(); }
+	unsigned int leaves() const { return lhs.leaves() | rhs.leaves() | (broadcast ? LeafBroadcast : 0u); }
+	Value get(size_t row, size_t column) const
+	{
+		return ElementFunction<Op>::template apply<Value>(lhs.get(row, column), rhs.get(broadcast ? 0 : row, column));
+	}
+	Value at(size_t row, size_t column) const
+	{
+		return ElementFunction<Op>::template apply<Value>(lhs.at(row, column), rhs.at(broadcast ? 0 : row, column));
+	}
+	typename ExpressionOperand<L>::type lhs;
+	typename ExpressionOperand<R>::type rhs;
+	bool broadcast;
+};
+
+//s op rhs for a scalar on the left, held as the right hand side's Value
+template <typename R, ElementOp Op>
+class MatrixScalarLeft : public MatrixExpression<MatrixScalarLeft<R, Op>>
+{
+public:
+	typedef typename R::Value Value;
+	typedef typename R::Result Result;
+	MatrixScalarLeft(Value left, const R& right) : s(left), rhs(right) {}
+	std::pair<size_t, size_t> getDimensions() const { return rhs.getDimensions(); }
+	size_t getCapacity() const { return rhs.getCapacity(); }
+	bool contiguous() const { return rhs.contiguous(); }
+	unsigned int leaves() const { return rhs.leaves(); }
+	Value get(size_t row, size_t column) const
+	{
+		return ElementFunction<Op>::apply(s, rhs.get(row, column));
+	}
+	Value at(size_t row, size_t column) const
+	{
+		return ElementFunction<Op>::apply(s, rhs.at(row, column));
+	}
+	Value s;
+	typename ExpressionOperand<R>::type rhs;
+};
+
+template <typename E>
+class MatrixSquare : public MatrixExpression<MatrixSquare<E>>
+{
+public:
+	typedef typename E::Value Value;
+	typedef typename E::Result Result;
+	MatrixSquare(const E& operand) : ref(operand) {}
+	std::pair<size_t, size_t> getDimensions() const { return ref.getDimensions(); }
+	size_t getCapacity() const { return ref.getCapacity(); }
+	bool contiguous() const { return ref.contiguous(); }
+	unsigned int leaves() const { return ref.leaves(); }
+	Value get(size_t row, size_t column) const
+	{
+		Value value = ref.get(row, column);
+		return value * value;
+	}
+	Value at(size_t row, size_t column) const
+	{
+		Value value = ref.at(row, column);
+		return value * value;
+	}
+	typename ExpressionOperand<E>::type ref;
+};
+
+//Rows [begin, begin + count) of an expression, the share of it one task of a parallel evaluation works on
+//	a contiguous expression stays contiguous, its flat index just starts begin rows in
+template <typename E>
+class MatrixRows : public MatrixExpression<MatrixRows<E>>
+{
+public:
+	typedef typename E::Value Value;
+	typedef typename E::Result Result;
+	MatrixRows(const E& operand, size_t begin, size_t count) : ref(operand), first(begin), rows(count) {}
+	std::pair<size_t, size_t> getDimensions() const { return std::pair<size_t, size_t>(rows, ref.getDimensions().second); }
+	size_t getCapacity() const { return rows * ref.getDimensions().second; }
+	bool contiguous() const { return ref.contiguous(); }
+	unsigned int leaves() const { return ref.leaves(); }
+	Value get(size_t row, size_t column) const { return ref.get(first + row, column); }
+	Value at(size_t row, size_t column) const { return ref.at(first + row, column); }
+	const E& ref;//Only built for the length of a task, while the whole expression is alive
+	size_t first, rows;
+};
+
+//A matrix leaf the caller has given up, read as any other; see expiringLeaf
+template <typename M>
+class MatrixExpiring : public MatrixExpression<MatrixExpiring<M>>
+{
+public:
+	typedef typename M::Value Value;
+	typedef typename M::Result Result;
+	explicit MatrixExpiring(M& operand) : ref(operand) {}
+	std::pair<size_t, size_t> getDimensions() const { return ref.getDimensions(); }
+	size_t getCapacity() const { return ref.getCapacity(); }
+	bool contiguous() const { return ref.contiguous(); }
+	unsigned int leaves() const { return ref.leaves(); }
+	Value get(size_t row, size_t column) const { return ref.get(row, column); }
+	Value at(size_t row, size_t column) const { return ref.at(row, column); }
+	M& ref;//Held by reference as any matrix, its buffer may be taken once the tree is evaluated
+};
+
+//The first expiring matrix of type M in a tree that is read at every element of the result, nullptr when there is none
+//	a tree may be evaluated into it: each element is read before the same element is written
+template <typename M, typename E>
+M* expiringLeaf(const MatrixExpression<E>&)
+{
+	return nullptr;
+}
+
+template <typename M>
+M* expiringLeaf(const MatrixExpiring<M>& e)
+{
+	return &e.ref;
+}
+
+template <typename M, typename L, typename R, ElementOp Op>
+M* expiringLeaf(const MatrixBinary<L, R, Op>& e)
+{
+	M* leaf = expiringLeaf<M>(e.lhs);
+	return leaf != nullptr || e.broadcast ? leaf : expiringLeaf<M>(e.rhs);//A broadcast row is read by every row
+}
+
+template <typename M, typename R, ElementOp Op>
+M* expiringLeaf(const MatrixScalarLeft<R, Op>& e)
+{
+	return expiringLeaf<M>(e.rhs);
+}
+
+template <typename M, typename E>
+M* expiringLeaf(const MatrixSquare<E>& e)
+{
+	return expiringLeaf<M>(e.ref);
+}
+
+template <typename L, typename R>
+MatrixBinary<L, R, ElementOp::Add> operator+(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs)
+{
+	return MatrixBinary<L, R, ElementOp::Add>(lhs.self(), rhs.self());
+}
+
+template <typename L, typename R>
+MatrixBinary<L, R, ElementOp::Subtract> operator-(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs)
+{
+	return MatrixBinary<L, R, ElementOp::Subtract>(lhs.self(), rhs.self());
+}
+
+template <typename L, typename R>
+MatrixBinary<L, R, ElementOp::Divide> operator/(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs)
+{
+	return MatrixBinary<L, R, ElementOp::Divide>(lhs.self(), rhs.self());
+}
+
+template <typename R>
+MatrixScalarLeft<R, ElementOp::Subtract> operator-(const typename R::Value lhs, const MatrixExpression<R>& rhs)
+{
+	return MatrixScalarLeft<R, ElementOp::Subtract>(lhs, rhs.self());
+}
+
+template <typename R>
+MatrixScalarLeft<R, ElementOp::Multiply> operator*(const typename R::Value lhs, const MatrixExpression<R>& rhs)
+{
+	return MatrixScalarLeft<R, ElementOp::Multiply>(lhs, rhs.self());
+}
+
+//Scales by the reciprocal of lhs, as it always has
+template <typename R>
+MatrixScalarLeft<R, ElementOp::Multiply> operator/(const typename R::Value lhs, const MatrixExpression<R>& rhs)
+{
+	return MatrixScalarLeft<R, ElementOp::Multiply>(typename R::Value(1) / lhs, rhs.self());
+}
+
+//Storage an evaluation writes: rows of stride elements (columns when column major) holding a result of dimensions
+struct ExpressionTarget
+{
+	const void* begin, * end;
+	size_t stride;
+	std::pair<size_t, size_t> dimensions;
+	bool columnMajor;
+	bool holds(const void* p) const { return std::less_equal<const void*>()(begin, p) && std::less<const void*>()(p, end); }
+};
+
+//Whether a leaf of the tree reads out's storage other than element for element as it is written there, e.g., transposed,
+//	from another row, or repeated as a broadcast row; such a tree overwrites elements it has still to read,
+//	so it must be evaluated into other storage. Matrix and view leaves are defined with their classes
+template <typename E>
+bool readsAcross(const MatrixExpression<E>&, const ExpressionTarget&)
+{
+	return false;
+}
+
+template <typename M>
+bool readsAcross(const MatrixExpiring<M>& e, const ExpressionTarget& out)
+{
+	return readsAcross(e.ref, out);
+}
+
+template <typename L, typename R, ElementOp Op>
+bool readsAcross(const MatrixBinary<L, R, Op>& e, const ExpressionTarget& out)
+{
+	return readsAcross(e.lhs, out) || readsAcross(e.rhs, out);
+}
+
+template <typename R, ElementOp Op>
+bool readsAcross(const MatrixScalarLeft<R, Op>& e, const ExpressionTarget& out)
+{
+	return readsAcross(e.rhs, out);
+}
+
+template <typename E>
+bool readsAcross(const MatrixSquare<E>& e, const ExpressionTarget& out)
+{
+	return readsAcross(e.ref, out);
+}
+
+//Operators on an expiring matrix, as above with the matrix held as a MatrixExpiring leaf
+template <typename T, typename Acc, typename R>
+MatrixBinary<MatrixExpiring<BasicSerialMatrix<T, Acc>>, R, ElementOp::Add> operator+(BasicSerialMatrix<T, Acc>&& lhs,
+	const MatrixExpression<R>& rhs)
+{
+	return MatrixBinary<MatrixExpiring<BasicSerialMatrix<T, Acc>>, R, ElementOp::Add>(MatrixExpiring<BasicSerialMatrix<T, Acc>>(lhs),
+		rhs.self());
+}
+
+template <typename L, typename T, typename Acc>
+MatrixBinary<L, MatrixExpiring<BasicSerialMatrix<T, Acc>>, ElementOp::Add> operator+(const MatrixExpression<L>& lhs,
+	BasicSerialMatrix<T, Acc>&& rhs)
+{
+	return MatrixBinary<L, MatrixExpiring<BasicSerialMatrix<T, Acc>>, ElementOp::Add>(lhs.self(),
+		MatrixExpiring<BasicSerialMatrix<T, Acc>>(rhs));
+}
+
+template <typename T, typename Acc>
+MatrixBinary<MatrixExpiring<BasicSerialMatrix<T, Acc>>, MatrixExpiring<BasicSerialMatrix<T, Acc>>, ElementOp::Add>
+	operator+(BasicSerialMatrix<T, Acc>&& lhs, BasicSerialMatrix<T, Acc>&& rhs)
+{
+	return MatrixBinary<MatrixExpiring<BasicSerialMatrix<T, Acc>>, MatrixExpiring<BasicSerialMatrix<T, Acc>>, ElementOp::Add>(
+		MatrixExpiring<BasicSerialMatrix<T, Acc>>(lhs), MatrixExpiring<BasicSerialMatrix<T, Acc>>(rhs));
+}
+
+template <typename T, typename Acc, typename R>
+MatrixBinary<MatrixExpiring<BasicSerialMatrix<T, Acc>>, R, ElementOp::Subtract> operator-(BasicSerialMatrix<T, Acc>&& lhs,
+	const MatrixExpression<R>& rhs)
+{
+	return MatrixBinary<MatrixExpiring<BasicSerialMatrix<T, Acc>>, R, ElementOp::Subtract>(MatrixExpiring<BasicSerialMatrix<T, Acc>>(lhs),
+		rhs.self());
+}
+
+template <typename L, typename T, typename Acc>
+MatrixBinary<L, MatrixExpiring<BasicSerialMatrix<T, Acc>>, ElementOp::Subtract> operator-(const MatrixExpression<L>& lhs,
+	BasicSerialMatrix<T, Acc>&& rhs)
+{
+	return MatrixBinary<L, MatrixExpiring<BasicSerialMatrix<T, Acc>>, ElementOp::Subtract>(lhs.self(),
+		MatrixExpiring<BasicSerialMatrix<T, Acc>>(rhs));
+}
+
+template <typename T, typename Acc>
+MatrixBinary<MatrixExpiring<BasicSerialMatrix<T, Acc>>, MatrixExpiring<BasicSerialMatrix<T, Acc>>, ElementOp::Subtract>
+	operator-(BasicSerialMatrix<T, Acc>&& lhs, BasicSerialMatrix<T, Acc>&& rhs)
+{
+	return MatrixBinary<MatrixExpiring<BasicSerialMatrix<T, Acc>>, MatrixExpiring<BasicSerialMatrix<T, Acc>>, ElementOp::Subtract>(
+		MatrixExpiring<BasicSerialMatrix<T, Acc>>(lhs), MatrixExpiring<BasicSerialMatrix<T, Acc>>(rhs));
+}
+
+template <typename T, typename Acc, typename R>
+MatrixBinary<MatrixExpiring<BasicSerialMatrix<T, Acc>>, R, ElementOp::Divide> operator/(BasicSerialMatrix<T, Acc>&& lhs,
+	const MatrixExpression<R>& rhs)
+{
+	return MatrixBinary<MatrixExpiring<BasicSerialMatrix<T, Acc>>, R, ElementOp::Divide>(MatrixExpiring<BasicSerialMatrix<T, Acc>>(lhs),
+		rhs.self());
+}
+
+template <typename L, typename T, typename Acc>
+MatrixBinary<L, MatrixExpiring<BasicSerialMatrix<T, Acc>>, ElementOp::Divide> operator/(const MatrixExpression<L>& lhs,
+	BasicSerialMatrix<T, Acc>&& rhs)
+{
+	return MatrixBinary<L, MatrixExpiring<BasicSerialMatrix<T, Acc>>, ElementOp::Divide>(lhs.self(),
+		MatrixExpiring<BasicSerialMatrix<T, Acc>>(rhs));
+}
+
+template <typename T, typename Acc>
+MatrixBinary<MatrixExpiring<BasicSerialMatrix<T, Acc>>, MatrixExpiring<BasicSerialMatrix<T, Acc>>, ElementOp::Divide>
+	operator/(BasicSerialMatrix<T, Acc>&& lhs, BasicSerialMatrix<T, Acc>&& rhs)
+{
+	return MatrixBinary<MatrixExpiring<BasicSerialMatrix<T, Acc>>, MatrixExpiring<BasicSerialMatrix<T, Acc>>, ElementOp::Divide>(
+		MatrixExpiring<BasicSerialMatrix<T, Acc>>(lhs), MatrixExpiring<BasicSerialMatrix<T, Acc>>(rhs));
+}
+
+template <typename T, typename Acc>
+MatrixScalarLeft<MatrixExpiring<BasicSerialMatrix<T, Acc>>, ElementOp::Subtract> operator-(const typename BasicSerialMatrix<T, Acc>::Value lhs,
+	BasicSerialMatrix<T, Acc>&& rhs)
+{
+	return MatrixScalarLeft<MatrixExpiring<BasicSerialMatrix<T, Acc>>, ElementOp::Subtract>(lhs, MatrixExpiring<BasicSerialMatrix<T, Acc>>(rhs));
+}
+
+template <typename T, typename Acc>
+MatrixScalarLeft<MatrixExpiring<BasicSerialMatrix<T, Acc>>, ElementOp::Multiply> operator*(const typename BasicSerialMatrix<T, Acc>::Value lhs,
+	BasicSerialMatrix<T, Acc>&& rhs)
+{
+	return MatrixScalarLeft<MatrixExpiring<BasicSerialMatrix<T, Acc>>, ElementOp::Multiply>(lhs, MatrixExpiring<BasicSerialMatrix<T, Acc>>(rhs));
+}
+
+template <typename T, typename Acc>
+MatrixScalarLeft<MatrixExpiring<BasicSerialMatrix<T, Acc>>, ElementOp::Multiply> operator/(const typename BasicSerialMatrix<T, Acc>::Value lhs,
+	BasicSerialMatrix<T, Acc>&& rhs)
+{
+	return MatrixScalarLeft<MatrixExpiring<BasicSerialMatrix<T, Acc>>, ElementOp::Multiply>(typename BasicSerialMatrix<T, Acc>::Value(1) / lhs, MatrixExpiring<BasicSerialMatrix<T, Acc>>(rhs));
+}
+
+//Generic case, one fused pass over rows by columns of storage into out, whose rows are ldOut elements apart
+//	an unpadded tree without broadcasts is a flat loop, a single column a loop over rows
+//	Overloads for single operators over matrices follow SerialMatrix
+template <typename E, typename T>
+void evaluateStorage(const E& e, size_t rows, size_t columns, T* out, size_t ldOut)
+{
+	if (e.contiguous() && ldOut == columns)
+	{
+		size_t capacity = rows * columns;
+		MATRIX_IVDEP
+		for (size_t i = 0; i < capacity; ++i)out[i] = static_cast<T>(e.get(0, i));
+		return;
+	}
+	if (columns == 1)
+	{
+		for (size_t i = 0; i < rows; ++i)out[i * ldOut] = static_cast<T>(e.get(i, 0));
+		return;
+	}
+	for (size_t i = 0; i < rows; ++i)
+	{
+		T* row = out + i * ldOut;
+		MATRIX_IVDEP
+		for (size_t j = 0; j < columns; ++j)row[j] = static_cast<T>(e.get(i, j));
+	}
+}
+
+//Row major destination with only row major leaves (and views)
+template <typename E, typename T>
+void evaluateExpression(const E& e, T* out, size_t ldOut)
+{
+	std::pair<size_t, size_t> dimensions = e.getDimensions();
+	evaluateStorage(e, dimensions.first, dimensions.second, out, ldOut);
+}
+
+//Layouts that differ, TRANSPOSE_BLOCK square tiles written in out's storage order
+//	a tile's rows and columns both stay in cache, whichever way each leaf stores them
+template <typename E, typename T>
+void evaluateTiles(const E& e, T* out, size_t ldOut, MatrixLayout layout)
+{
+	std::pair<size_t, size_t> dimensions = e.getDimensions();
+	for (size_t i0 = 0; i0 < dimensions.first; i0 += TRANSPOSE_BLOCK)
+	{
+		size_t i1 = std::min<size_t>(i0 + TRANSPOSE_BLOCK, dimensions.first);
+		for (size_t j0 = 0; j0 < dimensions.second; j0 += TRANSPOSE_BLOCK)
+		{
+			size_t j1 = std::min<size_t>(j0 + TRANSPOSE_BLOCK, dimensions.second);
+			if (layout == MatrixLayout::RowMajor)
+			{
+				for (size_t i = i0; i < i1; ++i)
+				{
+					for (size_t j = j0; j < j1; ++j)out[i * ldOut + j] = static_cast<T>(e.at(i, j));
+				}
+			}
+			else
+			{
+				for (size_t j = j0; j < j1; ++j)
+				{
+					for (size_t i = i0; i < i1; ++i)out[j * ldOut + i] = static_cast<T>(e.at(i, j));
+				}
+			}
+		}
+	}
+}
+
+//out = e, out stored in layout with ldOut elements between stored rows (row major) or columns (column major)
+//	leaves stored as out is walk their storage, through the kernels for single operators in row major,
+//	a column major tree into a column major destination as the row major walk of its transpose
+template <typename E, typename T>
+void evaluateLayout(const E& e, T* out, size_t ldOut, MatrixLayout layout)
+{
+	unsigned int leaves = e.leaves();
+	if (layout == MatrixLayout::RowMajor && (leaves & LeafColumnMajor) == 0)
+	{
+		evaluateExpression(e, out, ldOut);
+	}
+	else if (layout == MatrixLayout::ColumnMajor && leaves == LeafColumnMajor)
+	{
+		std::pair<size_t, size_t> dimensions = e.getDimensions();
+		evaluateStorage(e, dimensions.second, dimensions.first, out, ldOut);
+	}
+	else evaluateTiles(e, out, ldOut, layout);
+}
+
+//Summed in storage order where every leaf is stored alike, (row, column) order otherwise
+template <typename E>
+typename E::Value sumExpression(const E& e)
+{
+	std::pair<size_t, size_t> dimensions = e.getDimensions();
+	unsigned int leaves = e.leaves();
+	typename E::Value total = 0;
+	if ((leaves & LeafColumnMajor) != 0 && leaves != LeafColumnMajor)
+	{
+		for (size_t i = 0; i < dimensions.first; ++i)
+		{
+			for (size_t j = 0; j < dimensions.second; ++j)total += e.at(i, j);
+		}
+		return total;
+	}
+	if (leaves == LeafColumnMajor)std::swap(dimensions.first, dimensions.second);
+	if (e.contiguous())
+	{
+		size_t capacity = e.getCapacity();
+		for (size_t i = 0; i < capacity; ++i)total += e.get(0, i);
+		return total;
+	}
+	for (size_t i = 0; i < dimensions.first; ++i)
+	{
+		for (size_t j = 0; j < dimensions.second; ++j)total += e.get(i, j);
+	}
+	return total;
+}
+
+#endif // !__MATRIX_EXPRESSIONS__
\ No newline at end of file
@@ -0,0 +1,243 @@
+/*
+Author: Dan Rehberg
+Modified Date: 10/19/2026
+*/
+#include "MatrixFile.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+template <typename T, typename Acc>
+void MatrixFile::write(const std::string& path, const BasicSerialMatrix<T, Acc>& matrix)
+{
+	std::pair<size_t, size_t> dimensions = matrix.getDimensions();
+	BasicMatrixView<T, Acc> storage = matrix.view();
+	bool rowMajor = matrix.getLayout() == MatrixLayout::RowMajor;
+	size_t lines = rowMajor ? dimensions.first : dimensions.second, length = rowMajor ? dimensions.second : dimensions.first;
+	MatrixFileHeader header = {};
+	header.magic = MATRIX_FILE_MAGIC;
+	header.version = MATRIX_FILE_VERSION;
+	header.type = static_cast<uint32_t>(MatrixFileTypeOf<T>::value);
+	header.layout = static_cast<uint32_t>(matrix.getLayout());
+	header.rows = dimensions.first;
+	header.columns = dimensions.second;
+	header.stride = storage.getStride();
+	header.alignment = MATRIX_ALIGNMENT;
+	header.dataOffset = (sizeof(MatrixFileHeader) + MATRIX_ALIGNMENT - 1) / MATRIX_ALIGNMENT * MATRIX_ALIGNMENT;
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	if (!out)throw std::runtime_error(R"(Could not create the matrix file: )" + path);
+	out.write(reinterpret_cast<const char*>(&header), sizeof(MatrixFileHeader));
+	std::vector<char> zeros(std::max<size_t>(header.dataOffset - sizeof(MatrixFileHeader), (header.stride - length) * sizeof(T)), 0);
+	out.write(zeros.data(), header.dataOffset - sizeof(MatrixFileHeader));
+	//Line by line so the padding is written as zeros, whatever the matrix's padding holds
+	for (size_t line = 0; line < lines; ++line)
+	{
+		out.write(reinterpret_cast<const char*>(storage.getData() + line * header.stride), length * sizeof(T));
+		out.write(zeros.data(), (header.stride - length) * sizeof(T));
+	}
+	if (!out.flush())throw std::runtime_error(R"(Could not write the matrix file: )" + path);
+}
+
+MatrixFileHeader MatrixFile::readHeader(const std::string& path)
+{
+	std::ifstream in(path, std::ios::binary | std::ios::ate);
+	if (!in)throw std::runtime_error(R"(Could not open the matrix file: )" + path);
+	uint64_t fileSize = static_cast<uint64_t>(in.tellg());
+	MatrixFileHeader header = {};
+	in.seekg(0);
+	if (fileSize >= sizeof(MatrixFileHeader))in.read(reinterpret_cast<char*>(&header), sizeof(MatrixFileHeader));
+	validate(header, fileSize, path);
+	return header;
+}
+
+size_t MatrixFile::elementSize(MatrixFileType type)
+{
+	switch (type)
+	{
+	case MatrixFileType::Float32: return sizeof(float);
+	case MatrixFileType::Float64: return sizeof(double);
+	case MatrixFileType::BFloat16: return sizeof(BFloat16);
+	case MatrixFileType::Float16: return sizeof(Float16);
+	default: return 0;
+	}
+}
+
+void MatrixFile::validate(const MatrixFileHeader& header, uint64_t fileSize, const std::string& path)
+{
+	if (fileSize < sizeof(MatrixFileHeader) || header.magic != MATRIX_FILE_MAGIC)
+		throw std::range_error(R"(Not a matrix file, or one written with the other byte order: )" + path);
+	if (header.version != MATRIX_FILE_VERSION)throw std::range_error(R"(Matrix file version )" +
+		std::to_string(header.version) + " is not supported, expected " + std::to_string(MATRIX_FILE_VERSION) + ": " + path);
+	size_t size = elementSize(static_cast<MatrixFileType>(header.type));
+	if (size == 0 || header.layout > static_cast<uint32_t>(MatrixLayout::ColumnMajor))
+		throw std::range_error(R"(Matrix file has an unknown element type or layout: )" + path);
+	uint64_t lines = header.layout == 0 ? header.rows : header.columns, length = header.layout == 0 ? header.columns : header.rows;
+	if (header.rows == 0 || header.columns == 0 || header.stride < length)throw std::range_error(R"(Matrix file
+		dimensions are empty or do not fit the stride: dimensions: )" + std::to_string(header.rows) + ", " +
+		std::to_string(header.columns) + " stride: " + std::to_string(header.stride) + ": " + path);
+	if (header.alignment == 0 || (header.alignment & (header.alignment - 1)) != 0 || header.dataOffset % header.alignment != 0 ||
+		header.dataOffset < sizeof(MatrixFileHeader))throw std::range_error(R"(Matrix file data offset )" +
+			std::to_string(header.dataOffset) + " is not a multiple of its alignment " + std::to_string(header.alignment) + ": " + path);
+	//The mapping is read as an array of elements from dataOffset, so neither may split an element
+	if (header.alignment < size || header.dataOffset % size != 0)throw std::range_error(R"(Matrix file alignment )" +
+		std::to_string(header.alignment) + " and data offset " + std::to_string(header.dataOffset) +
+		" must be multiples of its element size " + std::to_string(size) + ": " + path);
+	//Divided rather than multiplied out, so a corrupt header cannot overflow into a size that fits
+	if (fileSize < header.dataOffset || (fileSize - header.dataOffset) / size / header.stride < lines)
+		throw std::length_error(R"(Matrix file is shorter than its header describes: )" + path);
+}
+
+MappedMatrix::MappedMatrix() : header(), mapping(nullptr), length(0),
+#if defined(_WIN32)
+	file(nullptr), fileMapping(nullptr)
+#else
+	file(-1)
+#endif
+{
+
+}
+
+MappedMatrix::MappedMatrix(const std::string& path) : MappedMatrix()
+{
+#if defined(_WIN32)
+	HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (handle == INVALID_HANDLE_VALUE)throw std::runtime_error(R"(Could not open the matrix file: )" + path +
+		" error " + std::to_string(GetLastError()));
+	file = handle;
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(handle, &size))
+	{
+		release();
+		throw std::runtime_error(R"(Could not size the matrix file: )" + path);
+	}
+	length = static_cast<size_t>(size.QuadPart);
+	if (length >= sizeof(MatrixFileHeader))
+	{
+		fileMapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (fileMapping != nullptr)mapping = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+		if (mapping == nullptr)
+		{
+			release();
+			throw std::runtime_error(R"(Could not map the matrix file: )" + path + " error " + std::to_string(GetLastError()));
+		}
+	}
+#else
+	file = open(path.c_str(), O_RDONLY);
+	if (file < 0)throw std::runtime_error(R"(Could not open the matrix file: )" + path + ": " + std::strerror(errno));
+	struct stat status;
+	if (fstat(file, &status) != 0)
+	{
+		release();
+		throw std::runtime_error(R"(Could not size the matrix file: )" + path + ": " + std::strerror(errno));
+	}
+	length = static_cast<size_t>(status.st_size);
+	if (length >= sizeof(MatrixFileHeader))
+	{
+		void* address = mmap(nullptr, length, PROT_READ, MAP_SHARED, file, 0);
+		if (address == MAP_FAILED)
+		{
+			release();
+			throw std::runtime_error(R"(Could not map the matrix file: )" + path + ": " + std::strerror(errno));
+		}
+		mapping = address;
+		//Datasets are read front to back, an epoch at a time
+		madvise(address, length, MADV_SEQUENTIAL);
+	}
+#endif
+	if (mapping != nullptr)std::memcpy(&header, mapping, sizeof(MatrixFileHeader));
+	try
+	{
+		MatrixFile::validate(header, length, path);
+	}
+	catch (...)
+	{
+		release();
+		throw;
+	}
+}
+
+MappedMatrix::MappedMatrix(MappedMatrix&& other) noexcept : MappedMatrix()
+{
+	take(other);
+}
+
+MappedMatrix& MappedMatrix::operator=(MappedMatrix&& other) noexcept
+{
+	if (this != &other)
+	{
+		release();
+		take(other);
+	}
+	return *this;
+}
+
+MappedMatrix::~MappedMatrix()
+{
+	release();
+}
+
+void MappedMatrix::close()
+{
+	release();
+}
+
+void MappedMatrix::requireType(MatrixFileType type) const
+{
+	if (mapping == nullptr)throw std::range_error(R"(No matrix file is mapped)");
+	if (static_cast<MatrixFileType>(header.type) != type)throw std::range_error(R"(Matrix file elements are type )" +
+		std::to_string(header.type) + " while the view asked for type " + std::to_string(static_cast<uint32_t>(type)));
+}
+
+void MappedMatrix::release()
+{
+#if defined(_WIN32)
+	if (mapping != nullptr)UnmapViewOfFile(mapping);
+	if (fileMapping != nullptr)CloseHandle(fileMapping);
+	if (file != nullptr)CloseHandle(file);
+	fileMapping = nullptr;
+	file = nullptr;
+#else
+	if (mapping != nullptr)munmap(const_cast<void*>(mapping), length);
+	if (file >= 0)::close(file);
+	file = -1;
+#endif
+	mapping = nullptr;
+	length = 0;
+	header = MatrixFileHeader();
+}
+
+void MappedMatrix::take(MappedMatrix& other)
+{
+	header = other.header;
+	mapping = other.mapping;
+	length = other.length;
+	file = other.file;
+#if defined(_WIN32)
+	fileMapping = other.fileMapping;
+	other.fileMapping = nullptr;
+	other.file = nullptr;
+#else
+	other.file = -1;
+#endif
+	other.mapping = nullptr;
+	other.length = 0;
+	other.header = MatrixFileHeader();
+}
+
+template void MatrixFile::write(const std::string&, const BasicSerialMatrix<float>&);
+template void MatrixFile::write(const std::string&, const BasicSerialMatrix<double>&);
+template void MatrixFile::write(const std::string&, const BasicSerialMatrix<BFloat16>&);
+template void MatrixFile::write(const std::string&, const BasicSerialMatrix<Float16>&);
\ No newline at end of file
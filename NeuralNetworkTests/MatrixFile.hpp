@@ -0,0 +1,134 @@
+/*
+Author: Dan Rehberg
+Modified Date: 10/19/2026
+Purpose: Binary matrix files, read back by mapping them into memory rather than parsing and copying them.
+	A 64 byte MatrixFileHeader, then the matrix storage exactly as SerialMatrix holds it from dataOffset on:
+		lines of stride elements (rows when row major, columns when column major), padding zeroed.
+	MatrixFile::write stores a BasicSerialMatrix; MappedMatrix maps a file read only and views it in place,
+		so opening a multi-GB dataset costs the mapping, and pages are read from disk as the view first touches them.
+	A view of the mapping is a view like any other: products, expressions and statistics read it directly,
+		SerialMatrix(view) copies it once where a matrix is required, e.g., training data.
+	Elements are stored as they are in memory (little endian on every supported target), the magic fails otherwise.
+	POSIX mmap, or CreateFileMapping and MapViewOfFile on Windows.
+*/
+
+#ifndef __MATRIX_FILE__
+#define __MATRIX_FILE__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include "SerialMatrix.hpp"
+
+#define MATRIX_FILE_MAGIC 0x5854414Du//"MATX" read as a little endian uint32_t
+#define MATRIX_FILE_VERSION 1u
+
+enum class MatrixFileType : uint32_t { Float32 = 1, Float64 = 2, BFloat16 = 3, Float16 = 4 };
+
+//Element type tag of a storage type
+template <typename T>
+struct MatrixFileTypeOf;
+
+template <>
+struct MatrixFileTypeOf<float>
+{
+	static const MatrixFileType value = MatrixFileType::Float32;
+};
+
+template <>
+struct MatrixFileTypeOf<double>
+{
+	static const MatrixFileType value = MatrixFileType::Float64;
+};
+
+template <>
+struct MatrixFileTypeOf<BFloat16>
+{
+	static const MatrixFileType value = MatrixFileType::BFloat16;
+};
+
+template <>
+struct MatrixFileTypeOf<Float16>
+{
+	static const MatrixFileType value = MatrixFileType::Float16;
+};
+
+struct MatrixFileHeader
+{
+	uint32_t magic;//MATRIX_FILE_MAGIC
+	uint32_t version;//MATRIX_FILE_VERSION
+	uint32_t type;//MatrixFileType of the elements
+	uint32_t layout;//MatrixLayout, 0 row major, 1 column major
+	uint64_t rows, columns;
+	uint64_t stride;//Elements between the starts of stored lines
+	uint64_t alignment;//Bytes, dataOffset is a multiple of it, as is every line when the stride allows
+	uint64_t dataOffset;//Bytes from the start of the file to the first element
+	uint64_t reserved;//Zero
+};
+
+static_assert(sizeof(MatrixFileHeader) == 64, "The matrix file header is 64 bytes on every target");
+
+class MatrixFile
+{
+public:
+	//The whole storage of matrix, in its layout, the file replaced if it exists
+	template <typename T, typename Acc>
+	static void write(const std::string& path, const BasicSerialMatrix<T, Acc>& matrix);
+	static MatrixFileHeader readHeader(const std::string& path);//Validated against the file's size, nothing else is read
+	static size_t elementSize(MatrixFileType type);//Bytes, 0 for a type this version does not know
+	//Throws unless header describes a matrix that fits in fileSize bytes
+	static void validate(const MatrixFileHeader& header, uint64_t fileSize, const std::string& path);
+};
+
+//A read only mapping of a matrix file, moved but not copied; views of it are invalid once it is destroyed
+class MappedMatrix
+{
+public:
+	MappedMatrix();
+	explicit MappedMatrix(const std::string& path);
+	MappedMatrix(MappedMatrix&& other) noexcept;
+	MappedMatrix& operator=(MappedMatrix&& other) noexcept;
+	MappedMatrix(const MappedMatrix&) = delete;
+	MappedMatrix& operator=(const MappedMatrix&) = delete;
+	~MappedMatrix();
+	bool isOpen() const { return mapping != nullptr; }
+	const MatrixFileHeader& getHeader() const { return header; }
+	MatrixFileType getType() const { return static_cast<MatrixFileType>(header.type); }
+	MatrixLayout getLayout() const { return static_cast<MatrixLayout>(header.layout); }
+	std::pair<size_t, size_t> getDimensions() const
+	{
+		return std::pair<size_t, size_t>(static_cast<size_t>(header.rows), static_cast<size_t>(header.columns));
+	}
+	//The mapped matrix in place, T must be the file's element type; a column major file is read as a transposed view
+	template <typename T, typename Acc = typename MatrixAccumulator<T>::type>
+	BasicMatrixView<T, Acc> view() const
+	{
+		requireType(MatrixFileTypeOf<T>::value);
+		const T* data = reinterpret_cast<const T*>(static_cast<const char*>(mapping) + header.dataOffset);
+		size_t stride = static_cast<size_t>(header.stride);
+		if (getLayout() == MatrixLayout::ColumnMajor)
+			return BasicMatrixView<T, Acc>(data, static_cast<size_t>(header.columns), static_cast<size_t>(header.rows), stride).transpose();
+		return BasicMatrixView<T, Acc>(data, static_cast<size_t>(header.rows), static_cast<size_t>(header.columns), stride);
+	}
+	void close();//Unmaps, as the destructor does
+private:
+	MatrixFileHeader header;
+	const void* mapping;//The whole file
+	size_t length;
+#if defined(_WIN32)
+	void* file, * fileMapping;//HANDLEs, windows.h stays out of this header
+#else
+	int file;
+#endif
+	void requireType(MatrixFileType type) const;
+	void release();
+	void take(MappedMatrix& other);
+};
+
+extern template void MatrixFile::write(const std::string&, const BasicSerialMatrix<float>&);
+extern template void MatrixFile::write(const std::string&, const BasicSerialMatrix<double>&);
+extern template void MatrixFile::write(const std::string&, const BasicSerialMatrix<BFloat16>&);
+extern template void MatrixFile::write(const std::string&, const BasicSerialMatrix<Float16>&);
+
+#endif // !__MATRIX_FILE__
\ No newline at end of file
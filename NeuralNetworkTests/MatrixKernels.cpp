@@ -0,0 +1,661 @@
+/*
+Author: Dan Rehberg
+Modified Date: 10/19/2026
+*/
+#include "MatrixKernels.hpp"
+#include <algorithm>
+#include <vector>
+
+const MatrixKernels::Table* MatrixKernels::forced = nullptr;
+TanHAccuracy MatrixKernels::tanhAccuracy = MATRIX_TANH_ACCURACY;
+
+const MatrixKernels::Table& MatrixKernels::table()
+{
+	//Decided once, on first use, so no kernel runs before the cpuid check
+	static const Table& detected = tableFor(detectISA());
+	return (forced != nullptr) ? *forced : detected;
+}
+
+const MatrixKernels::Table& MatrixKernels::tableFor(KernelISA isa)
+{
+	switch (isa)
+	{
+	case KernelISA::AVX512: return avx512Table();
+	case KernelISA::AVX2: return avx2Table();
+	case KernelISA::SSE4: return sse4Table();
+	default: return scalarTable();
+	}
+}
+
+KernelISA MatrixKernels::getISA()
+{
+	return table().isa;
+}
+
+void MatrixKernels::setISA(KernelISA isa)
+{
+	KernelISA best = detectISA();
+	if (static_cast<int>(isa) > static_cast<int>(best))isa = best;
+	forced = &tableFor(isa);
+}
+
+const char* MatrixKernels::getISAName(KernelISA isa)
+{
+	switch (isa)
+	{
+	case KernelISA::AVX512: return "AVX-512";
+	case KernelISA::AVX2: return "AVX2";
+	case KernelISA::SSE4: return "SSE4.1";
+	default: return "Scalar";
+	}
+}
+
+void MatrixKernels::gemm(size_t m, size_t n, size_t k, float alpha, const float* A, size_t lda,
+	const float* B, size_t ldb, float beta, float* C, size_t ldc)
+{
+	gemm(false, false, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+}
+
+void MatrixKernels::gemm(bool transA, bool transB, size_t m, size_t n, size_t k, float alpha, const float* A, size_t lda,
+	const float* B, size_t ldb, float beta, float* C, size_t ldc, const float* bias, Activation activation)
+{
+	if (m == 0 || n == 0)return;
+	const Table& t = table();
+	if (k == 0 || alpha == 0.0f)scaleC(t, m, n, beta, C, ldc, bias, activation);
+	else if (m == 1 || n == 1 || k == 1)gemmVector(t, transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, bias, activation);
+	else if (m * n * k < GEMM_SMALL)gemmSmall(t, transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, bias, activation);
+	else gemmPacked(t, transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, bias, activation);
+}
+
+//The small path reads B rows as float, so 16 bit operands are packed unless the product is vector shaped
+void MatrixKernels::gemm(bool transA, bool transB, size_t m, size_t n, size_t k, float alpha, const BFloat16* A, size_t lda,
+	const BFloat16* B, size_t ldb, float beta, float* C, size_t ldc, const float* bias, Activation activation)
+{
+	if (m == 0 || n == 0)return;
+	if (k == 0 || alpha == 0.0f)scaleC(table(), m, n, beta, C, ldc, bias, activation);
+	else if (m == 1 || n == 1 || k == 1)gemmVector(table(), transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, bias, activation);
+	else gemmPacked(table(), transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, bias, activation);
+}
+
+void MatrixKernels::gemm(bool transA, bool transB, size_t m, size_t n, size_t k, float alpha, const Float16* A, size_t lda,
+	const Float16* B, size_t ldb, float beta, float* C, size_t ldc, const float* bias, Activation activation)
+{
+	if (m == 0 || n == 0)return;
+	if (k == 0 || alpha == 0.0f)scaleC(table(), m, n, beta, C, ldc, bias, activation);
+	else if (m == 1 || n == 1 || k == 1)gemmVector(table(), transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, bias, activation);
+	else gemmPacked(table(), transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, bias, activation);
+}
+
+void MatrixKernels::scaleC(const Table& t, size_t m, size_t n, float beta, float* C, size_t ldc, const float* bias,
+	Activation activation)
+{
+	for (size_t i = 0; i < m; ++i)
+	{
+		float* c = C + i * ldc;
+		for (size_t j = 0; j < n; ++j)
+		{
+			c[j] = ((beta == 0.0f) ? 0.0f : beta * c[j]) + (bias != nullptr ? bias[j] : 0.0f);
+		}
+		if (activation == Activation::TanH)t.tanh[static_cast<int>(tanhAccuracy)](n, c, c);
+	}
+}
+
+//Per thread so pool workers can each run their own products, shared by every operand type
+static thread_local std::vector<float> packedA(GEMM_MC * GEMM_KC);
+static thread_local std::vector<float> packedB(GEMM_KC * GEMM_NC);
+//Vector products: the vector operand, GEMV_ROWS rows of a 16 bit matrix operand, a result column; grown as needed and kept
+static thread_local std::vector<float> vectorScratch[3];
+
+static float* scratch(size_t which, size_t count)
+{
+	std::vector<float>& buffer = vectorScratch[which];
+	if (buffer.size() < count)buffer.resize(count);
+	return buffer.data();
+}
+
+//count elements step apart as contiguous floats, read in place when they already are
+static const float* floats(const float* x, size_t count, size_t step, size_t which)
+{
+	if (step == 1)return x;
+	float* out = scratch(which, count);
+	for (size_t i = 0; i < count; ++i)out[i] = x[i * step];
+	return out;
+}
+
+template <typename T>
+static const float* floats(const T* x, size_t count, size_t step, size_t which)
+{
+	float* out = scratch(which, count);
+	for (size_t i = 0; i < count; ++i)out[i] = x[i * step];
+	return out;
+}
+
+//rows rows of length elements (lda apart) as floats, ld set to the distance between the rows returned
+static const float* floatRows(const float* A, size_t lda, size_t, size_t, size_t& ld)//Read in place
+{
+	ld = lda;
+	return A;
+}
+
+template <typename T>
+static const float* floatRows(const T* A, size_t lda, size_t rows, size_t length, size_t& ld)
+{
+	float* out = scratch(1, rows * length);
+	for (size_t r = 0; r < rows; ++r)
+	{
+		for (size_t i = 0; i < length; ++i)out[r * length + i] = A[r * lda + i];
+	}
+	ld = length;
+	return out;
+}
+
+template <typename T>
+void MatrixKernels::gemmVector(const Table& t, bool transA, bool transB, size_t m, size_t n, size_t k, float alpha,
+	const T* A, size_t lda, const T* B, size_t ldb, float beta, float* C, size_t ldc, const float* bias, Activation activation)
+{
+	if (n == 1)
+	{
+		//B's one column, stored down a column unless it is transposed
+		matrixVector(t, transA, m, k, alpha, A, lda, floats(B, k, transB ? 1 : ldb, 0), beta, C, ldc, bias, activation);
+		return;
+	}
+	if (m == 1)
+	{
+		vectorMatrix(t, transB, n, k, alpha, floats(A, k, transA ? lda : 1, 0), B, ldb, beta, C, bias, activation);
+		return;
+	}
+	//k of 1: each row of C is beta times itself plus a multiple of B's one row
+	const float* b = floats(B, n, transB ? ldb : 1, 0);
+	for (size_t i = 0; i < m; ++i)
+	{
+		float* c = C + i * ldc;
+		if (beta == 0.0f)
+		{
+			if (bias != nullptr)std::copy(bias, bias + n, c);
+			else std::fill(c, c + n, 0.0f);
+		}
+		else
+		{
+			if (beta != 1.0f)t.scalarLeft[static_cast<int>(ElementOp::Multiply)](n, beta, c, c);
+			if (bias != nullptr)t.binary[static_cast<int>(ElementOp::Add)](n, c, bias, c);
+		}
+		t.axpy(n, alpha * static_cast<float>(transA ? A[i] : A[i * lda]), b, c);
+		if (activation == Activation::TanH)t.tanh[static_cast<int>(tanhAccuracy)](n, c, c);
+	}
+}
+
+template <typename T>
+void MatrixKernels::matrixVector(const Table& t, bool transA, size_t m, size_t k, float alpha, const T* A, size_t lda,
+	const float* x, float beta, float* C, size_t ldc, const float* bias, Activation activation)
+{
+	//Summed into a contiguous column so the epilogue and the activation run as one pass, then stored ldc apart
+	float* y = scratch(2, m);
+	size_t ld = 0;
+	if (!transA || m == 1)
+	{
+		//A dot product per row of A, GEMV_ROWS rows per pass; a transposed single row is one stored column
+		size_t i = 0;
+		for (; i + GEMV_ROWS <= m; i += GEMV_ROWS)
+		{
+			const float* rows = floatRows(A + i * lda, lda, GEMV_ROWS, k, ld);
+			t.dot4(k, rows, ld, x, y + i);
+		}
+		for (; i < m; ++i)y[i] = t.dot(k, transA ? floats(A, k, lda, 1) : floatRows(A + i * lda, lda, 1, k, ld), x);
+	}
+	else
+	{
+		//A is stored k x m: the result is the rows of A scaled by x and summed, GEMV_ROWS rows per pass
+		std::fill(y, y + m, 0.0f);
+		size_t p = 0;
+		for (; p + GEMV_ROWS <= k; p += GEMV_ROWS)
+		{
+			const float* rows = floatRows(A + p * lda, lda, GEMV_ROWS, m, ld);
+			t.axpy4(m, x + p, rows, ld, y);
+		}
+		for (; p < k; ++p)t.axpy(m, x[p], floatRows(A + p * lda, lda, 1, m, ld), y);
+	}
+	for (size_t i = 0; i < m; ++i)
+	{
+		y[i] = alpha * y[i] + ((beta == 0.0f) ? 0.0f : beta * C[i * ldc]) + (bias != nullptr ? bias[0] : 0.0f);
+	}
+	if (activation == Activation::TanH)t.tanh[static_cast<int>(tanhAccuracy)](m, y, y);
+	for (size_t i = 0; i < m; ++i)C[i * ldc] = y[i];
+}
+
+template <typename T>
+void MatrixKernels::vectorMatrix(const Table& t, bool transB, size_t n, size_t k, float alpha, const float* a, const T* B, size_t ldb,
+	float beta, float* C, const float* bias, Activation activation)
+{
+	if (beta == 0.0f)
+	{
+		if (bias != nullptr)std::copy(bias, bias + n, C);
+		else std::fill(C, C + n, 0.0f);
+	}
+	else
+	{
+		if (beta != 1.0f)t.scalarLeft[static_cast<int>(ElementOp::Multiply)](n, beta, C, C);
+		if (bias != nullptr)t.binary[static_cast<int>(ElementOp::Add)](n, C, bias, C);
+	}
+	size_t ld = 0;
+	if (transB)
+	{
+		//B is stored n x k: each element of C is a dot product with a stored row, GEMV_ROWS rows per pass
+		float dots[GEMV_ROWS];
+		size_t j = 0;
+		for (; j + GEMV_ROWS <= n; j += GEMV_ROWS)
+		{
+			const float* rows = floatRows(B + j * ldb, ldb, GEMV_ROWS, k, ld);
+			t.dot4(k, rows, ld, a, dots);
+			for (size_t r = 0; r < GEMV_ROWS; ++r)C[j + r] += alpha * dots[r];
+		}
+		for (; j < n; ++j)C[j] += alpha * t.dot(k, floatRows(B + j * ldb, ldb, 1, k, ld), a);
+	}
+	else
+	{
+		//The rows of B scaled by a and summed into C, which is read and written once per GEMV_ROWS rows
+		float scaled[GEMV_ROWS];
+		size_t p = 0;
+		for (; p + GEMV_ROWS <= k; p += GEMV_ROWS)
+		{
+			for (size_t r = 0; r < GEMV_ROWS; ++r)scaled[r] = alpha * a[p + r];
+			const float* rows = floatRows(B + p * ldb, ldb, GEMV_ROWS, n, ld);
+			t.axpy4(n, scaled, rows, ld, C);
+		}
+		for (; p < k; ++p)t.axpy(n, alpha * a[p], floatRows(B + p * ldb, ldb, 1, n, ld), C);
+	}
+	if (activation == Activation::TanH)t.tanh[static_cast<int>(tanhAccuracy)](n, C, C);
+}
+
+template <typename T>
+void MatrixKernels::gemmPacked(const Table& t, bool transA, bool transB, size_t m, size_t n, size_t k, float alpha,
+	const T* A, size_t lda, const T* B, size_t ldb, float beta, float* C, size_t ldc, const float* bias, Activation activation)
+{
+	for (size_t jc = 0; jc < n; jc += GEMM_NC)
+	{
+		size_t nc = std::min<size_t>(GEMM_NC, n - jc);
+		for (size_t pc = 0; pc < k; pc += GEMM_KC)
+		{
+			size_t kc = std::min<size_t>(GEMM_KC, k - pc);
+			//Only the first pass over k applies beta, the rest accumulate, and only the last runs the epilogue
+			float betaBlock = (pc == 0) ? beta : 1.0f;
+			bool last = (pc + kc == k);
+			packB(transB, kc, nc, t.nr, transB ? B + jc * ldb + pc : B + pc * ldb + jc, ldb, packedB.data());
+			for (size_t ic = 0; ic < m; ic += GEMM_MC)
+			{
+				size_t mc = std::min<size_t>(GEMM_MC, m - ic);
+				packA(transA, mc, kc, t.mr, transA ? A + pc * lda + ic : A + ic * lda + pc, lda, packedA.data());
+				macroKernel(t, mc, nc, kc, alpha, packedA.data(), packedB.data(), betaBlock, C + ic * ldc + jc, ldc,
+					(last && bias != nullptr) ? bias + jc : nullptr, last ? activation : Activation::None);
+			}
+		}
+	}
+}
+
+void MatrixKernels::gemmNaive(size_t m, size_t n, size_t k, const float* A, size_t lda,
+	const float* B, size_t ldb, float* C, size_t ldc)
+{
+	for (size_t i = 0; i < m; ++i)
+	{
+		for (size_t j = 0; j < n; ++j)
+		{
+			float sum = 0;
+			for (size_t p = 0; p < k; ++p)
+			{
+				sum += A[i * lda + p] * B[p * ldb + j];
+			}
+			C[i * ldc + j] = sum;
+		}
+	}
+}
+
+void MatrixKernels::gemmSmall(const Table& t, bool transA, bool transB, size_t m, size_t n, size_t k, float alpha,
+	const float* A, size_t lda, const float* B, size_t ldb, float beta, float* C, size_t ldc,
+	const float* bias, Activation activation)
+{
+	//Each row of C is finished before the next is started, so the epilogue runs on a row still in L1
+	if (transB)
+	{
+		//Rows of a transposed B are its stored rows, so each element of C is one contiguous dot product
+		for (size_t i = 0; i < m; ++i)
+		{
+			float* c = C + i * ldc;
+			for (size_t j = 0; j < n; ++j)
+			{
+				float value;
+				if (transA)
+				{
+					value = 0.0f;
+					for (size_t p = 0; p < k; ++p)value += A[p * lda + i] * B[j * ldb + p];
+				}
+				else value = t.dot(k, A + i * lda, B + j * ldb);
+				c[j] = alpha * value + ((beta == 0.0f) ? 0.0f : beta * c[j]) + (bias != nullptr ? bias[j] : 0.0f);
+			}
+			if (activation == Activation::TanH)t.tanh[static_cast<int>(tanhAccuracy)](n, c, c);
+		}
+		return;
+	}
+	//i-k-j order so both B and C are walked along rows, the bias is where the row starts
+	for (size_t i = 0; i < m; ++i)
+	{
+		float* c = C + i * ldc;
+		if (beta == 0.0f)
+		{
+			if (bias != nullptr)std::copy(bias, bias + n, c);
+			else std::fill(c, c + n, 0.0f);
+		}
+		else
+		{
+			if (beta != 1.0f)t.scalarLeft[static_cast<int>(ElementOp::Multiply)](n, beta, c, c);
+			if (bias != nullptr)t.binary[static_cast<int>(ElementOp::Add)](n, c, bias, c);
+		}
+		for (size_t p = 0; p < k; ++p)
+		{
+			float a = transA ? A[p * lda + i] : A[i * lda + p];
+			t.axpy(n, alpha * a, B + p * ldb, c);
+		}
+		if (activation == Activation::TanH)t.tanh[static_cast<int>(tanhAccuracy)](n, c, c);
+	}
+}
+
+template <typename T>
+void MatrixKernels::packA(bool transA, size_t mc, size_t kc, size_t mr, const T* A, size_t lda, float* packed)
+{
+	//MR rows interleaved per k so the micro kernel reads A contiguously, short slivers zero padded
+	//	A transposed already has those MR values side by side in each stored row
+	for (size_t i = 0; i < mc; i += mr)
+	{
+		size_t rows = std::min<size_t>(mr, mc - i);
+		for (size_t p = 0; p < kc; ++p)
+		{
+			if (transA)
+			{
+				const T* a = A + p * lda + i;
+				for (size_t ii = 0; ii < rows; ++ii)
+				{
+					*packed++ = a[ii];
+				}
+			}
+			else
+			{
+				for (size_t ii = 0; ii < rows; ++ii)
+				{
+					*packed++ = A[(i + ii) * lda + p];
+				}
+			}
+			for (size_t ii = rows; ii < mr; ++ii)
+			{
+				*packed++ = 0.0f;
+			}
+		}
+	}
+}
+
+template <typename T>
+void MatrixKernels::packB(bool transB, size_t kc, size_t nc, size_t nr, const T* B, size_t ldb, float* packed)
+{
+	//NR columns per k, so each B sliver is one contiguous KC x NR run
+	for (size_t j = 0; j < nc; j += nr)
+	{
+		size_t columns = std::min<size_t>(nr, nc - j);
+		for (size_t p = 0; p < kc; ++p)
+		{
+			if (transB)
+			{
+				for (size_t jj = 0; jj < columns; ++jj)
+				{
+					*packed++ = B[(j + jj) * ldb + p];
+				}
+			}
+			else
+			{
+				const T* b = B + p * ldb + j;
+				for (size_t jj = 0; jj < columns; ++jj)
+				{
+					*packed++ = b[jj];
+				}
+			}
+			for (size_t jj = columns; jj < nr; ++jj)
+			{
+				*packed++ = 0.0f;
+			}
+		}
+	}
+}
+
+void MatrixKernels::macroKernel(const Table& t, size_t mc, size_t nc, size_t kc, float alpha, const float* packedA,
+	const float* packedB, float beta, float* C, size_t ldc, const float* bias, Activation activation)
+{
+	for (size_t j = 0; j < nc; j += t.nr)
+	{
+		size_t nr = std::min<size_t>(t.nr, nc - j);
+		for (size_t i = 0; i < mc; i += t.mr)
+		{
+			size_t mr = std::min<size_t>(t.mr, mc - i);
+			t.microKernel(kc, alpha, packedA + i * kc, packedB + j * kc, beta, C + i * ldc + j, ldc, mr, nr,
+				bias != nullptr ? bias + j : nullptr, activation, tanhAccuracy);
+		}
+	}
+}
+
+TanHAccuracy MatrixKernels::getTanHAccuracy()
+{
+	return tanhAccuracy;
+}
+
+void MatrixKernels::setTanHAccuracy(TanHAccuracy accuracy)
+{
+	tanhAccuracy = accuracy;
+}
+
+void MatrixKernels::activate(Activation activation, size_t count, const float* A, float* C)
+{
+	if (activation == Activation::TanH)table().tanh[static_cast<int>(tanhAccuracy)](count, A, C);
+	else if (A != C)std::copy(A, A + count, C);
+}
+
+void MatrixKernels::elementwise(ElementOp op, size_t count, const float* A, const float* B, float* C)
+{
+	table().binary[static_cast<int>(op)](count, A, B, C);
+}
+
+void MatrixKernels::broadcastRow(ElementOp op, size_t rows, size_t columns, const float* A, size_t lda,
+	const float* row, float* C, size_t ldc)
+{
+	auto f = table().binary[static_cast<int>(op)];
+	for (size_t i = 0; i < rows; ++i)
+	{
+		f(columns, A + i * lda, row, C + i * ldc);
+	}
+}
+
+void MatrixKernels::scalarLeft(ElementOp op, size_t count, float s, const float* A, float* C)
+{
+	table().scalarLeft[static_cast<int>(op)](count, s, A, C);
+}
+
+void MatrixKernels::square(size_t count, const float* A, float* C)
+{
+	table().square(count, A, C);
+}
+
+void MatrixKernels::axpy(size_t count, float a, const float* X, float* Y)
+{
+	table().axpy(count, a, X, Y);
+}
+
+float MatrixKernels::sum(size_t count, const float* A)
+{
+	return table().sum(count, A);
+}
+
+float MatrixKernels::dot(size_t count, const float* A, const float* B)
+{
+	return table().dot(count, A, B);
+}
+
+void MatrixKernels::elementwise(ElementOp op, size_t rows, size_t columns, const float* A, size_t lda,
+	const float* B, size_t ldb, float* C, size_t ldc)
+{
+	auto f = table().binary[static_cast<int>(op)];
+	if (lda == columns && ldb == columns && ldc == columns)
+	{
+		f(rows * columns, A, B, C);
+		return;
+	}
+	for (size_t i = 0; i < rows; ++i)
+	{
+		f(columns, A + i * lda, B + i * ldb, C + i * ldc);
+	}
+}
+
+void MatrixKernels::scalarLeft(ElementOp op, size_t rows, size_t columns, float s, const float* A, size_t lda,
+	float* C, size_t ldc)
+{
+	auto f = table().scalarLeft[static_cast<int>(op)];
+	if (lda == columns && ldc == columns)
+	{
+		f(rows * columns, s, A, C);
+		return;
+	}
+	for (size_t i = 0; i < rows; ++i)
+	{
+		f(columns, s, A + i * lda, C + i * ldc);
+	}
+}
+
+void MatrixKernels::square(size_t rows, size_t columns, const float* A, size_t lda, float* C, size_t ldc)
+{
+	auto f = table().square;
+	if (lda == columns && ldc == columns)
+	{
+		f(rows * columns, A, C);
+		return;
+	}
+	for (size_t i = 0; i < rows; ++i)
+	{
+		f(columns, A + i * lda, C + i * ldc);
+	}
+}
+
+void MatrixKernels::axpy(size_t rows, size_t columns, float a, const float* X, size_t ldx, float* Y, size_t ldy)
+{
+	auto f = table().axpy;
+	if (ldx == columns && ldy == columns)
+	{
+		f(rows * columns, a, X, Y);
+		return;
+	}
+	for (size_t i = 0; i < rows; ++i)
+	{
+		f(columns, a, X + i * ldx, Y + i * ldy);
+	}
+}
+
+float MatrixKernels::sum(size_t rows, size_t columns, const float* A, size_t lda)
+{
+	auto f = table().sum;
+	if (lda == columns)return f(rows * columns, A);
+	float total = 0.0f;
+	for (size_t i = 0; i < rows; ++i)
+	{
+		total += f(columns, A + i * lda);
+	}
+	return total;
+}
+
+void MatrixKernels::columnSums(size_t rows, size_t columns, const float* A, size_t lda, float* sums)
+{
+	auto f = table().binary[static_cast<int>(ElementOp::Add)];
+	for (size_t i = 0; i < rows; ++i)
+	{
+		f(columns, sums, A + i * lda, sums);
+	}
+}
+
+void MatrixKernels::columnSquaredDeviations(size_t rows, size_t columns, const float* A, size_t lda,
+	const float* mean, float* sums)
+{
+	auto f = table().squaredDeviation;
+	for (size_t i = 0; i < rows; ++i)
+	{
+		f(columns, A + i * lda, mean, sums);
+	}
+}
+
+void MatrixKernels::columnMoments(size_t rows, size_t columns, const float* A, size_t lda, size_t seen, float* mean, float* m2)
+{
+	auto f = table().welford;
+	for (size_t i = 0; i < rows; ++i)
+	{
+		f(columns, A + i * lda, 1.0f / static_cast<float>(seen + i + 1), mean, m2);
+	}
+}
+
+void MatrixKernels::transpose(size_t rows, size_t columns, const float* A, size_t lda, float* B, size_t ldb)
+{
+	const Table& t = table();
+	size_t tile = t.tile;
+	for (size_t i0 = 0; i0 < rows; i0 += TRANSPOSE_BLOCK)
+	{
+		size_t i1 = std::min<size_t>(i0 + TRANSPOSE_BLOCK, rows);
+		for (size_t j0 = 0; j0 < columns; j0 += TRANSPOSE_BLOCK)
+		{
+			size_t j1 = std::min<size_t>(j0 + TRANSPOSE_BLOCK, columns);
+			size_t i = i0;
+			for (; i + tile <= i1; i += tile)
+			{
+				size_t j = j0;
+				for (; j + tile <= j1; j += tile)t.transposeTile(A + i * lda + j, lda, B + j * ldb + i, ldb);
+				for (; j < j1; ++j)
+				{
+					for (size_t r = i; r < i + tile; ++r)B[j * ldb + r] = A[r * lda + j];
+				}
+			}
+			for (; i < i1; ++i)
+			{
+				for (size_t j = j0; j < j1; ++j)B[j * ldb + i] = A[i * lda + j];
+			}
+		}
+	}
+}
+
+void MatrixKernels::transposeSquare(size_t n, float* A, size_t lda)
+{
+	const Table& t = table();
+	size_t tile = t.tile;
+	size_t tiled = n - n % tile;
+	float buffer[8 * 8];//Largest tile of any table, the AVX ones
+	for (size_t i0 = 0; i0 < tiled; i0 += TRANSPOSE_BLOCK)
+	{
+		size_t i1 = std::min<size_t>(i0 + TRANSPOSE_BLOCK, tiled);
+		//Only blocks on and above the diagonal, each pair of mirrored tiles is swapped once
+		for (size_t j0 = i0; j0 < tiled; j0 += TRANSPOSE_BLOCK)
+		{
+			size_t j1 = std::min<size_t>(j0 + TRANSPOSE_BLOCK, tiled);
+			for (size_t i = i0; i < i1; i += tile)
+			{
+				for (size_t j = (j0 == i0) ? i : j0; j < j1; j += tile)
+				{
+					float* upper = A + i * lda + j;
+					float* lower = A + j * lda + i;
+					t.transposeTile(upper, lda, buffer, tile);
+					if (i != j)t.transposeTile(lower, lda, upper, lda);
+					for (size_t r = 0; r < tile; ++r)std::copy(buffer + r * tile, buffer + (r + 1) * tile, lower + r * lda);
+				}
+			}
+		}
+	}
+	//The ragged edge past the last whole tile
+	for (size_t i = 0; i < n; ++i)
+	{
+		for (size_t j = std::max(i + 1, tiled); j < n; ++j)std::swap(A[i * lda + j], A[j * lda + i]);
+	}
+}
+
+void MatrixKernels::transposeNaive(size_t rows, size_t columns, const float* A, size_t lda, float* B, size_t ldb)
+{
+	for (size_t j = 0; j < columns; ++j)
+	{
+		for (size_t i = 0; i < rows; ++i)B[j * ldb + i] = A[i * lda + j];
+	}
+}
\ No newline at end of file
@@ -0,0 +1,170 @@
+/*
+Author: Dan Rehberg
+Modified Date: 10/19/2026
+Purpose: Raw kernels behind the SerialMatrix operations.
+	Row major buffers with explicit leading dimensions (floats between the starts of two rows),
+		so the matrix classes can hand over their innards without copies.
+	Products with one row (m), one column (n) or a shared dimension (k) of 1 are vector products at any size:
+		matrix times vector, vector times matrix, and the outer product, read in place without packing,
+		four rows of the matrix operand per pass so the vector is loaded (or the result row written) once per four.
+	GEMM otherwise follows the usual packed layout: B is packed into KC x NR slivers (L1) of a KC x NC panel (L3),
+		A into MR x KC slivers of an MC x KC block (L2), and an MR x NR tile of C stays in registers
+		for the whole KC loop of the micro kernel.
+	Every kernel has a scalar fallback and SSE4.1, AVX2 (+FMA) and AVX-512F versions; the best one the
+		CPU and OS support is picked with cpuid on first use, so one binary serves old and new nodes.
+	BFloat16 and Float16 operands are converted to float as they are packed, so a 16 bit GEMM reads half the bytes
+		from memory and still runs the float micro kernels; other element types go through TypedKernels.
+*/
+
+#ifndef __MATRIX_KERNELS__
+#define __MATRIX_KERNELS__
+
+#include <cstddef>
+#include "MatrixTypes.hpp"
+
+//Cache blocking for fp32, MC a multiple of every MR and NC a multiple of every NR below
+#define GEMM_KC 256//shared dimension per block, an MR x KC and a KC x NR sliver fit in a 32KB L1
+#define GEMM_MC 96//rows of A packed per block, MC x KC (96KB) stays in L2
+#define GEMM_NC 2048//columns of B packed per panel, KC x NC (2MB) stays in L3
+//Register tiles (MR x NR) per instruction set
+#define GEMM_MR_SCALAR 4
+#define GEMM_NR_SCALAR 8
+#define GEMM_MR_SSE4 4
+#define GEMM_NR_SSE4 8
+#define GEMM_MR_AVX2 6
+#define GEMM_NR_AVX2 16
+#define GEMM_MR_AVX512 8
+#define GEMM_NR_AVX512 32
+//Below this many multiply adds the packing costs more than it saves
+#define GEMM_SMALL (32 * 32 * 32)
+//Rows of the matrix operand a vector product reads per pass, 4 for the dot4 and axpy4 kernels
+#define GEMV_ROWS 4
+//Transposes walk square blocks of this many rows and columns, a block read and its transpose written (2 x 4KB) stay in L1
+#define TRANSPOSE_BLOCK 32
+
+enum class KernelISA { Scalar, SSE4, AVX2, AVX512 };
+enum class ElementOp { Add, Subtract, Multiply, Divide };
+enum class Activation { None, TanH };
+//tanh through libm, a vectorized approximation within about 1 ulp, or a faster one within about 1e-4 relative error;
+//	NaN passes through all three and +-inf gives exactly +-1
+enum class TanHAccuracy { Exact, Ulp, Fast };
+//What every tanh (activateTanH, the GEMM epilogue) starts with, setTanHAccuracy changes it at runtime
+#define MATRIX_TANH_ACCURACY TanHAccuracy::Exact
+
+class MatrixKernels final
+{
+public:
+	MatrixKernels() = delete;
+	//C[m x n] = alpha * A[m x k] * B[k x n] + beta * C, C is not read when beta is zero
+	static void gemm(size_t m, size_t n, size_t k, float alpha, const float* A, size_t lda,
+		const float* B, size_t ldb, float beta, float* C, size_t ldc);
+	//Same with op(X) = X^T when the flag is set; a transposed A is stored k x m and a transposed B n x k,
+	//	both read where they lie (packing absorbs the transpose), so no transposed copy is ever made
+	//	The epilogue adds bias (n floats, one per column of C) when given and applies the activation,
+	//		to each tile of C as its last k block is written: C = activation(alpha * op(A) * op(B) + beta * C + bias)
+	static void gemm(bool transA, bool transB, size_t m, size_t n, size_t k, float alpha, const float* A, size_t lda,
+		const float* B, size_t ldb, float beta, float* C, size_t ldc, const float* bias = nullptr,
+		Activation activation = Activation::None);
+	//16 bit storage with float arithmetic, C and bias stay float
+	static void gemm(bool transA, bool transB, size_t m, size_t n, size_t k, float alpha, const BFloat16* A, size_t lda,
+		const BFloat16* B, size_t ldb, float beta, float* C, size_t ldc, const float* bias = nullptr,
+		Activation activation = Activation::None);
+	static void gemm(bool transA, bool transB, size_t m, size_t n, size_t k, float alpha, const Float16* A, size_t lda,
+		const Float16* B, size_t ldb, float beta, float* C, size_t ldc, const float* bias = nullptr,
+		Activation activation = Activation::None);
+	//The original dot product per element of C (B walked by column), kept as a benchmark reference
+	static void gemmNaive(size_t m, size_t n, size_t k, const float* A, size_t lda,
+		const float* B, size_t ldb, float* C, size_t ldc);
+	static void elementwise(ElementOp op, size_t count, const float* A, const float* B, float* C);//C = A op B
+	static void broadcastRow(ElementOp op, size_t rows, size_t columns, const float* A, size_t lda,
+		const float* row, float* C, size_t ldc);//Each row of C = row of A op the row vector
+	static void scalarLeft(ElementOp op, size_t count, float s, const float* A, float* C);//C = s op A
+	static void square(size_t count, const float* A, float* C);
+	static void axpy(size_t count, float a, const float* X, float* Y);//Y += a * X
+	static float sum(size_t count, const float* A);
+	static float dot(size_t count, const float* A, const float* B);
+	static void activate(Activation activation, size_t count, const float* A, float* C);//C = activation(A)
+	static TanHAccuracy getTanHAccuracy();
+	static void setTanHAccuracy(TanHAccuracy accuracy);//Not while kernels run
+	//Strided forms, rows of columns floats each with the given leading dimensions; one flat call when nothing is padded
+	static void elementwise(ElementOp op, size_t rows, size_t columns, const float* A, size_t lda,
+		const float* B, size_t ldb, float* C, size_t ldc);
+	static void scalarLeft(ElementOp op, size_t rows, size_t columns, float s, const float* A, size_t lda, float* C, size_t ldc);
+	static void square(size_t rows, size_t columns, const float* A, size_t lda, float* C, size_t ldc);
+	static void axpy(size_t rows, size_t columns, float a, const float* X, size_t ldx, float* Y, size_t ldy);
+	static float sum(size_t rows, size_t columns, const float* A, size_t lda);
+	static void columnSums(size_t rows, size_t columns, const float* A, size_t lda, float* sums);//sums += each row
+	static void columnSquaredDeviations(size_t rows, size_t columns, const float* A, size_t lda,
+		const float* mean, float* sums);//sums += (each row - mean)^2
+	//Welford, each row folded into every column's running mean and sum of squared deviations (m2) in one read;
+	//	seen is how many rows mean and m2 already hold, so blocks of one matrix can be continued or merged (Chan)
+	static void columnMoments(size_t rows, size_t columns, const float* A, size_t lda, size_t seen, float* mean, float* m2);
+	//B[columns x rows] = A^T, square blocks walked in L1 and each split into tiles (4x4 SSE, 8x8 AVX) transposed in registers
+	static void transpose(size_t rows, size_t columns, const float* A, size_t lda, float* B, size_t ldb);
+	static void transposeSquare(size_t n, float* A, size_t lda);//In place, mirrored tiles swapped through a tile sized buffer
+	//The element by element walk copies used to make, down the columns of A, kept as a benchmark reference
+	static void transposeNaive(size_t rows, size_t columns, const float* A, size_t lda, float* B, size_t ldb);
+	static KernelISA detectISA();//Best instruction set this CPU and OS allow
+	static KernelISA getISA();
+	static void setISA(KernelISA isa);//Clamped to what is supported; for benchmarks, not while kernels run
+	static const char* getISAName(KernelISA isa);
+
+	//One instruction set's implementation of every kernel
+	struct Table
+	{
+		KernelISA isa;
+		size_t mr, nr;
+		void(*microKernel)(size_t kc, float alpha, const float* a, const float* b, float beta,
+			float* C, size_t ldc, size_t mr, size_t nr, const float* bias, Activation activation, TanHAccuracy accuracy);
+		void(*binary[4])(size_t count, const float* A, const float* B, float* C);//Indexed by ElementOp
+		void(*scalarLeft[4])(size_t count, float s, const float* A, float* C);
+		void(*square)(size_t count, const float* A, float* C);
+		void(*axpy)(size_t count, float a, const float* X, float* Y);
+		float(*sum)(size_t count, const float* A);
+		float(*dot)(size_t count, const float* A, const float* B);
+		void(*dot4)(size_t count, const float* A, size_t lda, const float* x, float* out);//out[r] = row r of A . x, r < 4
+		void(*axpy4)(size_t count, const float* a, const float* X, size_t ldx, float* Y);//Y += a[r] * row r of X, r < 4
+		void(*squaredDeviation)(size_t count, const float* A, const float* mean, float* sums);
+		void(*welford)(size_t count, const float* A, float inverseCount, float* mean, float* m2);
+		void(*tanh[3])(size_t count, const float* A, float* C);//Indexed by TanHAccuracy
+		size_t tile;//Square tile transposeTile moves
+		void(*transposeTile)(const float* A, size_t lda, float* B, size_t ldb);
+	};
+private:
+	static const Table& table();
+	static const Table& tableFor(KernelISA isa);
+	static const Table* forced;
+	static TanHAccuracy tanhAccuracy;
+	//Defined in MatrixKernelsSIMD.cpp, unsupported builds (non x86) return the scalar table
+	static const Table& scalarTable();
+	static const Table& sse4Table();
+	static const Table& avx2Table();
+	static const Table& avx512Table();
+	static void gemmSmall(const Table& t, bool transA, bool transB, size_t m, size_t n, size_t k, float alpha,
+		const float* A, size_t lda, const float* B, size_t ldb, float beta, float* C, size_t ldc,
+		const float* bias, Activation activation);
+	//Vector shaped products: n of 1 is matrix times vector, then m of 1 vector times matrix, then k of 1 the outer product; T is the operands' storage, converted a few rows at a time
+	template <typename T>
+	static void gemmVector(const Table& t, bool transA, bool transB, size_t m, size_t n, size_t k, float alpha,
+		const T* A, size_t lda, const T* B, size_t ldb, float beta, float* C, size_t ldc, const float* bias, Activation activation);
+	template <typename T>
+	static void matrixVector(const Table& t, bool transA, size_t m, size_t k, float alpha, const T* A, size_t lda,
+		const float* x, float beta, float* C, size_t ldc, const float* bias, Activation activation);//C column = op(A) x
+	template <typename T>
+	static void vectorMatrix(const Table& t, bool transB, size_t n, size_t k, float alpha, const float* a, const T* B, size_t ldb,
+		float beta, float* C, const float* bias, Activation activation);//C row = a op(B)
+	static void scaleC(const Table& t, size_t m, size_t n, float beta, float* C, size_t ldc, const float* bias,
+		Activation activation);//C = activation(beta * C + bias), what is left of the product when k or alpha is zero
+	//Packed and blocked product, T is the operands' storage, packed as float
+	template <typename T>
+	static void gemmPacked(const Table& t, bool transA, bool transB, size_t m, size_t n, size_t k, float alpha,
+		const T* A, size_t lda, const T* B, size_t ldb, float beta, float* C, size_t ldc, const float* bias, Activation activation);
+	template <typename T>
+	static void packA(bool transA, size_t mc, size_t kc, size_t mr, const T* A, size_t lda, float* packed);
+	template <typename T>
+	static void packB(bool transB, size_t kc, size_t nc, size_t nr, const T* B, size_t ldb, float* packed);
+	static void macroKernel(const Table& t, size_t mc, size_t nc, size_t kc, float alpha, const float* packedA,
+		const float* packedB, float beta, float* C, size_t ldc, const float* bias, Activation activation);
+};
+
+#endif // !__MATRIX_KERNELS__
\ No newline at end of file
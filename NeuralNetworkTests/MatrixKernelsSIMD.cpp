@@ -0,0 +1,386 @@
+/*
+Author: Dan Rehberg
+Modified Date: 10/19/2026
+Notes: No compiler flags are needed for the instruction sets; GCC and Clang get a target attribute per
+		function and MSVC emits any intrinsic as is. Only the table picked at runtime is ever called.
+*/
+#include "MatrixKernels.hpp"
+#include <cstdint>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#else
+#define KERNELS_X86 0
+#endif
+
+#if defined(__GNUC__)
+#define SIMD_UNROLL _Pragma("GCC unroll 16")
+#define KERNEL_TARGET(isa) __attribute__((target(isa)))
+#else
+#define SIMD_UNROLL
+#define KERNEL_TARGET(isa)
+#endif
+
+//Square tiles transposed from A (rows lda apart) into B (rows ldb apart); the SIMD ones never leave registers
+static void transposeTile4x4(const float* A, size_t lda, float* B, size_t ldb)
+{
+	for (size_t i = 0; i < 4; ++i)
+		for (size_t j = 0; j < 4; ++j)B[j * ldb + i] = A[i * lda + j];
+}
+
+#if KERNELS_X86
+KERNEL_TARGET("sse4.1") static void transposeTile4x4SSE(const float* A, size_t lda, float* B, size_t ldb)
+{
+	__m128 r0 = _mm_loadu_ps(A), r1 = _mm_loadu_ps(A + lda), r2 = _mm_loadu_ps(A + 2 * lda), r3 = _mm_loadu_ps(A + 3 * lda);
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+	_mm_storeu_ps(B, r0);
+	_mm_storeu_ps(B + ldb, r1);
+	_mm_storeu_ps(B + 2 * ldb, r2);
+	_mm_storeu_ps(B + 3 * ldb, r3);
+}
+
+//Pairs of rows interleaved, then pairs of pairs, then the 128 bit halves swapped across; also serves AVX-512
+KERNEL_TARGET("avx") static void transposeTile8x8AVX(const float* A, size_t lda, float* B, size_t ldb)
+{
+	__m256 r[8], t[8];
+	for (size_t i = 0; i < 8; ++i)r[i] = _mm256_loadu_ps(A + i * lda);
+	for (size_t i = 0; i < 8; i += 2)
+	{
+		t[i] = _mm256_unpacklo_ps(r[i], r[i + 1]);
+		t[i + 1] = _mm256_unpackhi_ps(r[i], r[i + 1]);
+	}
+	for (size_t i = 0; i < 8; i += 4)
+	{
+		r[i] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(1, 0, 1, 0));
+		r[i + 1] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(3, 2, 3, 2));
+		r[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(1, 0, 1, 0));
+		r[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(3, 2, 3, 2));
+	}
+	for (size_t i = 0; i < 4; ++i)
+	{
+		_mm256_storeu_ps(B + i * ldb, _mm256_permute2f128_ps(r[i], r[i + 4], 0x20));
+		_mm256_storeu_ps(B + (i + 4) * ldb, _mm256_permute2f128_ps(r[i], r[i + 4], 0x31));
+	}
+}
+#endif
+
+//Scalar fallback, a vector of one float
+#define SIMD_ISA KernelISA::Scalar
+#define SIMD_TARGET
+#define SIMD_NAME(x) x##Scalar
+#define SIMD_TYPE float
+#define SIMD_WIDTH 1
+#define SIMD_MR GEMM_MR_SCALAR
+#define SIMD_NRV GEMM_NR_SCALAR
+#define SIMD_LOAD(p) (*(p))
+#define SIMD_STORE(p, v) (*(p) = (v))
+#define SIMD_SET1(x) (x)
+#define SIMD_ZERO() 0.0f
+#define SIMD_ADD(a, b) ((a) + (b))
+#define SIMD_SUB(a, b) ((a) - (b))
+#define SIMD_MUL(a, b) ((a) * (b))
+#define SIMD_DIV(a, b) ((a) / (b))
+#define SIMD_FMADD(a, b, c) ((a) * (b) + (c))
+#define SIMD_MIN(a, b) ((a) < (b) ? (a) : (b))
+#define SIMD_MAX(a, b) ((a) > (b) ? (a) : (b))
+#define SIMD_ABS(a) std::fabs(a)
+#define SIMD_SIGNED(m, x) std::copysign((m), (x))
+#define SIMD_ROUND(a) std::nearbyint(a)
+#define SIMD_POW2(n) std::ldexp(1.0f, static_cast<int>(n))
+#define SIMD_SELECT_LESS(x, l, a, b) ((x) < (l) ? (a) : (b))
+#define SIMD_TILE 4
+#define SIMD_TRANSPOSE_TILE transposeTile4x4
+#include "MatrixKernelsSIMD.inl"
+#undef SIMD_ISA
+#undef SIMD_TARGET
+#undef SIMD_NAME
+#undef SIMD_TYPE
+#undef SIMD_WIDTH
+#undef SIMD_MR
+#undef SIMD_NRV
+#undef SIMD_LOAD
+#undef SIMD_STORE
+#undef SIMD_SET1
+#undef SIMD_ZERO
+#undef SIMD_ADD
+#undef SIMD_SUB
+#undef SIMD_MUL
+#undef SIMD_DIV
+#undef SIMD_FMADD
+#undef SIMD_MIN
+#undef SIMD_MAX
+#undef SIMD_ABS
+#undef SIMD_SIGNED
+#undef SIMD_ROUND
+#undef SIMD_POW2
+#undef SIMD_SELECT_LESS
+#undef SIMD_TILE
+#undef SIMD_TRANSPOSE_TILE
+
+#if KERNELS_X86
+//SSE4.1, no FMA on the older nodes
+#define SIMD_ISA KernelISA::SSE4
+#define SIMD_TARGET KERNEL_TARGET("sse4.1")
+#define SIMD_NAME(x) x##SSE4
+#define SIMD_TYPE __m128
+#define SIMD_WIDTH 4
+#define SIMD_MR GEMM_MR_SSE4
+#define SIMD_NRV (GEMM_NR_SSE4 / 4)
+#define SIMD_LOAD(p) _mm_loadu_ps(p)
+#define SIMD_STORE(p, v) _mm_storeu_ps((p), (v))
+#define SIMD_SET1(x) _mm_set1_ps(x)
+#define SIMD_ZERO() _mm_setzero_ps()
+#define SIMD_ADD(a, b) _mm_add_ps((a), (b))
+#define SIMD_SUB(a, b) _mm_sub_ps((a), (b))
+#define SIMD_MUL(a, b) _mm_mul_ps((a), (b))
+#define SIMD_DIV(a, b) _mm_div_ps((a), (b))
+#define SIMD_FMADD(a, b, c) _mm_add_ps(_mm_mul_ps((a), (b)), (c))
+#define SIMD_MIN(a, b) _mm_min_ps((a), (b))
+#define SIMD_MAX(a, b) _mm_max_ps((a), (b))
+#define SIMD_ABS(a) _mm_andnot_ps(_mm_set1_ps(-0.0f), (a))
+#define SIMD_SIGNED(m, x) _mm_or_ps((m), _mm_and_ps(_mm_set1_ps(-0.0f), (x)))
+#define SIMD_ROUND(a) _mm_round_ps((a), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)
+#define SIMD_POW2(n) _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_cvtps_epi32(n), _mm_set1_epi32(127)), 23))
+#define SIMD_SELECT_LESS(x, l, a, b) _mm_blendv_ps((b), (a), _mm_cmplt_ps((x), (l)))
+#define SIMD_TILE 4
+#define SIMD_TRANSPOSE_TILE transposeTile4x4SSE
+#include "MatrixKernelsSIMD.inl"
+#undef SIMD_ISA
+#undef SIMD_TARGET
+#undef SIMD_NAME
+#undef SIMD_TYPE
+#undef SIMD_WIDTH
+#undef SIMD_MR
+#undef SIMD_NRV
+#undef SIMD_LOAD
+#undef SIMD_STORE
+#undef SIMD_SET1
+#undef SIMD_ZERO
+#undef SIMD_ADD
+#undef SIMD_SUB
+#undef SIMD_MUL
+#undef SIMD_DIV
+#undef SIMD_FMADD
+#undef SIMD_MIN
+#undef SIMD_MAX
+#undef SIMD_ABS
+#undef SIMD_SIGNED
+#undef SIMD_ROUND
+#undef SIMD_POW2
+#undef SIMD_SELECT_LESS
+#undef SIMD_TILE
+#undef SIMD_TRANSPOSE_TILE
+
+//AVX2 with FMA3
+#define SIMD_ISA KernelISA::AVX2
+#define SIMD_TARGET KERNEL_TARGET("avx2,fma")
+#define SIMD_NAME(x) x##AVX2
+#define SIMD_TYPE __m256
+#define SIMD_WIDTH 8
+#define SIMD_MR GEMM_MR_AVX2
+#define SIMD_NRV (GEMM_NR_AVX2 / 8)
+#define SIMD_LOAD(p) _mm256_loadu_ps(p)
+#define SIMD_STORE(p, v) _mm256_storeu_ps((p), (v))
+#define SIMD_SET1(x) _mm256_set1_ps(x)
+#define SIMD_ZERO() _mm256_setzero_ps()
+#define SIMD_ADD(a, b) _mm256_add_ps((a), (b))
+#define SIMD_SUB(a, b) _mm256_sub_ps((a), (b))
+#define SIMD_MUL(a, b) _mm256_mul_ps((a), (b))
+#define SIMD_DIV(a, b) _mm256_div_ps((a), (b))
+#define SIMD_FMADD(a, b, c) _mm256_fmadd_ps((a), (b), (c))
+#define SIMD_MIN(a, b) _mm256_min_ps((a), (b))
+#define SIMD_MAX(a, b) _mm256_max_ps((a), (b))
+#define SIMD_ABS(a) _mm256_andnot_ps(_mm256_set1_ps(-0.0f), (a))
+#define SIMD_SIGNED(m, x) _mm256_or_ps((m), _mm256_and_ps(_mm256_set1_ps(-0.0f), (x)))
+#define SIMD_ROUND(a) _mm256_round_ps((a), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)
+#define SIMD_POW2(n) _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)), 23))
+#define SIMD_SELECT_LESS(x, l, a, b) _mm256_blendv_ps((b), (a), _mm256_cmp_ps((x), (l), _CMP_LT_OQ))
+#define SIMD_TILE 8
+#define SIMD_TRANSPOSE_TILE transposeTile8x8AVX
+#include "MatrixKernelsSIMD.inl"
+#undef SIMD_ISA
+#undef SIMD_TARGET
+#undef SIMD_NAME
+#undef SIMD_TYPE
+#undef SIMD_WIDTH
+#undef SIMD_MR
+#undef SIMD_NRV
+#undef SIMD_LOAD
+#undef SIMD_STORE
+#undef SIMD_SET1
+#undef SIMD_ZERO
+#undef SIMD_ADD
+#undef SIMD_SUB
+#undef SIMD_MUL
+#undef SIMD_DIV
+#undef SIMD_FMADD
+#undef SIMD_MIN
+#undef SIMD_MAX
+#undef SIMD_ABS
+#undef SIMD_SIGNED
+#undef SIMD_ROUND
+#undef SIMD_POW2
+#undef SIMD_SELECT_LESS
+#undef SIMD_TILE
+#undef SIMD_TRANSPOSE_TILE
+
+//AVX-512 foundation
+#define SIMD_ISA KernelISA::AVX512
+#define SIMD_TARGET KERNEL_TARGET("avx512f")
+#define SIMD_NAME(x) x##AVX512
+#define SIMD_TYPE __m512
+#define SIMD_WIDTH 16
+#define SIMD_MR GEMM_MR_AVX512
+#define SIMD_NRV (GEMM_NR_AVX512 / 16)
+#define SIMD_LOAD(p) _mm512_loadu_ps(p)
+#define SIMD_STORE(p, v) _mm512_storeu_ps((p), (v))
+#define SIMD_SET1(x) _mm512_set1_ps(x)
+#define SIMD_ZERO() _mm512_setzero_ps()
+#define SIMD_ADD(a, b) _mm512_add_ps((a), (b))
+#define SIMD_SUB(a, b) _mm512_sub_ps((a), (b))
+#define SIMD_MUL(a, b) _mm512_mul_ps((a), (b))
+#define SIMD_DIV(a, b) _mm512_div_ps((a), (b))
+#define SIMD_FMADD(a, b, c) _mm512_fmadd_ps((a), (b), (c))
+#define SIMD_MIN(a, b) _mm512_min_ps((a), (b))
+#define SIMD_MAX(a, b) _mm512_max_ps((a), (b))
+#define SIMD_ABS(a) _mm512_abs_ps(a)
+#define SIMD_SIGNED(m, x) _mm512_castsi512_ps(_mm512_or_si512(_mm512_castps_si512(m), \
+	_mm512_and_si512(_mm512_castps_si512(x), _mm512_set1_epi32(static_cast<int>(0x80000000u)))))
+#define SIMD_ROUND(a) _mm512_roundscale_ps((a), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)
+#define SIMD_POW2(n) _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_add_epi32(_mm512_cvtps_epi32(n), _mm512_set1_epi32(127)), 23))
+#define SIMD_SELECT_LESS(x, l, a, b) _mm512_mask_blend_ps(_mm512_cmp_ps_mask((x), (l), _CMP_LT_OQ), (b), (a))
+#define SIMD_TILE 8
+#define SIMD_TRANSPOSE_TILE transposeTile8x8AVX
+//GCC 12 flags the undefined pass-through operand inside its own min/max/round/shift intrinsics
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#include "MatrixKernelsSIMD.inl"
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#undef SIMD_ISA
+#undef SIMD_TARGET
+#undef SIMD_NAME
+#undef SIMD_TYPE
+#undef SIMD_WIDTH
+#undef SIMD_MR
+#undef SIMD_NRV
+#undef SIMD_LOAD
+#undef SIMD_STORE
+#undef SIMD_SET1
+#undef SIMD_ZERO
+#undef SIMD_ADD
+#undef SIMD_SUB
+#undef SIMD_MUL
+#undef SIMD_DIV
+#undef SIMD_FMADD
+#undef SIMD_MIN
+#undef SIMD_MAX
+#undef SIMD_ABS
+#undef SIMD_SIGNED
+#undef SIMD_ROUND
+#undef SIMD_POW2
+#undef SIMD_SELECT_LESS
+#undef SIMD_TILE
+#undef SIMD_TRANSPOSE_TILE
+#endif
+
+const MatrixKernels::Table& MatrixKernels::scalarTable()
+{
+	return tableScalar;
+}
+
+#if KERNELS_X86
+const MatrixKernels::Table& MatrixKernels::sse4Table()
+{
+	return tableSSE4;
+}
+
+const MatrixKernels::Table& MatrixKernels::avx2Table()
+{
+	return tableAVX2;
+}
+
+const MatrixKernels::Table& MatrixKernels::avx512Table()
+{
+	return tableAVX512;
+}
+
+static void cpuid(uint32_t leaf, uint32_t subLeaf, uint32_t regs[4])
+{
+#if defined(_MSC_VER)
+	int out[4];
+	__cpuidex(out, static_cast<int>(leaf), static_cast<int>(subLeaf));
+	for (int i = 0; i < 4; ++i)regs[i] = static_cast<uint32_t>(out[i]);
+#else
+	__cpuid_count(leaf, subLeaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+static uint64_t xgetbv0()
+{
+#if defined(_MSC_VER)
+	return _xgetbv(0);
+#else
+	uint32_t low, high;
+	__asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+	return (static_cast<uint64_t>(high) << 32) | low;
+#endif
+}
+
+KernelISA MatrixKernels::detectISA()
+{
+	uint32_t regs[4];
+	cpuid(0, 0, regs);
+	uint32_t maxLeaf = regs[0];
+	cpuid(1, 0, regs);
+	bool sse41 = (regs[2] & (1u << 19)) != 0;
+	bool fma = (regs[2] & (1u << 12)) != 0;
+	bool osxsave = (regs[2] & (1u << 27)) != 0;
+	bool avx = (regs[2] & (1u << 28)) != 0;
+	//The OS must also save the wider registers on a context switch
+	uint64_t xcr0 = osxsave ? xgetbv0() : 0;
+	bool ymmState = (xcr0 & 0x6) == 0x6;
+	bool zmmState = (xcr0 & 0xE6) == 0xE6;
+	bool avx2 = false, avx512f = false;
+	if (maxLeaf >= 7)
+	{
+		cpuid(7, 0, regs);
+		avx2 = (regs[1] & (1u << 5)) != 0;
+		avx512f = (regs[1] & (1u << 16)) != 0;
+	}
+	if (avx512f && zmmState)return KernelISA::AVX512;
+	if (avx2 && fma && avx && ymmState)return KernelISA::AVX2;
+	if (sse41)return KernelISA::SSE4;
+	return KernelISA::Scalar;
+}
+#else
+const MatrixKernels::Table& MatrixKernels::sse4Table()
+{
+	return tableScalar;
+}
+
+const MatrixKernels::Table& MatrixKernels::avx2Table()
+{
+	return tableScalar;
+}
+
+const MatrixKernels::Table& MatrixKernels::avx512Table()
+{
+	return tableScalar;
+}
+
+KernelISA MatrixKernels::detectISA()
+{
+	return KernelISA::Scalar;
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,365 @@
+/*
+Author: Dan Rehberg
+Modified Date: 10/19/2026
+Purpose: Kernel bodies shared by every instruction set. Included by MatrixKernelsSIMD.cpp once per set
+	with the SIMD_ macros describing the vector type, its width, the register tile, and the intrinsics.
+	The scalar fallback is the same source with a "vector" of one float.
+*/
+
+#define SIMD_NR (SIMD_NRV * SIMD_WIDTH)
+
+//tanh at each TanHAccuracy, the vector forms also serve the GEMM epilogue on tiles still in registers
+SIMD_TARGET static inline SIMD_TYPE SIMD_NAME(expVector)(SIMD_TYPE x)
+{
+	//e^x = 2^n * e^r, n = round(x / ln 2) and |r| <= ln 2 / 2 (ln 2 split in two so r is exact); |x| < 87
+	SIMD_TYPE n = SIMD_ROUND(SIMD_MUL(x, SIMD_SET1(1.44269504088896341f)));
+	SIMD_TYPE r = SIMD_FMADD(n, SIMD_SET1(-0.693359375f), x);
+	r = SIMD_FMADD(n, SIMD_SET1(2.12194440e-4f), r);
+	SIMD_TYPE p = SIMD_SET1(1.9875691500e-4f);
+	p = SIMD_FMADD(p, r, SIMD_SET1(1.3981999507e-3f));
+	p = SIMD_FMADD(p, r, SIMD_SET1(8.3334519073e-3f));
+	p = SIMD_FMADD(p, r, SIMD_SET1(4.1665795894e-2f));
+	p = SIMD_FMADD(p, r, SIMD_SET1(1.6666665459e-1f));
+	p = SIMD_FMADD(p, r, SIMD_SET1(5.0000001201e-1f));
+	p = SIMD_FMADD(SIMD_MUL(p, r), r, SIMD_ADD(r, SIMD_SET1(1.0f)));
+	return SIMD_MUL(p, SIMD_POW2(n));
+}
+
+SIMD_TARGET static inline SIMD_TYPE SIMD_NAME(tanhUlpVector)(SIMD_TYPE x)
+{
+	//Odd minimax polynomial up to 1, where 1 - 2 / (e^2|x| + 1) would lose an ulp to the exponential; that form above,
+	//	|x| past 9 is exactly 1 in float so the exponential is capped there. The constant goes on the left of every
+	//	compare: ordered compares are false for NaN, so it takes the polynomial and comes out NaN
+	SIMD_TYPE a = SIMD_ABS(x);
+	SIMD_TYPE z = SIMD_MUL(a, a);
+	SIMD_TYPE p = SIMD_SET1(-3.584520208264e-4f);
+	p = SIMD_FMADD(p, z, SIMD_SET1(2.301364655427e-3f));
+	p = SIMD_FMADD(p, z, SIMD_SET1(-7.946106506871e-3f));
+	p = SIMD_FMADD(p, z, SIMD_SET1(2.148665761839e-2f));
+	p = SIMD_FMADD(p, z, SIMD_SET1(-5.387980272620e-2f));
+	p = SIMD_FMADD(p, z, SIMD_SET1(1.333234457321e-1f));
+	p = SIMD_FMADD(p, z, SIMD_SET1(-3.333329543191e-1f));
+	SIMD_TYPE small = SIMD_FMADD(SIMD_MUL(p, z), a, a);
+	SIMD_TYPE capped = SIMD_MIN(a, SIMD_SET1(9.0f));
+	SIMD_TYPE e = SIMD_NAME(expVector)(SIMD_ADD(capped, capped));
+	SIMD_TYPE large = SIMD_SUB(SIMD_SET1(1.0f), SIMD_DIV(SIMD_SET1(2.0f), SIMD_ADD(e, SIMD_SET1(1.0f))));
+	SIMD_TYPE y = SIMD_SELECT_LESS(SIMD_SET1(1.0f), a, large, small);
+	return SIMD_SIGNED(SIMD_SELECT_LESS(SIMD_SET1(9.0f), a, SIMD_SET1(1.0f), y), x);
+}
+
+SIMD_TARGET static inline SIMD_TYPE SIMD_NAME(tanhFastVector)(SIMD_TYPE x)
+{
+	//Lambert's continued fraction cut to a 7/6 rational, its error peaks near 1e-4 at 4.97 and 1 is as close past there;
+	//	the saturated lanes are selected over whatever the rational gave, NaN fails the compare and keeps the rational's NaN
+	SIMD_TYPE z = SIMD_MUL(x, x);
+	SIMD_TYPE num = SIMD_FMADD(SIMD_FMADD(SIMD_ADD(z, SIMD_SET1(378.0f)), z, SIMD_SET1(17325.0f)), z, SIMD_SET1(135135.0f));
+	SIMD_TYPE den = SIMD_FMADD(SIMD_FMADD(SIMD_FMADD(SIMD_SET1(28.0f), z, SIMD_SET1(3150.0f)), z, SIMD_SET1(62370.0f)), z,
+		SIMD_SET1(135135.0f));
+	SIMD_TYPE y = SIMD_DIV(SIMD_MUL(x, num), den);
+	return SIMD_SELECT_LESS(SIMD_SET1(4.97f), SIMD_ABS(x), SIMD_SIGNED(SIMD_SET1(1.0f), x), y);
+}
+
+SIMD_TARGET static void SIMD_NAME(tanhExact)(size_t count, const float* A, float* C)
+{
+	for (size_t i = 0; i < count; ++i)C[i] = std::tanh(A[i]);
+}
+
+//The tail goes through the vector form too, so every element gets the same approximation
+#define SIMD_TANH(name, VECTOR) \
+SIMD_TARGET static void SIMD_NAME(name)(size_t count, const float* A, float* C) \
+{ \
+	size_t i = 0; \
+	for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH)SIMD_STORE(C + i, VECTOR(SIMD_LOAD(A + i))); \
+	if (i == count)return; \
+	float lanes[SIMD_WIDTH] = {}; \
+	for (size_t j = i; j < count; ++j)lanes[j - i] = A[j]; \
+	SIMD_STORE(lanes, VECTOR(SIMD_LOAD(lanes))); \
+	for (size_t j = i; j < count; ++j)C[j] = lanes[j - i]; \
+}
+SIMD_TANH(tanhUlp, SIMD_NAME(tanhUlpVector))
+SIMD_TANH(tanhFast, SIMD_NAME(tanhFastVector))
+#undef SIMD_TANH
+
+SIMD_TARGET static void SIMD_NAME(tanh)(TanHAccuracy accuracy, size_t count, const float* A, float* C)
+{
+	if (accuracy == TanHAccuracy::Ulp)SIMD_NAME(tanhUlp)(count, A, C);
+	else if (accuracy == TanHAccuracy::Fast)SIMD_NAME(tanhFast)(count, A, C);
+	else SIMD_NAME(tanhExact)(count, A, C);
+}
+
+SIMD_TARGET static void SIMD_NAME(microKernel)(size_t kc, float alpha, const float* a, const float* b, float beta,
+	float* C, size_t ldc, size_t mr, size_t nr, const float* bias, Activation activation, TanHAccuracy accuracy)
+{
+	//MR x NR tile held in registers for the whole k loop; fixed trip counts so the loops unroll away
+	SIMD_TYPE tile[SIMD_MR][SIMD_NRV];
+	SIMD_UNROLL
+	for (size_t i = 0; i < SIMD_MR; ++i)
+	{
+		SIMD_UNROLL
+		for (size_t v = 0; v < SIMD_NRV; ++v)tile[i][v] = SIMD_ZERO();
+	}
+	for (size_t p = 0; p < kc; ++p)
+	{
+		SIMD_TYPE row[SIMD_NRV];
+		SIMD_UNROLL
+		for (size_t v = 0; v < SIMD_NRV; ++v)row[v] = SIMD_LOAD(b + v * SIMD_WIDTH);
+		SIMD_UNROLL
+		for (size_t i = 0; i < SIMD_MR; ++i)
+		{
+			SIMD_TYPE ai = SIMD_SET1(a[i]);
+			SIMD_UNROLL
+			for (size_t v = 0; v < SIMD_NRV; ++v)tile[i][v] = SIMD_FMADD(ai, row[v], tile[i][v]);
+		}
+		a += SIMD_MR;
+		b += SIMD_NR;
+	}
+	SIMD_TYPE va = SIMD_SET1(alpha);
+	if (mr == SIMD_MR && nr == SIMD_NR)
+	{
+		//Epilogue on the registers: scale, accumulate, bias, then the activation on the rows just stored
+		SIMD_UNROLL
+		for (size_t i = 0; i < SIMD_MR; ++i)
+		{
+			SIMD_UNROLL
+			for (size_t v = 0; v < SIMD_NRV; ++v)tile[i][v] = SIMD_MUL(va, tile[i][v]);
+		}
+		if (beta != 0.0f)
+		{
+			SIMD_TYPE vb = SIMD_SET1(beta);
+			SIMD_UNROLL
+			for (size_t i = 0; i < SIMD_MR; ++i)
+			{
+				SIMD_UNROLL
+				for (size_t v = 0; v < SIMD_NRV; ++v)tile[i][v] = SIMD_FMADD(vb, SIMD_LOAD(C + i * ldc + v * SIMD_WIDTH), tile[i][v]);
+			}
+		}
+		if (bias != nullptr)
+		{
+			SIMD_UNROLL
+			for (size_t v = 0; v < SIMD_NRV; ++v)
+			{
+				SIMD_TYPE vbias = SIMD_LOAD(bias + v * SIMD_WIDTH);
+				SIMD_UNROLL
+				for (size_t i = 0; i < SIMD_MR; ++i)tile[i][v] = SIMD_ADD(tile[i][v], vbias);
+			}
+		}
+		bool libm = (activation == Activation::TanH && accuracy == TanHAccuracy::Exact);
+		if (activation == Activation::TanH && !libm)
+		{
+			SIMD_UNROLL
+			for (size_t i = 0; i < SIMD_MR; ++i)
+			{
+				SIMD_UNROLL
+				for (size_t v = 0; v < SIMD_NRV; ++v)tile[i][v] = (accuracy == TanHAccuracy::Fast) ?
+					SIMD_NAME(tanhFastVector)(tile[i][v]) : SIMD_NAME(tanhUlpVector)(tile[i][v]);
+			}
+		}
+		SIMD_UNROLL
+		for (size_t i = 0; i < SIMD_MR; ++i)
+		{
+			SIMD_UNROLL
+			for (size_t v = 0; v < SIMD_NRV; ++v)SIMD_STORE(C + i * ldc + v * SIMD_WIDTH, tile[i][v]);
+			if (libm)SIMD_NAME(tanhExact)(SIMD_NR, C + i * ldc, C + i * ldc);
+		}
+		return;
+	}
+	//Edge tile, only part of it lands in C
+	float out[SIMD_MR][SIMD_NR];
+	for (size_t i = 0; i < SIMD_MR; ++i)
+	{
+		for (size_t v = 0; v < SIMD_NRV; ++v)SIMD_STORE(&out[i][v * SIMD_WIDTH], SIMD_MUL(va, tile[i][v]));
+	}
+	for (size_t i = 0; i < mr; ++i)
+	{
+		float* c = C + i * ldc;
+		if (beta == 0.0f)
+		{
+			for (size_t j = 0; j < nr; ++j)c[j] = out[i][j];
+		}
+		else
+		{
+			for (size_t j = 0; j < nr; ++j)c[j] = out[i][j] + beta * c[j];
+		}
+		if (bias != nullptr)
+		{
+			for (size_t j = 0; j < nr; ++j)c[j] += bias[j];
+		}
+		if (activation == Activation::TanH)SIMD_NAME(tanh)(accuracy, nr, c, c);
+	}
+}
+
+#define SIMD_BINARY(name, VOP, SOP) \
+SIMD_TARGET static void SIMD_NAME(name)(size_t count, const float* A, const float* B, float* C) \
+{ \
+	size_t i = 0; \
+	for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH)SIMD_STORE(C + i, VOP(SIMD_LOAD(A + i), SIMD_LOAD(B + i))); \
+	for (; i < count; ++i)C[i] = A[i] SOP B[i]; \
+}
+SIMD_BINARY(add, SIMD_ADD, +)
+SIMD_BINARY(subtract, SIMD_SUB, -)
+SIMD_BINARY(multiply, SIMD_MUL, *)
+SIMD_BINARY(divide, SIMD_DIV, /)
+#undef SIMD_BINARY
+
+#define SIMD_SCALAR_LEFT(name, VOP, SOP) \
+SIMD_TARGET static void SIMD_NAME(name)(size_t count, float s, const float* A, float* C) \
+{ \
+	SIMD_TYPE vs = SIMD_SET1(s); \
+	size_t i = 0; \
+	for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH)SIMD_STORE(C + i, VOP(vs, SIMD_LOAD(A + i))); \
+	for (; i < count; ++i)C[i] = s SOP A[i]; \
+}
+SIMD_SCALAR_LEFT(scalarAdd, SIMD_ADD, +)
+SIMD_SCALAR_LEFT(scalarSubtract, SIMD_SUB, -)
+SIMD_SCALAR_LEFT(scalarMultiply, SIMD_MUL, *)
+SIMD_SCALAR_LEFT(scalarDivide, SIMD_DIV, /)
+#undef SIMD_SCALAR_LEFT
+
+SIMD_TARGET static void SIMD_NAME(square)(size_t count, const float* A, float* C)
+{
+	size_t i = 0;
+	for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH)
+	{
+		SIMD_TYPE x = SIMD_LOAD(A + i);
+		SIMD_STORE(C + i, SIMD_MUL(x, x));
+	}
+	for (; i < count; ++i)C[i] = A[i] * A[i];
+}
+
+SIMD_TARGET static void SIMD_NAME(axpy)(size_t count, float a, const float* X, float* Y)
+{
+	SIMD_TYPE va = SIMD_SET1(a);
+	size_t i = 0;
+	for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH)SIMD_STORE(Y + i, SIMD_FMADD(va, SIMD_LOAD(X + i), SIMD_LOAD(Y + i)));
+	for (; i < count; ++i)Y[i] += a * X[i];
+}
+
+SIMD_TARGET static float SIMD_NAME(sum)(size_t count, const float* A)
+{
+	//Two accumulators to hide the add latency
+	SIMD_TYPE s0 = SIMD_ZERO(), s1 = SIMD_ZERO();
+	size_t i = 0;
+	for (; i + 2 * SIMD_WIDTH <= count; i += 2 * SIMD_WIDTH)
+	{
+		s0 = SIMD_ADD(s0, SIMD_LOAD(A + i));
+		s1 = SIMD_ADD(s1, SIMD_LOAD(A + i + SIMD_WIDTH));
+	}
+	for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH)s0 = SIMD_ADD(s0, SIMD_LOAD(A + i));
+	float lanes[SIMD_WIDTH];
+	SIMD_STORE(lanes, SIMD_ADD(s0, s1));
+	float total = 0.0f;
+	for (size_t j = 0; j < SIMD_WIDTH; ++j)total += lanes[j];
+	for (; i < count; ++i)total += A[i];
+	return total;
+}
+
+SIMD_TARGET static float SIMD_NAME(dot)(size_t count, const float* A, const float* B)
+{
+	SIMD_TYPE s0 = SIMD_ZERO(), s1 = SIMD_ZERO();
+	size_t i = 0;
+	for (; i + 2 * SIMD_WIDTH <= count; i += 2 * SIMD_WIDTH)
+	{
+		s0 = SIMD_FMADD(SIMD_LOAD(A + i), SIMD_LOAD(B + i), s0);
+		s1 = SIMD_FMADD(SIMD_LOAD(A + i + SIMD_WIDTH), SIMD_LOAD(B + i + SIMD_WIDTH), s1);
+	}
+	for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH)s0 = SIMD_FMADD(SIMD_LOAD(A + i), SIMD_LOAD(B + i), s0);
+	float lanes[SIMD_WIDTH];
+	SIMD_STORE(lanes, SIMD_ADD(s0, s1));
+	float total = 0.0f;
+	for (size_t j = 0; j < SIMD_WIDTH; ++j)total += lanes[j];
+	for (; i < count; ++i)total += A[i] * B[i];
+	return total;
+}
+
+//Dot products of four rows of A (lda apart) with x, each load of x serving all four
+SIMD_TARGET static void SIMD_NAME(dot4)(size_t count, const float* A, size_t lda, const float* x, float* out)
+{
+	const float* a0 = A, * a1 = A + lda, * a2 = A + 2 * lda, * a3 = A + 3 * lda;
+	SIMD_TYPE s0 = SIMD_ZERO(), s1 = SIMD_ZERO(), s2 = SIMD_ZERO(), s3 = SIMD_ZERO();
+	size_t i = 0;
+	for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH)
+	{
+		SIMD_TYPE v = SIMD_LOAD(x + i);
+		s0 = SIMD_FMADD(SIMD_LOAD(a0 + i), v, s0);
+		s1 = SIMD_FMADD(SIMD_LOAD(a1 + i), v, s1);
+		s2 = SIMD_FMADD(SIMD_LOAD(a2 + i), v, s2);
+		s3 = SIMD_FMADD(SIMD_LOAD(a3 + i), v, s3);
+	}
+	float lanes[4][SIMD_WIDTH];
+	SIMD_STORE(lanes[0], s0);
+	SIMD_STORE(lanes[1], s1);
+	SIMD_STORE(lanes[2], s2);
+	SIMD_STORE(lanes[3], s3);
+	for (size_t r = 0; r < 4; ++r)
+	{
+		float total = 0.0f;
+		for (size_t j = 0; j < SIMD_WIDTH; ++j)total += lanes[r][j];
+		for (size_t j = i; j < count; ++j)total += A[r * lda + j] * x[j];
+		out[r] = total;
+	}
+}
+
+//Y += a[0] * X0 + a[1] * X1 + a[2] * X2 + a[3] * X3 for four rows of X (ldx apart), Y read and written once for all four
+SIMD_TARGET static void SIMD_NAME(axpy4)(size_t count, const float* a, const float* X, size_t ldx, float* Y)
+{
+	const float* x0 = X, * x1 = X + ldx, * x2 = X + 2 * ldx, * x3 = X + 3 * ldx;
+	SIMD_TYPE v0 = SIMD_SET1(a[0]), v1 = SIMD_SET1(a[1]), v2 = SIMD_SET1(a[2]), v3 = SIMD_SET1(a[3]);
+	size_t i = 0;
+	for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH)
+	{
+		SIMD_TYPE y = SIMD_FMADD(v0, SIMD_LOAD(x0 + i), SIMD_LOAD(Y + i));
+		y = SIMD_FMADD(v1, SIMD_LOAD(x1 + i), y);
+		y = SIMD_FMADD(v2, SIMD_LOAD(x2 + i), y);
+		SIMD_STORE(Y + i, SIMD_FMADD(v3, SIMD_LOAD(x3 + i), y));
+	}
+	for (; i < count; ++i)Y[i] += a[0] * x0[i] + a[1] * x1[i] + a[2] * x2[i] + a[3] * x3[i];
+}
+
+SIMD_TARGET static void SIMD_NAME(squaredDeviation)(size_t count, const float* A, const float* mean, float* sums)
+{
+	size_t i = 0;
+	for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH)
+	{
+		SIMD_TYPE d = SIMD_SUB(SIMD_LOAD(A + i), SIMD_LOAD(mean + i));
+		SIMD_STORE(sums + i, SIMD_FMADD(d, d, SIMD_LOAD(sums + i)));
+	}
+	for (; i < count; ++i)
+	{
+		float d = A[i] - mean[i];
+		sums[i] += d * d;
+	}
+}
+
+//Welford step with one more row, inverseCount is 1 / (rows seen including this one)
+SIMD_TARGET static void SIMD_NAME(welford)(size_t count, const float* A, float inverseCount, float* mean, float* m2)
+{
+	size_t i = 0;
+	SIMD_TYPE inv = SIMD_SET1(inverseCount);
+	for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH)
+	{
+		SIMD_TYPE a = SIMD_LOAD(A + i);
+		SIMD_TYPE d = SIMD_SUB(a, SIMD_LOAD(mean + i));
+		SIMD_TYPE m = SIMD_FMADD(d, inv, SIMD_LOAD(mean + i));
+		SIMD_STORE(mean + i, m);
+		SIMD_STORE(m2 + i, SIMD_FMADD(d, SIMD_SUB(a, m), SIMD_LOAD(m2 + i)));
+	}
+	for (; i < count; ++i)
+	{
+		float d = A[i] - mean[i];
+		mean[i] += d * inverseCount;
+		m2[i] += d * (A[i] - mean[i]);
+	}
+}
+
+static const MatrixKernels::Table SIMD_NAME(table) =
+{
+	SIMD_ISA, SIMD_MR, SIMD_NR, &SIMD_NAME(microKernel),
+	{ &SIMD_NAME(add), &SIMD_NAME(subtract), &SIMD_NAME(multiply), &SIMD_NAME(divide) },
+	{ &SIMD_NAME(scalarAdd), &SIMD_NAME(scalarSubtract), &SIMD_NAME(scalarMultiply), &SIMD_NAME(scalarDivide) },
+	&SIMD_NAME(square), &SIMD_NAME(axpy), &SIMD_NAME(sum), &SIMD_NAME(dot), &SIMD_NAME(dot4), &SIMD_NAME(axpy4),
+	&SIMD_NAME(squaredDeviation), &SIMD_NAME(welford),
+	{ &SIMD_NAME(tanhExact), &SIMD_NAME(tanhUlp), &SIMD_NAME(tanhFast) },
+	SIMD_TILE, &SIMD_TRANSPOSE_TILE
+};
+
+#undef SIMD_NR
\ No newline at end of file
@@ -0,0 +1,114 @@
+/*
+Author: Dan Rehberg
+Modified Date: 10/19/2026
+Purpose: Element types a matrix can be stored in, and the type its arithmetic is carried out in.
+	float and double are their own accumulators.
+	BFloat16 (8 bit exponent, 7 bit mantissa) and Float16 (IEEE half, 5 bit exponent, 10 bit mantissa) are storage only:
+		half the bytes of a float per element, converted to float to be worked on and rounded (to nearest even) on store.
+	BFloat16 keeps float's range, so weights and activations fit as they are; Float16 keeps 3 more mantissa bits,
+		but overflows past 65504 and loses precision below 6.1e-5.
+	MatrixLayout is the order a matrix stores its elements in, rows one after another or columns one after another.
+*/
+
+#ifndef __MATRIX_TYPES__
+#define __MATRIX_TYPES__
+
+#include <cstdint>
+#include <cstring>
+
+class MatrixBits final
+{
+public:
+	MatrixBits() = delete;
+	static uint32_t fromFloat(float value)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+	static float toFloat(uint32_t bits)
+	{
+		float value;
+		std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+};
+
+struct BFloat16
+{
+	uint16_t bits;
+	BFloat16() = default;//Trivial, so buffers of it are as cheap to allocate as floats
+	explicit BFloat16(float value) : bits(round(MatrixBits::fromFloat(value))) {}
+	operator float() const { return MatrixBits::toFloat(static_cast<uint32_t>(bits) << 16); }
+	static uint16_t round(uint32_t u)
+	{
+		//NaN stays a (quiet) NaN, everything else drops the low 16 bits rounded to nearest even
+		if ((u & 0x7FFFFFFFu) > 0x7F800000u)return static_cast<uint16_t>((u >> 16) | 0x0040u);
+		return static_cast<uint16_t>((u + 0x7FFFu + ((u >> 16) & 1u)) >> 16);
+	}
+};
+
+struct Float16
+{
+	uint16_t bits;
+	Float16() = default;
+	explicit Float16(float value) : bits(round(MatrixBits::fromFloat(value))) {}
+	operator float() const
+	{
+		//Exponent rebiased from 15 to 127, subnormal halves renormalized through a float subtraction
+		uint32_t u = (static_cast<uint32_t>(bits) & 0x7FFFu) << 13;
+		uint32_t exponent = u & (0x7C00u << 13);
+		u += (127u - 15u) << 23;
+		if (exponent == (0x7C00u << 13))u += (128u - 16u) << 23;//Inf or NaN
+		else if (exponent == 0)
+		{
+			u += 1u << 23;
+			u = MatrixBits::fromFloat(MatrixBits::toFloat(u) - MatrixBits::toFloat(113u << 23));
+		}
+		return MatrixBits::toFloat(u | ((static_cast<uint32_t>(bits) & 0x8000u) << 16));
+	}
+	static uint16_t round(uint32_t u)
+	{
+		uint32_t sign = u & 0x80000000u;
+		u ^= sign;
+		uint16_t half;
+		if (u >= (143u << 23))half = (u > 0x7F800000u) ? 0x7E00u : 0x7C00u;//Past 65520 is Inf, NaN stays NaN
+		else if (u < (113u << 23))
+		{
+			//Subnormal or zero, adding 0.5 lines the half's mantissa up with the float's and the FPU rounds it
+			uint32_t magic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+			half = static_cast<uint16_t>(MatrixBits::fromFloat(MatrixBits::toFloat(u) + MatrixBits::toFloat(magic)) - magic);
+		}
+		else
+		{
+			uint32_t odd = (u >> 13) & 1u;
+			u += ((15u - 127u) << 23) + 0xFFFu + odd;
+			half = static_cast<uint16_t>(u >> 13);
+		}
+		return static_cast<uint16_t>(half | (sign >> 16));
+	}
+};
+
+//Arithmetic type for a storage type; the 16 bit types accumulate in float
+template <typename T>
+struct MatrixAccumulator
+{
+	typedef T type;
+};
+
+template <>
+struct MatrixAccumulator<BFloat16>
+{
+	typedef float type;
+};
+
+template <>
+struct MatrixAccumulator<Float16>
+{
+	typedef float type;
+};
+
+//Row major keeps each row contiguous (rows stride apart), column major each column (columns stride apart)
+enum class MatrixLayout { RowMajor, ColumnMajor };
+
+#endif // !__MATRIX_TYPES__
\ No newline at end of file
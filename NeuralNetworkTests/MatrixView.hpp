@@ -0,0 +1,86 @@
+/*
+Author: Dan Rehberg
+Modified Date: 10/19/2026
+Purpose: Non-owning, read only window onto matrix storage: a pointer, the rows and columns seen through it,
+	the stride between stored rows, and whether the storage is read transposed.
+	Slicing rows, columns, or a sub-block, and transposing, only move the pointer and swap the sizes, nothing is copied;
+		e.g., W.view().rowSlice(1, rows) is the weights without their bias row, X.view().rowSlice(b, e) a mini-batch.
+	Products and reductions on SerialMatrix take views, and a view is an expression leaf, so it can be used in
+		elementwise arithmetic or copied out with SerialMatrix(view).
+	BasicMatrixView<T, Acc> views a BasicSerialMatrix<T, Acc>, reading elements as Acc; MatrixView is the float one.
+	A view does not keep its matrix alive and is invalidated when that matrix is reallocated (resize, assignment).
+	A transposed or shifted view of a matrix assigned back into that same matrix is evaluated into a new buffer (see readsAcross).
+*/
+
+#ifndef __MATRIX_VIEW__
+#define __MATRIX_VIEW__
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "MatrixExpressions.hpp"
+
+template <typename T, typename Acc = typename MatrixAccumulator<T>::type>
+class BasicMatrixView : public MatrixExpression<BasicMatrixView<T, Acc>>
+{
+public:
+	typedef Acc Value;
+	typedef BasicSerialMatrix<T, Acc> Result;
+	BasicMatrixView() : data(nullptr), rows(0), columns(0), stride(0), transposed(false) {}
+	BasicMatrixView(const T* values, size_t rowCount, size_t columnCount, size_t rowStride, bool transpose = false) :
+		data(values), rows(rowCount), columns(columnCount), stride(rowStride), transposed(transpose) {}
+
+	const T* getData() const { return data; }//First stored element, (0, 0) of the view
+	size_t getStride() const { return stride; }
+	bool isTransposed() const { return transposed; }
+	std::pair<size_t, size_t> getDimensions() const { return std::pair<size_t, size_t>(rows, columns); }
+	size_t getCapacity() const { return rows * columns; }
+	const T* address(size_t row, size_t column) const
+	{
+		return transposed ? data + column * stride + row : data + row * stride + column;
+	}
+	Acc at(size_t row, size_t column) const { return static_cast<Acc>(*address(row, column)); }
+	Acc get(size_t row, size_t column) const { return at(row, column); }//Expression leaf, a view reads as it is seen
+	bool contiguous() const { return !transposed && stride == columns; }
+	unsigned int leaves() const { return LeafView; }
+
+	BasicMatrixView transpose() const
+	{
+		return BasicMatrixView(data, columns, rows, stride, !transposed);
+	}
+	BasicMatrixView block(size_t row, size_t column, size_t rowCount, size_t columnCount) const
+	{
+		if (row + rowCount > rows || column + columnCount > columns || rowCount * columnCount == 0)
+			throw std::range_error(R"(View block must be non empty and inside the view: view has dimensions: )" +
+				std::to_string(rows) + ", " + std::to_string(columns) + " block starts at: " + std::to_string(row) + ", " +
+				std::to_string(column) + " with dimensions: " + std::to_string(rowCount) + ", " + std::to_string(columnCount));
+		return BasicMatrixView(address(row, column), rowCount, columnCount, stride, transposed);
+	}
+	BasicMatrixView rowSlice(size_t begin, size_t end) const//Rows [begin, end)
+	{
+		return block(begin, 0, end > begin ? end - begin : 0, columns);
+	}
+	BasicMatrixView columnSlice(size_t begin, size_t end) const//Columns [begin, end)
+	{
+		return block(0, begin, rows, end > begin ? end - begin : 0);
+	}
+private:
+	const T* data;
+	size_t rows, columns;//as seen through the view, after the transpose
+	size_t stride;//between stored rows
+	bool transposed;
+};
+
+//Only the same walk of the same storage is safe: no offset, transpose, other stride, or broadcast of fewer rows
+template <typename T, typename Acc>
+bool readsAcross(const BasicMatrixView<T, Acc>& e, const ExpressionTarget& out)
+{
+	if (!out.holds(e.getData()))return false;
+	return e.getData() != out.begin || e.isTransposed() != out.columnMajor || e.getStride() != out.stride ||
+		e.getDimensions() != out.dimensions;
+}
+
+typedef BasicMatrixView<float> MatrixView;
+
+#endif // !__MATRIX_VIEW__
\ No newline at end of file
@@ -1,6 +1,6 @@
 /*
 Author: Dan Rehberg
-Modified Date: 12/9/2022
+Modified Date: 10/19/2026
 */
 #include "NeuralNetwork.hpp"
 
@@ -26,7 +26,9 @@ NeuralNetwork::NeuralNetwork(const size_t inputCount, const std::vector<size_t>&
 
 	//Build the weights
 	weights.resize(hiddenCount.size() + 1);
-	Z.resize(weights.size() + 1);
+	Z.resize(weights.size());
+	grads.resize(weights.size());
+	deltas.resize(weights.size());
 	//	But, also go ahead and size them appropriately
 	size_t rowCount = inputCount + 1;
 	for (size_t i = 0; i < hiddenCount.size(); ++i)
@@ -112,23 +114,24 @@ std::string NeuralNetwork::getInfo() const
 void NeuralNetwork::train(Matrix X, Matrix T, const size_t epochs, float learningRate)
 {
 	epoch += epochs;
-	xMean = Matrix::mean(X, false);
-	xStd = Matrix::standardDeviations(X, false);
-	tMean = Matrix::mean(T, false);
-	tStd = Matrix::standardDeviations(T, false);
+	sparseWeights.clear();//Pruned from weights that are about to change
+	Matrix::statistics(xMean, xStd, X, false);//One read of each
+	Matrix::statistics(tMean, tStd, T, false);
 
 	//Standardize
 	X = (X - xMean) / xStd;
 	T = (T - tMean) / tStd;
 	//Train
 	learningRate /= X.getDimensions().first * T.getDimensions().second;
+	//Every buffer below keeps its size from epoch to epoch, so after the first nothing is allocated
+	error.reserve(error.size() + epochs);
 	for (size_t i = 0; i < epochs; ++i)
 	{
-		Matrix Y = forward(X);
-		std::vector<Matrix> grads = std::move(gradients(T));
+		const Matrix& Y = forward(X);
+		gradients(T);
 		for (int j = 0; j < weights.size(); ++j)
 		{
-			weights[j] += learningRate * grads[(grads.size() - j) - 1];
+			weights[j] += learningRate * grads[j];
 		}
 
 		error.push_back(rmse(T, Y));
@@ -143,44 +146,64 @@ Matrix NeuralNetwork::use(Matrix X)
 	return (Y * tStd) + tMean;
 }
 
-float NeuralNetwork::rmse(const Matrix& T, const Matrix& Y) const
+void NeuralNetwork::prune(float sparsity)
 {
-	Matrix diff = (T - Y) * tStd;
-	return std::sqrt(Matrix::mean(Matrix::square(diff)));
+	if (epoch == 0)throw std::logic_error("Cannot prune the Neural Network without training");
+	sparseWeights.clear();
+	sparseWeights.reserve(weights.size());
+	for (const Matrix& W : weights)
+	{
+		//The threshold is taken over the weights below the bias row, which is kept whole
+		float threshold = SparseMatrix::pruningThreshold(W.view().rowSlice(1, W.getDimensions().first), sparsity);
+		sparseWeights.push_back(SparseMatrix(W, SparseFormat::CSR, threshold, 1));
+	}
+}
+
+float NeuralNetwork::rmse(const Matrix& T, const Matrix& Y)
+{
+	diff = T - Y;
+	Matrix::gemm(scaledDiff, diff, tStd);
+	return std::sqrt(Matrix::mean(Matrix::square(scaledDiff)));
 }
 
-Matrix& NeuralNetwork::forward(const Matrix& X)
+Matrix& NeuralNetwork::forward(const MatrixView& X)
 {
-	Z[0] = X;
-	for (size_t i = 0; i < weights.size() - 1; ++i)
+	inputs = X;
+	for (size_t i = 0; i < weights.size(); ++i)
 	{
-		Matrix result(std::move(Matrix::addOnes(Z[i]) * weights[i]));
-		result.activateTanH();
-		Z[i + 1] = std::move(result);//Would need to compare std move performance knowing a delete is involved..
+		//Written into the existing activations, bias and tanh (all but the output) applied as each row or tile is written
+		Activation activation = i + 1 < weights.size() ? Activation::TanH : Activation::None;
+		if (sparseWeights.empty())Matrix::addOnesMultiply(Z[i], layerInput(i), weights[i], activation);
+		else SparseMatrix::multiply(Z[i], layerInput(i), sparseWeights[i], true, activation);
 	}
-	Z.back() = std::move(Matrix::addOnes(Z[Z.size() - 2]) * weights.back());
 	return Z.back();
 }
 
-std::vector<Matrix> NeuralNetwork::gradients(const Matrix& T) const
+void NeuralNetwork::gradients(const Matrix& T)
 {
 	//Reverse order for backpropagation (order of dependecies)
-	std::vector<Matrix> grads(weights.size());
 	//The reverse order is based on the weight count, and aligns with
 	//	the indices of the Z matrices
-	//	Notably, ||Z|| === ||W|| + 1
-	//		but the first [0, ||W||) elements are aligned
+	//	Notably, ||Z|| === ||W||, Z[i] is the output of W[i]
+	//		and its input is layerInput(i), X or Z[i - 1]
 	//	Therefore, can just reverse iterate over W's indices
-	//		and reuse both for W[i] and Z[i]
-	Matrix delta = std::move(T - Z.back());
+	//		and reuse them for W[i], Z[i], and deltas[i]
+	deltas.back() = T - Z.back();
 	for (int i = static_cast<int>(weights.size()) - 1; i >= 0; --i)
 	{
-		Matrix dW = std::move(Matrix::transpose((Matrix::addOnes(Z[i]))) * delta);
-		grads.emplace_back(std::move(dW));
-		delta = std::move(Matrix::componentwise((delta * Matrix::transpose(weights[i], 1)),
-			(1.0f - Matrix::square(Z[i]))));
+		//Transposes are folded into the products rather than copied out
+		Matrix::addOnesTransposeMultiply(grads[i], layerInput(i), deltas[i]);
+		if (i == 0)break;//No layer below the input to pass the error to
+		//The bias row passes no error down, it is sliced off rather than copied around
+		const Matrix& W = weights[i];
+		Matrix::gemm(deltas[i - 1], deltas[i], W.view().rowSlice(1, W.getDimensions().first).transpose());
+		deltas[i - 1] = Matrix::componentwise(deltas[i - 1], 1.0f - Matrix::square(Z[i - 1]));
 	}
-	return grads;
+}
+
+MatrixView NeuralNetwork::layerInput(size_t i) const
+{
+	return i == 0 ? inputs : Z[i - 1].view();
 }
 
 std::ostream& operator<<(std::ostream& out, const NeuralNetwork& mat)
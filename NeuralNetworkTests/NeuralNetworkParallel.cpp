@@ -1,11 +1,9 @@
 /*
 Author: Dan Rehberg
-Modified Date: 12/9/2022
+Modified Date: 10/19/2026
 */
 #include "NeuralNetworkParallel.hpp"
 
-Matrix NeuralNetworkParallel::tempM = Matrix(1, 1);
-
 NeuralNetworkParallel::NeuralNetworkParallel() : xMean(1, 1), tMean(1, 1), 
 												 xStd(1, 1), tStd(1, 1), 
 												 pool(2)
@@ -15,8 +13,28 @@ NeuralNetworkParallel::NeuralNetworkParallel() : xMean(1, 1), tMean(1, 1),
 	epoch = 0;
 }
 
+NeuralNetworkParallel::NeuralNetworkParallel(const LowJitterSettings& settings) : xMean(1, 1), xStd(1, 1),
+	tMean(1, 1), tStd(1, 1), pool(2, settings)
+{
+	input = 0;
+	output = 0;
+	epoch = 0;
+}
+
 NeuralNetworkParallel::NeuralNetworkParallel(const size_t inputCount, const std::vector<size_t>& hiddenCount,
 	const size_t outputCount) : NeuralNetworkParallel()
+{
+	buildWeights(inputCount, hiddenCount, outputCount);
+}
+
+NeuralNetworkParallel::NeuralNetworkParallel(const size_t inputCount, const std::vector<size_t>& hiddenCount,
+	const size_t outputCount, const LowJitterSettings& settings) : NeuralNetworkParallel(settings)
+{
+	buildWeights(inputCount, hiddenCount, outputCount);
+}
+
+void NeuralNetworkParallel::buildWeights(const size_t inputCount, const std::vector<size_t>& hiddenCount,
+	const size_t outputCount)
 {
 	input = inputCount;
 	hidden.reserve(hiddenCount.size());
@@ -30,7 +48,9 @@ NeuralNetworkParallel::NeuralNetworkParallel(const size_t inputCount, const std:
 
 	//Build the weights
 	weights.resize(hiddenCount.size() + 1);
-	Z.resize(weights.size() + 1);
+	Z.resize(weights.size());
+	grads.resize(weights.size());
+	deltas.resize(weights.size());
 	//	But, also go ahead and size them appropriately
 	size_t rowCount = inputCount + 1;
 	for (size_t i = 0; i < hiddenCount.size(); ++i)
@@ -53,6 +73,29 @@ NeuralNetworkParallel::~NeuralNetworkParallel()
 	//Seems reasonable for vector in this case (no need for the low-level control)
 }
 
+void NeuralNetworkParallel::prefaultBuffers()
+{
+	//Whole buffers, padding included
+	for (auto itr = weights.begin(); itr != weights.end(); ++itr)
+	{
+		pool.prefault(itr->getData(), itr->getDimensions().first * itr->getStride() * sizeof(float));
+	}
+	for (auto itr = Z.begin(); itr != Z.end(); ++itr)
+	{
+		pool.prefault(itr->getData(), itr->getDimensions().first * itr->getStride() * sizeof(float));
+	}
+	for (size_t i = 0; i < grads.size(); ++i)
+	{
+		pool.prefault(grads[i].getData(), grads[i].getDimensions().first * grads[i].getStride() * sizeof(float));
+		pool.prefault(deltas[i].getData(), deltas[i].getDimensions().first * deltas[i].getStride() * sizeof(float));
+	}
+}
+
+const std::vector<std::string>& NeuralNetworkParallel::getDeniedSettings() const
+{
+	return pool.getDeniedSettings();
+}
+
 void NeuralNetworkParallel::testWeights()
 {
 	float min = -0.01f, max = 0.01f;
@@ -116,23 +159,27 @@ std::string NeuralNetworkParallel::getInfo() const
 void NeuralNetworkParallel::train(Matrix X, Matrix T, const size_t epochs, float learningRate)
 {
 	epoch += epochs;
-	xMean = Matrix::mean(X, false);
-	xStd = Matrix::standardDeviations(X, false);
-	tMean = Matrix::mean(T, false);
-	tStd = Matrix::standardDeviations(T, false);
-
-	//Standardize
-	X = (X - xMean) / xStd;
-	T = (T - tMean) / tStd;
+	sparseWeights.clear();//Pruned from weights that are about to change
+	//One read of each, Welford blocks on the pool
+	pool.dispatch(Matrix::setParallelStatisticsOps(X, false), &Matrix::parallelStatisticsRange);
+	Matrix::mergeParallelStatistics(xMean, xStd);
+	pool.dispatch(Matrix::setParallelStatisticsOps(T, false), &Matrix::parallelStatisticsRange);
+	Matrix::mergeParallelStatistics(tMean, tStd);
+
+	//Standardize, rows per thread in place
+	pool.dispatch(Matrix::setParallelExpressionOps(X, (X - xMean) / xStd), &Matrix::parallelRange);
+	pool.dispatch(Matrix::setParallelExpressionOps(T, (T - tMean) / tStd), &Matrix::parallelRange);
 	//Train
 	learningRate /= X.getDimensions().first * T.getDimensions().second;
+	//Every buffer below keeps its size from epoch to epoch, so after the first nothing is allocated
+	error.reserve(error.size() + epochs);
 	for (size_t i = 0; i < epochs; ++i)
 	{
-		Matrix Y = forward(X);
-		std::vector<Matrix> grads = std::move(gradients(T));
+		const Matrix& Y = forward(X);
+		gradients(T);
 		for (int j = 0; j < weights.size(); ++j)
 		{
-			weights[j] += learningRate * grads[(grads.size() - j) - 1];
+			pool.dispatch(Matrix::setParallelExpressionOps(weights[j], weights[j] + learningRate * grads[j]), &Matrix::parallelRange);
 		}
 
 		error.push_back(rmse(T, Y));
@@ -142,65 +189,75 @@ void NeuralNetworkParallel::train(Matrix X, Matrix T, const size_t epochs, float
 Matrix NeuralNetworkParallel::use(Matrix X)
 {
 	if (epoch == 0)throw std::exception("Cannot use the Neural Network without training");
-	X = (X - xMean) / xStd;
+	pool.dispatch(Matrix::setParallelExpressionOps(X, (X - xMean) / xStd), &Matrix::parallelRange);
 	Matrix Y = forward(X);
 	return (Y * tStd) + tMean;
 }
 
-float NeuralNetworkParallel::rmse(const Matrix& T, const Matrix& Y) const
+void NeuralNetworkParallel::prune(float sparsity)
 {
-	Matrix diff = (T - Y) * tStd;
-	return std::sqrt(Matrix::mean(Matrix::square(diff)));
+	if (epoch == 0)throw std::logic_error("Cannot prune the Neural Network without training");
+	sparseWeights.clear();
+	sparseWeights.reserve(weights.size());
+	for (const Matrix& W : weights)
+	{
+		//The threshold is taken over the weights below the bias row, which is kept whole
+		float threshold = SparseMatrix::pruningThreshold(W.view().rowSlice(1, W.getDimensions().first), sparsity);
+		sparseWeights.push_back(SparseMatrix(W, SparseFormat::CSR, threshold, 1));
+	}
+}
+
+float NeuralNetworkParallel::rmse(const Matrix& T, const Matrix& Y)
+{
+	pool.dispatch(Matrix::setParallelExpressionOps(diff, T - Y), &Matrix::parallelRange);
+	Matrix::gemm(scaledDiff, diff, tStd);
+	pool.dispatch(Matrix::setParallelSumOps(Matrix::square(scaledDiff)), &Matrix::parallelRange);
+	return std::sqrt(Matrix::getParallelSum() / scaledDiff.getCapacity());
 }
 
-Matrix& NeuralNetworkParallel::forward(const Matrix& X)
+Matrix& NeuralNetworkParallel::forward(const MatrixView& X)
 {
-	Z[0] = X;
-	for (size_t i = 0; i < weights.size() - 1; ++i)
+	inputs = X;
+	for (size_t i = 0; i < weights.size(); ++i)
 	{
-		tempM = std::move(Matrix::addOnes(Z[i]));
-		Matrix::setParallelMatrixOps(tempM, weights[i]);
-		pool.dispatch(tempM.getDimensions().first * weights[i].getDimensions().second,
-			&(Matrix::parallelDotProducts));
-		Matrix result = Matrix::moveParallelResult();
-		result.activateTanH();
-		Z[i + 1] = std::move(result);//Would need to compare std move performance knowing a delete is involved..
+		//Rows of the activations per thread, written in place with bias and tanh (all but the output) applied as each tile is written
+		Activation activation = i + 1 < weights.size() ? Activation::TanH : Activation::None;
+		if (sparseWeights.empty())pool.dispatch(Matrix::setParallelProductOps(Z[i], layerInput(i), weights[i], true, activation),
+			&(Matrix::parallelProductRows));
+		else pool.dispatch(SparseMatrix::setParallelMultiplyOps(Z[i], layerInput(i), sparseWeights[i], true, activation),
+			&SparseMatrix::parallelRange);
 	}
-	tempM = std::move(Matrix::addOnes(Z[Z.size() - 2]));
-	Matrix::setParallelMatrixOps(tempM, weights.back());
-	pool.dispatch(tempM.getDimensions().first * weights.back().getDimensions().second,
-		&(Matrix::parallelDotProducts));
-	Z.back() = Matrix::moveParallelResult();
 	return Z.back();
 }
 
-std::vector<Matrix> NeuralNetworkParallel::gradients(const Matrix& T)
+void NeuralNetworkParallel::gradients(const Matrix& T)
 {
 	//Reverse order for backpropagation (order of dependecies)
-	std::vector<Matrix> grads(weights.size());
 	//The reverse order is based on the weight count, and aligns with
 	//	the indices of the Z matrices
-	//	Notably, ||Z|| === ||W|| + 1
-	//		but the first [0, ||W||) elements are aligned
+	//	Notably, ||Z|| === ||W||, Z[i] is the output of W[i]
+	//		and its input is layerInput(i), X or Z[i - 1]
 	//	Therefore, can just reverse iterate over W's indices
-	//		and reuse both for W[i] and Z[i]
-	Matrix delta = std::move(T - Z.back());
+	//		and reuse them for W[i], Z[i], and deltas[i]
+	pool.dispatch(Matrix::setParallelExpressionOps(deltas.back(), T - Z.back()), &Matrix::parallelRange);
 	for (int i = static_cast<int>(weights.size()) - 1; i >= 0; --i)
 	{
-		tempM = std::move(Matrix::transpose((Matrix::addOnes(Z[i]))));
-		Matrix::setParallelMatrixOps(tempM, delta);
-		pool.dispatch(tempM.getDimensions().first * delta.getDimensions().second,
-			&(Matrix::parallelDotProducts));
-		grads.emplace_back(Matrix::moveParallelResult());
-		tempM = Matrix::transpose(weights[i], 1);
-		Matrix::setParallelMatrixOps(delta, tempM);
-		pool.dispatch(delta.getDimensions().first * tempM.getDimensions().second,
-			&(Matrix::parallelDotProducts));
-		tempM = Matrix::moveParallelResult();
-		delta = std::move(Matrix::componentwise((tempM),
-			(1.0f - Matrix::square(Z[i]))));
+		//Transposes are folded into the products rather than copied out, rows of the result per thread
+		pool.dispatch(Matrix::setParallelAddOnesTransposeOps(grads[i], layerInput(i), deltas[i]),
+			&(Matrix::parallelProductRows));
+		if (i == 0)break;//No layer below the input to pass the error to
+		//The bias row passes no error down, it is sliced off rather than copied around
+		const Matrix& W = weights[i];
+		pool.dispatch(Matrix::setParallelProductOps(deltas[i - 1], deltas[i],
+			W.view().rowSlice(1, W.getDimensions().first).transpose()), &(Matrix::parallelProductRows));
+		pool.dispatch(Matrix::setParallelExpressionOps(deltas[i - 1],
+			Matrix::componentwise(deltas[i - 1], 1.0f - Matrix::square(Z[i - 1]))), &Matrix::parallelRange);
 	}
-	return grads;
+}
+
+MatrixView NeuralNetworkParallel::layerInput(size_t i) const
+{
+	return i == 0 ? inputs : Z[i - 1].view();
 }
 
 std::ostream& operator<<(std::ostream& out, const NeuralNetworkParallel& mat)
@@ -1,6 +1,6 @@
 /*
 Author: Dan Rehberg
-Modified: 12/8/2022
+Modified: 10/19/2026
 Purpose: Implementation of a neural network to test
 	the performance of various matrix multiplication implementations.
 The goal is to see how well atomic operations fit into machine
@@ -14,7 +14,9 @@ The goal is to see how well atomic operations fit into machine
 #include <ostream>
 #include <vector>
 #include <string>
+#include <stdexcept>
 #include "SerialMatrix.hpp"
+#include "SparseMatrix.hpp"
 #include "ThreadPool.hpp"
 
 #define Matrix SerialMatrix
@@ -23,32 +25,45 @@ class NeuralNetworkParallel
 {
 private:
 	NeuralNetworkParallel();
+	NeuralNetworkParallel(const LowJitterSettings& settings);
 public:
 	NeuralNetworkParallel(const NeuralNetworkParallel& cp) = delete;
 	NeuralNetworkParallel(const size_t inputCount, const std::vector<size_t>& hiddenCount, const size_t outputCount);
+	NeuralNetworkParallel(const size_t inputCount, const std::vector<size_t>& hiddenCount, const size_t outputCount,
+		const LowJitterSettings& settings);//Pool runs in low jitter mode
 	~NeuralNetworkParallel();
 
 	void testWeights();
+	void prefaultBuffers();//Lock and touch the weights and activations currently allocated
+	const std::vector<std::string>& getDeniedSettings() const;
 
 	std::string getInfo() const;
 	void train(Matrix X, Matrix T, const size_t epochs, float learningRate);
 
 	Matrix use(Matrix X);
+	//Magnitude pruning for use(): each layer keeps its bias row and the largest (1 - sparsity) of its other weights, as CSR
+	//	The dense weights are left as they are, and training again drops the pruned copies
+	void prune(float sparsity);
 private:
 	NeuralNetworkParallel& operator=(const NeuralNetworkParallel& cp);
 
-	float rmse(const Matrix& T, const Matrix& Y) const;
-	Matrix& forward(const Matrix& X);
-	std::vector<Matrix> gradients(const Matrix& T);
+	float rmse(const Matrix& T, const Matrix& Y);
+	Matrix& forward(const MatrixView& X);
+	void gradients(const Matrix& T);//Fills grads, aligned with weights
+	MatrixView layerInput(size_t i) const;//X for the first layer, otherwise the activations of the layer below
 
 	size_t input, output, epoch;
 	std::vector<size_t> hidden;
-	std::vector<Matrix> weights, Z;
+	std::vector<Matrix> weights, Z;//Z[i] is the output of weights[i]
+	std::vector<SparseMatrix> sparseWeights;//Empty unless pruned, then what forward multiplies by
+	MatrixView inputs;//forward's X, read in place rather than copied into the activations
+	std::vector<Matrix> grads, deltas;//Reused every epoch, deltas[i] is the error at the output of layer i
+	Matrix diff, scaledDiff;//rmse buffers
 	std::vector<float> error;
 	Matrix xMean, xStd, tMean, tStd;
 	ThreadPool pool;
 
-	static Matrix tempM;
+	void buildWeights(const size_t inputCount, const std::vector<size_t>& hiddenCount, const size_t outputCount);
 };
 
 std::ostream& operator<<(std::ostream& out, const NeuralNetworkParallel& mat);
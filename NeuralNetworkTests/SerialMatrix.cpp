@@ -1,65 +1,572 @@
 /*
 Author: Dan Rehberg
-Modified Date: 12/9/2022
+Modified Date: 10/19/2026
 */
 #include "SerialMatrix.hpp"
+#include "MatrixBufferPool.hpp"
+#include "TypedKernels.hpp"
+#include <algorithm>
 
-//Parallel Stuff
-SerialMatrix* SerialMatrix::mA = nullptr;
-SerialMatrix* SerialMatrix::mB = nullptr;
-SerialMatrix SerialMatrix::mC = SerialMatrix(1, 1);
+static_assert(MATRIX_ALIGNMENT <= MATRIX_POOL_ALIGNMENT, "Pooled matrix buffers must be at least MATRIX_ALIGNMENT aligned");
 
-void SerialMatrix::setParallelMatrixOps(SerialMatrix& matA, SerialMatrix& matB, bool multiplication)
+//Parallel Stuff, one set per element type
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc>* BasicSerialMatrix<T, Acc>::mA = nullptr;
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc>* BasicSerialMatrix<T, Acc>::mB = nullptr;
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc> BasicSerialMatrix<T, Acc>::mC = BasicSerialMatrix<T, Acc>(1, 1);
+template <typename T, typename Acc>
+BasicMatrixView<T, Acc> BasicSerialMatrix<T, Acc>::mViewA;
+template <typename T, typename Acc>
+BasicMatrixView<T, Acc> BasicSerialMatrix<T, Acc>::mViewB;
+template <typename T, typename Acc>
+bool BasicSerialMatrix<T, Acc>::mAddOnesA = false;
+template <typename T, typename Acc>
+bool BasicSerialMatrix<T, Acc>::mOnesRowA = false;
+template <typename T, typename Acc>
+Activation BasicSerialMatrix<T, Acc>::mActivation = Activation::None;
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc>* BasicSerialMatrix<T, Acc>::mProduct = &BasicSerialMatrix<T, Acc>::mC;
+template <typename T, typename Acc>
+const void* BasicSerialMatrix<T, Acc>::mExpression = nullptr;
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc>* BasicSerialMatrix<T, Acc>::mParallelOut = nullptr;
+template <typename T, typename Acc>
+void(*BasicSerialMatrix<T, Acc>::mRangeTask)(uint64_t, uint64_t) = nullptr;
+template <typename T, typename Acc>
+std::vector<Acc> BasicSerialMatrix<T, Acc>::mPartialSums;
+template <typename T, typename Acc>
+Acc BasicSerialMatrix<T, Acc>::mParallelSum = Acc(0);
+template <typename T, typename Acc>
+BasicMatrixView<T, Acc> BasicSerialMatrix<T, Acc>::mStatistics;
+template <typename T, typename Acc>
+bool BasicSerialMatrix<T, Acc>::mStatisticsRows = false;
+template <typename T, typename Acc>
+std::vector<Acc> BasicSerialMatrix<T, Acc>::mPartialMeans;
+template <typename T, typename Acc>
+std::vector<Acc> BasicSerialMatrix<T, Acc>::mPartialM2s;
+template <typename T, typename Acc>
+std::vector<T> BasicSerialMatrix<T, Acc>::mStrassenWorkspace;
+template <typename T, typename Acc>
+size_t BasicSerialMatrix<T, Acc>::mStrassenCutoff = MATRIX_STRASSEN_CUTOFF;
+template <typename T, typename Acc>
+bool BasicSerialMatrix<T, Acc>::mStrassen = false;
+template <typename T, typename Acc>
+std::vector<BasicSerialMatrix<T, Acc>>* BasicSerialMatrix<T, Acc>::mBatchOut = nullptr;
+template <typename T, typename Acc>
+const std::vector<BasicMatrixView<T, Acc>>* BasicSerialMatrix<T, Acc>::mBatchA = nullptr;
+template <typename T, typename Acc>
+const std::vector<BasicMatrixView<T, Acc>>* BasicSerialMatrix<T, Acc>::mBatchB = nullptr;
+
+//op(M) without its first rowStart stored rows, as the flag based products take their operands
+template <typename T, typename Acc>
+static BasicMatrixView<T, Acc> operand(const BasicSerialMatrix<T, Acc>& M, bool transpose, size_t rowStart)
+{
+	BasicMatrixView<T, Acc> view = M.view().rowSlice(rowStart, M.getDimensions().first);
+	return transpose ? view.transpose() : view;
+}
+
+//The bias row and activation epilogues, and the ones column, are written along rows of the destination
+template <typename T, typename Acc>
+static void requireRowMajor(const BasicSerialMatrix<T, Acc>& out, const char* operation)
+{
+	if (out.getLayout() != MatrixLayout::RowMajor)throw std::range_error(std::string(operation) + R"( writes whole rows 
+		of its destination, which must be row major)");
+}
+
+//C row = beta * C row, not read when beta is zero
+template <typename T, typename Acc>
+static void scaleRow(T* c, size_t count, Acc beta)
+{
+	if (beta == Acc(0))std::fill(c, c + count, T(0));
+	else if (beta != Acc(1))TypedKernels<T, Acc>::scalarLeft(ElementOp::Multiply, 1, count, beta, c, count, c, count);
+}
+
+//The first row of a transposed B is a stored column, packed into a row the GEMM epilogue adds as its bias
+//	One per thread as the pool runs productRows; it only grows, so a steady state product does not allocate
+template <typename T>
+static const T* packColumn(const T* column, size_t count, size_t step)
 {
+	thread_local std::vector<T> row;
+	if (row.size() < count)row.resize(count);
+	for (size_t j = 0; j < count; ++j)row[j] = column[j * step];
+	return row.data();
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::setParallelMatrixOps(BasicSerialMatrix& matA, BasicSerialMatrix& matB, bool multiplication)
+{
+	//The dot products index storage directly
+	if (matA.layout != MatrixLayout::RowMajor || matB.layout != MatrixLayout::RowMajor)throw std::range_error(R"(Parallel dot 
+		products require row major matrices)");
 	mA = &matA;
 	mB = &matB;
 	if (multiplication)
 	{
-		mC = SerialMatrix(matA.rows, matB.columns);
+		mC = BasicSerialMatrix(matA.rows, matB.columns);
 	}
 }
 
-void SerialMatrix::parallelDotProducts(std::mutex& m, unsigned int component)
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::parallelDotProducts(std::mutex& m, uint64_t component)
 {
 	//First, need to determine which column and row the component index is in.
 	// So, need both the dividend and remainder..
-	unsigned int curRow = component / mC.columns, curColumn = component % mC.columns;
+	size_t curRow = component / mC.columns, curColumn = component % mC.columns;
+
+	BasicSerialMatrix& A = *mA;
+	BasicSerialMatrix& B = *mB;
+	Acc sum = 0;
+	size_t rowOffset = curRow * A.stride;
+	for (size_t j = 0; j < A.columns; ++j)
+	{
+		sum += static_cast<Acc>(A.data[j + rowOffset]) * static_cast<Acc>(B.data[j * B.stride + curColumn]);
+	}
+	mC.data[curRow * mC.stride + curColumn] = static_cast<T>(sum);
+}
 
-	SerialMatrix& A = *mA;
-	SerialMatrix& B = *mB;
-	float sum = 0;
-	unsigned int rowOffset = curRow * A.columns;
-	for (unsigned int j = 0; j < A.columns; ++j)
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::parallelDotProductRange(std::mutex&, uint64_t start, uint64_t end)
+{
+	//Only the first component needs the division; each row's share of the range is one vector times matrix product
+	//	over that span of B's columns, run by the vector kernels rather than a strided dot product per component
+	size_t curRow = start / mC.columns, curColumn = start % mC.columns;
+
+	BasicSerialMatrix& A = *mA;
+	BasicSerialMatrix& B = *mB;
+	while (start < end)
+	{
+		size_t span = std::min<uint64_t>(end - start, mC.columns - curColumn);
+		TypedKernels<T, Acc>::gemm(false, false, 1, span, A.columns, Acc(1), A.data + curRow * A.stride, A.stride,
+			B.data + curColumn, B.stride, Acc(0), mC.data + curRow * mC.stride + curColumn, mC.stride);
+		start += span;
+		curColumn = 0;
+		++curRow;
+	}
+}
+
+template <typename T, typename Acc>
+uint64_t BasicSerialMatrix<T, Acc>::setParallelProductOps(BasicSerialMatrix& matA, bool transposeA, BasicSerialMatrix& matB, bool transposeB,
+	size_t rowStartB, bool addOnesA)
+{
+	return setParallelProductOps(mC, matA, transposeA, matB, transposeB, rowStartB, addOnesA);
+}
+
+template <typename T, typename Acc>
+uint64_t BasicSerialMatrix<T, Acc>::setParallelProductOps(BasicSerialMatrix& C, BasicSerialMatrix& matA, bool transposeA, BasicSerialMatrix& matB,
+	bool transposeB, size_t rowStartB, bool addOnesA)
+{
+	mA = &matA;
+	mB = &matB;
+	return setParallelProductOps(C, operand(matA, transposeA, 0), operand(matB, transposeB, rowStartB), addOnesA);
+}
+
+template <typename T, typename Acc>
+uint64_t BasicSerialMatrix<T, Acc>::setParallelProductOps(BasicSerialMatrix& C, const View& A, const View& B, bool addOnesA,
+	Activation activation)
+{
+	return prepareProduct(C, A, B, addOnesA, false, activation);
+}
+
+template <typename T, typename Acc>
+uint64_t BasicSerialMatrix<T, Acc>::setParallelAddOnesTransposeOps(BasicSerialMatrix& C, const View& A, const View& B)
+{
+	requireRowMajor(C, "addOnesTransposeMultiply");
+	return prepareProduct(C, A.transpose(), B, false, true, Activation::None);
+}
+
+template <typename T, typename Acc>
+uint64_t BasicSerialMatrix<T, Acc>::prepareProduct(BasicSerialMatrix& C, const View& A, const View& B, bool addOnesA,
+	bool onesRowA, Activation activation)
+{
+	std::pair<size_t, size_t> dimensions = productDimensions(A, addOnesA, B, onesRowA);
+	if (C.layout != MatrixLayout::RowMajor)
+	{
+		if (addOnesA || activation != Activation::None)requireRowMajor(C, "A product with leading ones or an activation");
+		gemm(C, A, B);
+		return 0;
+	}
+	if (dimensions.first == 1)
 	{
-		sum += A.data[j + rowOffset] * B.data[j * B.columns + curColumn];
+		//One row is one task, e.g., a single sample through use(); the vector kernels run it here rather than on a woken thread
+		C.resize(1, dimensions.second);
+		productRows(A, addOnesA, B, Acc(1), Acc(0), C, 0, 1, activation, onesRowA);
+		return 0;
 	}
-	mC.data[component] = sum;
+	mViewA = A;
+	mViewB = B;
+	mAddOnesA = addOnesA;
+	mOnesRowA = onesRowA;
+	mActivation = activation;
+	C.resize(dimensions.first, dimensions.second);
+	mProduct = &C;
+	return dimensions.first;
 }
 
-SerialMatrix&& SerialMatrix::moveParallelResult()
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::parallelProductRows(std::mutex&, uint64_t start, uint64_t end)
+{
+	productRows(mViewA, mAddOnesA, mViewB, Acc(1), Acc(0), *mProduct, start, end, mActivation, mOnesRowA);
+}
+
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc>&& BasicSerialMatrix<T, Acc>::moveParallelResult()
 {
 	return std::move(mC);
 }
 
+template <typename T, typename Acc>
+uint64_t BasicSerialMatrix<T, Acc>::setParallelStrassenOps(BasicSerialMatrix& C, const View& A, const View& B, size_t cutoff)
+{
+	mStrassen = C.layout == MatrixLayout::RowMajor && strassenApplies(A, B, cutoff);
+	if (!mStrassen)
+	{
+		mRangeTask = &productTask;
+		return setParallelProductOps(C, A, B);
+	}
+	size_t n = A.getDimensions().first;
+	C.resize(n, n);
+	size_t needed = TypedKernels<T, Acc>::strassenParallelWorkspace(n, cutoff);
+	if (mStrassenWorkspace.size() < needed)mStrassenWorkspace.resize(needed);
+	mViewA = A;
+	mViewB = B;
+	mProduct = &C;
+	mStrassenCutoff = cutoff;
+	mRangeTask = &strassenProducts;
+	return 7;
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::mergeParallelStrassen()
+{
+	if (!mStrassen)return;
+	BasicSerialMatrix& C = *mProduct;
+	TypedKernels<T, Acc>::strassenCombine(C.rows, mViewA.getData(), mViewA.getStride(), mViewB.getData(), mViewB.getStride(),
+		C.data, C.stride, mStrassenWorkspace.data());
+}
+
+template <typename T, typename Acc>
+uint64_t BasicSerialMatrix<T, Acc>::setParallelBatchedOps(std::vector<BasicSerialMatrix>& C, const std::vector<View>& A,
+	const std::vector<View>& B, bool addOnesA, Activation activation)
+{
+	uint64_t count = prepareBatched(C, A, B, addOnesA, activation);
+	mBatchOut = &C;
+	mBatchA = &A;
+	mBatchB = &B;
+	mAddOnesA = addOnesA;
+	mActivation = activation;
+	mRangeTask = &batchedTask;
+	return count;
+}
+
+template <typename T, typename Acc>
+uint64_t BasicSerialMatrix<T, Acc>::setParallelStatisticsOps(const View& ref, bool row)
+{
+	mStatistics = ref.isTransposed() ? ref.transpose() : ref;
+	mStatisticsRows = ref.isTransposed() ? !row : row;
+	return prepareStatistics(mStatistics, mStatisticsRows, mPartialMeans, mPartialM2s);
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::parallelStatisticsRange(std::mutex&, uint64_t start, uint64_t end)
+{
+	statisticsBlocks(mStatistics, mStatisticsRows, start, end, mPartialMeans.data(), mPartialM2s.data());
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::mergeParallelStatistics(BasicSerialMatrix& mean, BasicSerialMatrix& deviation)
+{
+	mergeStatistics(mStatistics, mStatisticsRows, mPartialMeans.data(), mPartialM2s.data(), mean, deviation);
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::parallelRange(std::mutex&, uint64_t start, uint64_t end)
+{
+	mRangeTask(start, end);
+}
+
+template <typename T, typename Acc>
+Acc BasicSerialMatrix<T, Acc>::getParallelSum()
+{
+	if (mPartialSums.empty())return mParallelSum;
+	Acc total = Acc(0);
+	for (Acc partial : mPartialSums)total += partial;
+	return total;
+}
+
+template <typename T, typename Acc>
+uint64_t BasicSerialMatrix<T, Acc>::setParallelActivationOps(BasicSerialMatrix& out, const View& in)
+{
+	std::pair<size_t, size_t> dimensions = in.getDimensions();
+	if (dimensions.first * dimensions.second < MATRIX_PARALLEL_THRESHOLD || dimensions.first == 1 ||
+		out.layout != MatrixLayout::RowMajor)
+	{
+		activateTanH(out, in);
+		return 0;
+	}
+	out.resize(dimensions.first, dimensions.second);
+	mViewA = in;
+	mParallelOut = &out;
+	mRangeTask = &activationRows;
+	return dimensions.first;
+}
+
+template <typename T, typename Acc>
+uint64_t BasicSerialMatrix<T, Acc>::setParallelAddOnesOps(BasicSerialMatrix& out, const View& in)
+{
+	requireRowMajor(out, "addOnes");
+	std::pair<size_t, size_t> dimensions = in.getDimensions();
+	out.resize(dimensions.first, dimensions.second + 1);
+	if (dimensions.first * dimensions.second < MATRIX_PARALLEL_THRESHOLD || dimensions.first == 1)
+	{
+		addOnesRows(out, in, 0, dimensions.first);
+		return 0;
+	}
+	mViewA = in;
+	mParallelOut = &out;
+	mRangeTask = &addOnesRows;
+	return dimensions.first;
+}
+
+template <typename T, typename Acc>
+uint64_t BasicSerialMatrix<T, Acc>::setParallelTransposeOps(BasicSerialMatrix& out, const View& in)
+{
+	//A transposed view transposed back is a copy of its stored rows, an expression like any other
+	if (in.isTransposed())
+	{
+		mViewB = in.transpose();
+		return setParallelExpressionOps(out, mViewB);
+	}
+	std::pair<size_t, size_t> dimensions = in.getDimensions();
+	if (out.layout != MatrixLayout::RowMajor)
+	{
+		transpose(out, in);
+		return 0;
+	}
+	out.resize(dimensions.second, dimensions.first);
+	if (dimensions.first * dimensions.second < MATRIX_PARALLEL_THRESHOLD || dimensions.second == 1)
+	{
+		TypedKernels<T, Acc>::transpose(dimensions.first, dimensions.second, in.getData(), in.getStride(), out.data, out.stride);
+		return 0;
+	}
+	mViewA = in;
+	mParallelOut = &out;
+	mRangeTask = &transposeRows;
+	return dimensions.second;
+}
+
+template <typename T, typename Acc>
+uint64_t BasicSerialMatrix<T, Acc>::setParallelMeanOps(const View& ref, bool row)
+{
+	mStatistics = ref.isTransposed() ? ref.transpose() : ref;
+	mStatisticsRows = ref.isTransposed() ? !row : row;
+	uint64_t blocks = prepareStatistics(mStatistics, mStatisticsRows, mPartialMeans, mPartialM2s);
+	if (mStatistics.getCapacity() < MATRIX_PARALLEL_THRESHOLD || blocks == 1)
+	{
+		meanBlocks(0, blocks);
+		return 0;
+	}
+	mRangeTask = &meanBlocks;
+	return blocks;
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::mergeParallelMean(BasicSerialMatrix& mean)
+{
+	size_t refRows = mStatistics.getDimensions().first, refColumns = mStatistics.getDimensions().second;
+	if (mStatisticsRows)
+	{
+		mean.resize(1, refRows);
+		for (size_t i = 0; i < refRows; ++i)mean.data[i] = static_cast<T>(mPartialMeans[i]);
+		return;
+	}
+	//Block sums added in order, then scaled once
+	Acc* sums = mPartialMeans.data();
+	for (size_t b = 1; b * MATRIX_STATISTICS_BLOCK < refRows; ++b)
+	{
+		const Acc* block = sums + b * refColumns;
+		for (size_t j = 0; j < refColumns; ++j)sums[j] += block[j];
+	}
+	mean.resize(1, refColumns);
+	Acc inv = Acc(1) / static_cast<Acc>(refRows);
+	for (size_t j = 0; j < refColumns; ++j)mean.data[j] = static_cast<T>(sums[j] * inv);
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::activationRows(uint64_t start, uint64_t end)
+{
+	activationRows(*mParallelOut, mViewA, start, end);
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::addOnesRows(uint64_t start, uint64_t end)
+{
+	addOnesRows(*mParallelOut, mViewA, start, end);
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::transposeRows(uint64_t start, uint64_t end)
+{
+	//Each task reads a band of columns down every row of the input
+	BasicSerialMatrix& out = *mParallelOut;
+	TypedKernels<T, Acc>::transpose(mViewA.getDimensions().first, end - start, mViewA.address(0, start), mViewA.getStride(),
+		out.data + start * out.stride, out.stride);
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::productTask(uint64_t start, uint64_t end)
+{
+	productRows(mViewA, mAddOnesA, mViewB, Acc(1), Acc(0), *mProduct, start, end, mActivation, mOnesRowA);
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::strassenProducts(uint64_t start, uint64_t end)
+{
+	BasicSerialMatrix& C = *mProduct;
+	for (uint64_t p = start; p < end; ++p)
+	{
+		TypedKernels<T, Acc>::strassenProduct(p, C.rows, mViewA.getData(), mViewA.getStride(), mViewB.getData(),
+			mViewB.getStride(), C.data, C.stride, mStrassenCutoff, mStrassenWorkspace.data());
+	}
+}
+
+template <typename T, typename Acc>
+uint64_t BasicSerialMatrix<T, Acc>::prepareBatched(std::vector<BasicSerialMatrix>& C, const std::vector<View>& A,
+	const std::vector<View>& B, bool addOnesA, Activation activation)
+{
+	size_t count = std::max(A.size(), B.size());
+	if (A.empty() || B.empty() || (A.size() != 1 && A.size() != count) || (B.size() != 1 && B.size() != count))
+		throw std::length_error(R"(Batched products require as many left and right matrices, 
+			or a single one of either shared by the batch: left has: )" + std::to_string(A.size()) +
+			" while right has: " + std::to_string(B.size()));
+	//Everything that can throw or allocate is done here, so the products themselves only write their destinations
+	if (C.size() != count)C.resize(count);
+	for (size_t p = 0; p < count; ++p)
+	{
+		std::pair<size_t, size_t> dimensions = productDimensions(A[A.size() == 1 ? 0 : p], addOnesA, B[B.size() == 1 ? 0 : p]);
+		if (addOnesA || activation != Activation::None)requireRowMajor(C[p], "A product with leading ones or an activation");
+		C[p].resize(dimensions.first, dimensions.second);
+	}
+	return count;
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::batchedProducts(std::vector<BasicSerialMatrix>& C, const std::vector<View>& A,
+	const std::vector<View>& B, bool addOnesA, Activation activation, uint64_t start, uint64_t end)
+{
+	for (uint64_t p = start; p < end; ++p)
+	{
+		const View& a = A[A.size() == 1 ? 0 : p];
+		const View& b = B[B.size() == 1 ? 0 : p];
+		BasicSerialMatrix& out = C[p];
+		if (out.layout == MatrixLayout::ColumnMajor)
+		{
+			//As gemm, C^T = B^T * A^T into the row major storage
+			out.flip();
+			productRows(b.transpose(), false, a.transpose(), Acc(1), Acc(0), out, 0, out.rows);
+			out.flip();
+			continue;
+		}
+		productRows(a, addOnesA, b, Acc(1), Acc(0), out, 0, out.rows, activation);
+	}
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::batchedTask(uint64_t start, uint64_t end)
+{
+	batchedProducts(*mBatchOut, *mBatchA, *mBatchB, mAddOnesA, mActivation, start, end);
+}
+
+template <typename T, typename Acc>
+bool BasicSerialMatrix<T, Acc>::strassenApplies(const View& A, const View& B, size_t cutoff)
+{
+	//16 bit storage would round every level's sums, those types always run gemm
+	if (!std::is_same<T, Acc>::value)return false;
+	std::pair<size_t, size_t> a = A.getDimensions();
+	return a.first >= cutoff && a.first >= 2 && a.first == a.second && B.getDimensions() == a &&
+		!A.isTransposed() && !B.isTransposed();
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::meanBlocks(uint64_t start, uint64_t end)
+{
+	size_t refRows = mStatistics.getDimensions().first, refColumns = mStatistics.getDimensions().second;
+	for (uint64_t b = start; b < end; ++b)
+	{
+		size_t rowBegin = b * MATRIX_STATISTICS_BLOCK, rowEnd = std::min<size_t>(rowBegin + MATRIX_STATISTICS_BLOCK, refRows);
+		if (mStatisticsRows)
+		{
+			Acc inv = Acc(1) / static_cast<Acc>(refColumns);
+			for (size_t i = rowBegin; i < rowEnd; ++i)
+			{
+				mPartialMeans[i] = TypedKernels<T, Acc>::sum(1, refColumns, mStatistics.address(i, 0), refColumns) * inv;
+			}
+		}
+		else
+		{
+			TypedKernels<T, Acc>::columnSums(rowEnd - rowBegin, refColumns, mStatistics.address(rowBegin, 0), mStatistics.getStride(),
+				mPartialMeans.data() + b * refColumns);
+		}
+	}
+}
+
 //End Parallel Stuff
 
+template <typename T, typename Acc>
+size_t BasicSerialMatrix<T, Acc>::strideFor(size_t c)
+{
+	//Narrow matrices stay packed, padding them would multiply their footprint
+	//	The multiple and period are byte counts given in floats, scaled to this element's size
+	size_t multiple = MATRIX_STRIDE_MULTIPLE * sizeof(float) / sizeof(T), period = MATRIX_SET_PERIOD * sizeof(float) / sizeof(T);
+	if (c < multiple)return c;
+	size_t ld = (c + multiple - 1) / multiple * multiple;
+	if (ld % period == 0)ld += multiple;
+	return ld;
+}
 
-SerialMatrix::SerialMatrix() : rows(0), columns(0), capacity(0), data(nullptr)
+template <typename T, typename Acc>
+T* BasicSerialMatrix<T, Acc>::allocate(size_t count)
 {
+#if MATRIX_BUFFER_POOL
+	return static_cast<T*>(MatrixBufferPool::acquire(count * sizeof(T)));
+#else
+	return static_cast<T*>(::operator new[](count * sizeof(T), std::align_val_t(MATRIX_ALIGNMENT), std::nothrow));
+#endif
+}
 
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::release(T* memory)
+{
+#if MATRIX_BUFFER_POOL
+	MatrixBufferPool::release(memory);
+#else
+	if (memory != nullptr)::operator delete[](memory, std::align_val_t(MATRIX_ALIGNMENT));
+#endif
 }
 
-SerialMatrix::SerialMatrix(size_t r, size_t c) : SerialMatrix()
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc>::BasicSerialMatrix() : rows(0), columns(0), capacity(0), stride(0), data(nullptr),
+	layout(MatrixLayout::RowMajor)
+{
+
+}
+
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc>::BasicSerialMatrix(size_t r, size_t c, MatrixLayout order) : BasicSerialMatrix()
 {
 	rows = r;
 	columns = c;
 	capacity = r * c;
+	layout = order;
 	if (capacity == 0)throw std::length_error("(r,c constructor) Cannot have a matrix with zero elements");
-	data = new (std::nothrow)float[capacity];
+	stride = strideFor(lineLength(getDimensions()));
+	data = allocate(storage());
 	if (data == nullptr)throw std::bad_alloc();//"Serial Matrix class, bad allocation on Row Col Constructor"
 }
 
-SerialMatrix::SerialMatrix(const std::vector<std::vector<float>>& values) : SerialMatrix()
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc>::BasicSerialMatrix(const std::vector<std::vector<Acc>>& values) : BasicSerialMatrix()
 {
 	if ((values.size() * values[0].size()) == 0)throw std::length_error("(vector copy) Cannot have a matrix with zero elements");
 	size_t consistent = values[0].size();
@@ -70,33 +577,40 @@ SerialMatrix::SerialMatrix(const std::vector<std::vector<float>>& values) : Seri
 	deepCopy(values);
 }
 
-SerialMatrix::SerialMatrix(const SerialMatrix& cp) : SerialMatrix()
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc>::BasicSerialMatrix(const BasicSerialMatrix& cp) : BasicSerialMatrix()
 {
 	deepCopy(cp);
 }
 
-SerialMatrix::SerialMatrix(SerialMatrix&& rhs) : SerialMatrix()
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc>::BasicSerialMatrix(BasicSerialMatrix&& rhs) : BasicSerialMatrix()
 {
 	rows = rhs.rows;
 	columns = rhs.columns;
 	capacity = rhs.capacity;
+	stride = rhs.stride;
 	data = rhs.data;
+	layout = rhs.layout;
 	rhs.data = nullptr;
 	rhs.capacity = 0;
+	rhs.stride = 0;
 	rhs.rows = 0;
 	rhs.columns = 0;
 }
 
-SerialMatrix::~SerialMatrix()
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc>::~BasicSerialMatrix()
 {
 	if (data != nullptr)
 	{
-		delete[] data;//RAII
+		release(data);//RAII
 	}
 	data = nullptr;
 }
 
-SerialMatrix& SerialMatrix::operator=(const SerialMatrix& cp)
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc>& BasicSerialMatrix<T, Acc>::operator=(const BasicSerialMatrix& cp)
 {
 	if (this != &cp)
 	{
@@ -105,21 +619,26 @@ SerialMatrix& SerialMatrix::operator=(const SerialMatrix& cp)
 	return *this;
 }
 
-SerialMatrix& SerialMatrix::operator=(SerialMatrix&& rhs)
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc>& BasicSerialMatrix<T, Acc>::operator=(BasicSerialMatrix&& rhs)
 {
-	if (data != nullptr)delete[] data;
+	release(data);
 	rows = rhs.rows;
 	columns = rhs.columns;
 	capacity = rhs.capacity;
+	stride = rhs.stride;
 	data = rhs.data;
+	layout = rhs.layout;
 	rhs.data = nullptr;
 	rhs.capacity = 0;
+	rhs.stride = 0;
 	rhs.rows = 0;
 	rhs.columns = 0;
 	return *this;
 }
 
-SerialMatrix& SerialMatrix::operator=(const std::vector<std::vector<float>>& values)
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc>& BasicSerialMatrix<T, Acc>::operator=(const std::vector<std::vector<Acc>>& values)
 {
 	if ((values.size() * values[0].size()) == 0)throw std::length_error("(vector =) Cannot have a matrix with zero elements");
 	size_t consistent = values[0].size();
@@ -131,235 +650,334 @@ SerialMatrix& SerialMatrix::operator=(const std::vector<std::vector<float>>& val
 	return *this;
 }
 
-SerialMatrix SerialMatrix::operator*(const SerialMatrix& rhs) const
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc> BasicSerialMatrix<T, Acc>::operator*(const BasicSerialMatrix& rhs) const
 {
 	if (columns != rhs.rows)
 	{
-		return SerialMatrix();
-	}
-	SerialMatrix temp(rows, rhs.columns);
-	//Going to avoid divisions here with a simple conditional
-	size_t offset = 0;
-	size_t curRow = 0;
-	for (size_t i = 0; offset < temp.capacity; ++i)
-	{
-		if (i == temp.columns)
-		{
-			i = 0;
-			++curRow;
-		}
-		float sum = 0;
-		size_t rowOffset = curRow * this->columns;
-		for (size_t j = 0; j < this->columns; ++j)
-		{
-			sum += data[j + rowOffset] * rhs.data[j * rhs.columns + i];
-		}
-		temp.data[offset++] = sum;
+		return BasicSerialMatrix();
 	}
+	//Packed and cache blocked, see MatrixKernels for the tiling; a column major operand is a transposed one
+	BasicSerialMatrix temp;
+	gemm(temp, view(), rhs.view());
 	return temp;
 }
 
-SerialMatrix SerialMatrix::operator-(const SerialMatrix& rhs) const
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc> BasicSerialMatrix<T, Acc>::transpose(const BasicSerialMatrix& ref, size_t rowStart)
+{
+	if (rowStart > ref.rows)throw std::range_error(R"(Row start must be less than row count 
+		for a reduced Transpose operation: matrix to transpose has: )"
+		+ std::to_string(ref.rows) + " but rowStart was set to: " + std::to_string(rowStart));
+	return BasicSerialMatrix(ref.view().rowSlice(rowStart, ref.rows).transpose());
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::transpose(BasicSerialMatrix& out, const View& in)
 {
-	SerialMatrix temp(rows, columns);
-	//row or columns modifications only -- might extend, needed to run the NN for now
-	if (rhs.rows == 1)
+	std::pair<size_t, size_t> dimensions = in.getDimensions();
+	out.resize(dimensions.second, dimensions.first);
+	evaluateLayout(in.transpose(), out.data, out.stride, out.layout);
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::transposeInPlace()
+{
+	if (rows == columns)
 	{
-		if (rhs.columns != this->columns)
-			throw std::range_error(R"(Right matrix with 1 row must match column size with left
-				matrix\n\t right matrix column size is: )" + std::to_string(rhs.columns));
-		size_t curIndex = 0;
-		for (size_t i = 0; i < rows; ++i)
-		{
-			for (size_t j = 0; j < columns; ++j) //[[Potential Optimization Pending]]
-			{
-				temp.data[curIndex] = data[curIndex] - rhs.data[j];
-				++curIndex;
-			}
-		}
+		TypedKernels<T, Acc>::transposeSquare(rows, data, stride);
+		return;
 	}
-	/*else if (rhs.columns == 1) //Not necessary for minimal viable product..
+	BasicSerialMatrix temp(columns, rows, layout);
+	transpose(temp, view());
+	*this = std::move(temp);
+}
+
+template <typename T, typename Acc>
+MatrixLayout BasicSerialMatrix<T, Acc>::getLayout() const
+{
+	return layout;
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::setLayout(MatrixLayout order)
+{
+	if (order == layout)return;
+	if (data == nullptr)
 	{
-		if (rhs.rows != this->rows)
-			throw std::range_error(R"(Right matrix with 1 column must match row size with left
-				matrix\n\t right matrix row size is: )" + std::to_string(rhs.rows));
-	}*/
-	else if (rhs.capacity == this->capacity)
+		layout = order;
+		return;
+	}
+	//Both layouts of a square matrix have the same stride, so its storage is transposed where it is
+	if (rows == columns)
 	{
-		for (size_t i = 0; i < capacity; ++i)
-		{
-			temp.data[i] = data[i] - rhs.data[i];
-		}
+		TypedKernels<T, Acc>::transposeSquare(rows, data, stride);
+		layout = order;
+		return;
 	}
-	else throw std::range_error(R"(Right matrix needs like component counts total, 
-		or 1 row with same columns, 
-		or 1 column with same rows
-		\n\t right matrix has dimensions: )" + std::to_string(rhs.rows) + ", " +
-		std::to_string(rhs.columns));
-	return temp;
+	*this = BasicSerialMatrix(view(), order);
 }
 
-SerialMatrix SerialMatrix::operator/(const SerialMatrix& rhs) const
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::flip()
 {
-	SerialMatrix temp(rows, columns);
-	//row or columns modifications only -- might extend, needed to run the NN for now
-	if (rhs.rows == 1)
+	std::swap(rows, columns);
+	layout = layout == MatrixLayout::RowMajor ? MatrixLayout::ColumnMajor : MatrixLayout::RowMajor;
+}
+
+template <typename T, typename Acc>
+std::pair<size_t, size_t> BasicSerialMatrix<T, Acc>::productDimensions(const View& A, bool addOnesA, const View& B, bool onesRowA)
+{
+	std::pair<size_t, size_t> a = A.getDimensions(), b = B.getDimensions();
+	size_t rowsA = onesRowA ? a.first + 1 : a.first;
+	size_t innerA = addOnesA ? a.second + 1 : a.second;
+	if (innerA != b.first)throw std::range_error(R"(Product requires the left matrix columns 
+		match the right matrix rows after transposes: left has: )" + std::to_string(innerA) +
+		" while right has: " + std::to_string(b.first));
+	return std::pair<size_t, size_t>(rowsA, b.second);
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::productRows(const View& A, bool addOnesA, const View& B, Acc alpha, Acc beta,
+	BasicSerialMatrix& C, size_t rowBegin, size_t rowEnd, Activation activation, bool onesRowA)
+{
+	if (rowBegin >= rowEnd)return;
+	const T* b = B.getData();
+	const T* bias = nullptr;
+	size_t inner = A.getDimensions().second;
+	size_t aRow = rowBegin;
+	if (onesRowA)
 	{
-		if (rhs.columns != this->columns)
-			throw std::range_error(R"(Right matrix with 1 row must match column size with left
-				matrix\n\t right matrix column size is: )" + std::to_string(rhs.columns));
-		size_t curIndex = 0;
-		for (size_t i = 0; i < rows; ++i)
+		//The row of ones dotted with each column of B is just that column's sum
+		if (rowBegin == 0)
 		{
-			for (size_t j = 0; j < columns; ++j) //[[Potential Optimization Pending]]
+			scaleRow(C.data, C.columns, beta);
+			if (B.isTransposed())
 			{
-				temp.data[curIndex] = data[curIndex] / rhs.data[j];
-				++curIndex;
+				//Columns of a transposed B are its stored rows
+				for (size_t j = 0; j < C.columns; ++j)C.data[j] = static_cast<T>(static_cast<Acc>(C.data[j]) +
+					alpha * TypedKernels<T, Acc>::sum(1, inner, b + j * B.getStride(), B.getStride()));
 			}
+			else TypedKernels<T, Acc>::axpy(inner, C.columns, alpha, b, B.getStride(), C.data, 0);
+			TypedKernels<T, Acc>::activate(activation, C.columns, C.data, C.data);
+			if (++rowBegin == rowEnd)return;
 		}
+		aRow = rowBegin - 1;
 	}
-	/*else if (rhs.columns == 1) //Not necessary for minimal viable product..
-	{
-		if (rhs.rows != this->rows)
-			throw std::range_error(R"(Right matrix with 1 column must match row size with left
-				matrix\n\t right matrix row size is: )" + std::to_string(rhs.rows));
-	}*/
-	else if (rhs.capacity == this->capacity)
+	else if (addOnesA)
 	{
-		for (size_t i = 0; i < capacity; ++i)
+		//The column of ones adds alpha times the first row of B to every row, a bias the GEMM epilogue adds
+		//	to each tile as it is written; the rest of B multiplies A, transposed or not
+		//	A transposed (e.g., column major) B has that row packed first, and the rest starts a stored column on
+		bias = B.isTransposed() ? packColumn(b, C.columns, B.getStride()) : b;
+		b += B.isTransposed() ? 1 : B.getStride();
+		if (alpha != Acc(1))
 		{
-			temp.data[i] = data[i] / rhs.data[i];
+			//Rare, the network's products are all alpha = 1; folded into beta * C so the epilogue stays a plain add
+			for (size_t i = rowBegin; i < rowEnd; ++i)
+			{
+				T* c = C.data + i * C.stride;
+				scaleRow(c, C.columns, beta);
+				TypedKernels<T, Acc>::axpy(1, C.columns, alpha, bias, C.columns, c, C.columns);
+			}
+			bias = nullptr;
+			beta = Acc(1);
 		}
 	}
-	else throw std::range_error(R"(Right matrix needs like component counts total, 
-		or 1 row with same columns, 
-		or 1 column with same rows
-		\n\t right matrix has dimensions: )" + std::to_string(rhs.rows) + ", " +
-		std::to_string(rhs.columns));
+	TypedKernels<T, Acc>::gemm(A.isTransposed(), B.isTransposed(), rowEnd - rowBegin, C.columns, inner, alpha, A.address(aRow, 0),
+		A.getStride(), b, B.getStride(), beta, C.data + rowBegin * C.stride, C.stride, bias, activation);
+}
+
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc> BasicSerialMatrix<T, Acc>::multiply(const BasicSerialMatrix& A, bool transposeA,
+	const BasicSerialMatrix& B, bool transposeB, size_t rowStartB)
+{
+	BasicSerialMatrix temp;
+	gemm(temp, operand(A, transposeA, 0), operand(B, transposeB, rowStartB));
+	return temp;
+}
+
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc> BasicSerialMatrix<T, Acc>::addOnesTransposeMultiply(const BasicSerialMatrix& A, const BasicSerialMatrix& B)
+{
+	BasicSerialMatrix temp;
+	addOnesTransposeMultiply(temp, A, B);
 	return temp;
 }
 
-SerialMatrix SerialMatrix::operator+(const SerialMatrix& rhs) const
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::resize(size_t r, size_t c)
 {
-	SerialMatrix temp(rows, columns);
-	//row or columns modifications only -- might extend, needed to run the NN for now
-	if (rhs.rows == 1)
+	if (r * c == 0)throw std::length_error("(resize) Cannot have a matrix with zero elements");
+	std::pair<size_t, size_t> dimensions(r, c);
+	size_t ld = strideFor(lineLength(dimensions));
+	if (data == nullptr || storage() != lines(dimensions) * ld)
 	{
-		if (rhs.columns != this->columns)
-			throw std::range_error(R"(Right matrix with 1 row must match column size with left
-				matrix\n\t right matrix column size is: )" + std::to_string(rhs.columns));
-		size_t curIndex = 0;
-		for (size_t i = 0; i < rows; ++i)
-		{
-			for (size_t j = 0; j < columns; ++j) //[[Potential Optimization Pending]]
-			{
-				temp.data[curIndex] = data[curIndex] + rhs.data[j];
-				++curIndex;
-			}
-		}
+		release(data);
+		data = allocate(lines(dimensions) * ld);
+		if (data == nullptr)throw std::bad_alloc();//"Serial Matrix class, bad allocation on Resize"
 	}
-	/*else if (rhs.columns == 1) //Not necessary for minimal viable product..
+	rows = r;
+	columns = c;
+	capacity = r * c;
+	stride = ld;
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::gemm(BasicSerialMatrix& C, const View& A, const View& B, Acc alpha, Acc beta)
+{
+	std::pair<size_t, size_t> dimensions = productDimensions(A, false, B);
+	if (beta != Acc(0) && C.getDimensions() != dimensions)throw std::range_error(R"(Accumulating into a matrix 
+		requires it already has the product dimensions: product has: )" + std::to_string(dimensions.first) +
+		", " + std::to_string(dimensions.second));
+	C.resize(dimensions.first, dimensions.second);
+	if (C.layout == MatrixLayout::ColumnMajor)
 	{
-		if (rhs.rows != this->rows)
-			throw std::range_error(R"(Right matrix with 1 column must match row size with left
-				matrix\n\t right matrix row size is: )" + std::to_string(rhs.rows));
-	}*/
-	else if (rhs.capacity == this->capacity)
+		//Column major C is the row major storage of C^T = B^T * A^T, the operands' transposes are only flags
+		C.flip();
+		productRows(B.transpose(), false, A.transpose(), alpha, beta, C, 0, C.rows);
+		C.flip();
+		return;
+	}
+	productRows(A, false, B, alpha, beta, C, 0, C.rows);
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::addOnesMultiply(BasicSerialMatrix& C, const View& A, const View& B, Activation activation)
+{
+	requireRowMajor(C, "addOnesMultiply");
+	std::pair<size_t, size_t> dimensions = productDimensions(A, true, B);
+	C.resize(dimensions.first, dimensions.second);
+	productRows(A, true, B, Acc(1), Acc(0), C, 0, C.rows, activation);
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::strassen(BasicSerialMatrix& C, const View& A, const View& B, size_t cutoff)
+{
+	if (C.layout != MatrixLayout::RowMajor || !strassenApplies(A, B, cutoff))
 	{
-		for (size_t i = 0; i < capacity; ++i)
-		{
-			temp.data[i] = data[i] + rhs.data[i];
-		}
+		gemm(C, A, B);
+		return;
 	}
-	else throw std::range_error(R"(Right matrix needs like component counts total, 
-		or 1 row with same columns, 
-		or 1 column with same rows
-		\n\t right matrix has dimensions: )" + std::to_string(rhs.rows) + ", " +
-		std::to_string(rhs.columns));
-	return temp;
+	size_t n = A.getDimensions().first;
+	C.resize(n, n);
+	size_t needed = TypedKernels<T, Acc>::strassenWorkspace(n, cutoff);
+	if (mStrassenWorkspace.size() < needed)mStrassenWorkspace.resize(needed);
+	TypedKernels<T, Acc>::gemmStrassen(n, A.getData(), A.getStride(), B.getData(), B.getStride(), C.data, C.stride, cutoff,
+		mStrassenWorkspace.data());
 }
 
-SerialMatrix& SerialMatrix::operator+=(const SerialMatrix& rhs)
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::multiplyBatched(std::vector<BasicSerialMatrix>& C, const std::vector<View>& A,
+	const std::vector<View>& B, bool addOnesA, Activation activation)
 {
-	//row or columns modifications only -- might extend, needed to run the NN for now
-	if (rhs.rows == 1)
+	uint64_t count = prepareBatched(C, A, B, addOnesA, activation);
+	batchedProducts(C, A, B, addOnesA, activation, 0, count);
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::addOnesTransposeMultiply(BasicSerialMatrix& C, const View& A, const View& B)
+{
+	requireRowMajor(C, "addOnesTransposeMultiply");
+	std::pair<size_t, size_t> dimensions = productDimensions(A.transpose(), false, B, true);
+	C.resize(dimensions.first, dimensions.second);
+	productRows(A.transpose(), false, B, Acc(1), Acc(0), C, 0, C.rows, Activation::None, true);
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::axpy(BasicSerialMatrix& Y, Acc a, const View& X)
+{
+	if (Y.getDimensions() != X.getDimensions())throw std::length_error(R"(Axpy requires the matrices have the same 
+		dimensions; Y has: )" + std::to_string(Y.rows) + ", " + std::to_string(Y.columns) + " while X has: " +
+		std::to_string(X.getDimensions().first) + ", " + std::to_string(X.getDimensions().second));
+	//X's storage lines up with Y's when X is transposed exactly when Y is column major
+	if (X.isTransposed() != (Y.layout == MatrixLayout::ColumnMajor))
 	{
-		if (rhs.columns != this->columns)
-			throw std::range_error(R"(Right matrix with 1 row must match column size with left
-				matrix\n\t right matrix column size is: )" + std::to_string(rhs.columns));
-		size_t curIndex = 0;
-		for (size_t i = 0; i < rows; ++i)
-		{
-			for (size_t j = 0; j < columns; ++j) //[[Potential Optimization Pending]]
-			{
-				data[curIndex++] += rhs.data[j];
-			}
-		}
+		Y += a * X;
+		return;
 	}
-	/*else if (rhs.columns == 1) //Not necessary for minimal viable product..
+	std::pair<size_t, size_t> dimensions = Y.getDimensions();
+	TypedKernels<T, Acc>::axpy(Y.lines(dimensions), Y.lineLength(dimensions), a, X.getData(), X.getStride(), Y.data, Y.stride);
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::elementwise(BasicSerialMatrix& C, ElementOp op, const BasicSerialMatrix& A,
+	const BasicSerialMatrix& B)
+{
+	//Assigning a single operator expression runs the kernels, and allocates nothing at a matching size
+	switch (op)
 	{
-		if (rhs.rows != this->rows)
-			throw std::range_error(R"(Right matrix with 1 column must match row size with left
-				matrix\n\t right matrix row size is: )" + std::to_string(rhs.rows));
-	}*/
-	else if (rhs.capacity == this->capacity)
+	case ElementOp::Add: C = MatrixBinary<BasicSerialMatrix, BasicSerialMatrix, ElementOp::Add>(A, B); break;
+	case ElementOp::Subtract: C = MatrixBinary<BasicSerialMatrix, BasicSerialMatrix, ElementOp::Subtract>(A, B); break;
+	case ElementOp::Multiply: C = MatrixBinary<BasicSerialMatrix, BasicSerialMatrix, ElementOp::Multiply>(A, B); break;
+	default: C = MatrixBinary<BasicSerialMatrix, BasicSerialMatrix, ElementOp::Divide>(A, B); break;
+	}
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::activateTanH(BasicSerialMatrix& out, const View& in)
+{
+	std::pair<size_t, size_t> dimensions = in.getDimensions();
+	out.resize(dimensions.first, dimensions.second);
+	if (out.layout == MatrixLayout::ColumnMajor)
 	{
-		for (size_t i = 0; i < capacity; ++i)
-		{
-			data[i] += rhs.data[i];
-		}
+		//Stored columns of out are rows of in transposed
+		out.flip();
+		activationRows(out, in.transpose(), 0, out.rows);
+		out.flip();
+		return;
 	}
-	else throw std::range_error(R"(Right matrix needs like component counts total, 
-		or 1 row with same columns, 
-		or 1 column with same rows
-		\n\t right matrix has dimensions: )" + std::to_string(rhs.rows) + ", " +
-		std::to_string(rhs.columns));
-	return *this;
+	activationRows(out, in, 0, dimensions.first);
 }
 
-SerialMatrix SerialMatrix::transpose(const SerialMatrix& ref, size_t rowStart)
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::activationRows(BasicSerialMatrix& out, const View& in, size_t rowBegin, size_t rowEnd)
 {
-	if (rowStart > ref.rows)throw std::range_error(R"(Row start must be less than row count 
-		for a reduced Transpose operation: matrix to transpose has: )"
-		+ std::to_string(ref.rows) + " but rowStart was set to: " + std::to_string(rowStart));
-	size_t col = ref.rows - rowStart;
-	SerialMatrix temp(ref.columns, col);
-	size_t offset = rowStart * ref.columns;
-	size_t cur = 0;
-	for (size_t i = 0; i < ref.columns; ++i)
-	{
-		size_t index = i;
-		for (size_t j = rowStart; j < ref.rows; ++j)
+	size_t columnCount = in.getDimensions().second;
+	if (in.isTransposed())
+	{
+		//The rows are stored columns of in, transposed into out by the blocked kernel then activated in place
+		TypedKernels<T, Acc>::transpose(columnCount, rowEnd - rowBegin, in.address(rowBegin, 0), in.getStride(),
+			out.data + rowBegin * out.stride, out.stride);
+		for (size_t i = rowBegin; i < rowEnd; ++i)
 		{
-			temp.data[cur] = ref.data[index + offset];
-			index += ref.columns;
-			++cur;
+			T* destination = out.data + i * out.stride;
+			TypedKernels<T, Acc>::activate(Activation::TanH, columnCount, destination, destination);
 		}
+		return;
+	}
+	for (size_t i = rowBegin; i < rowEnd; ++i)
+	{
+		TypedKernels<T, Acc>::activate(Activation::TanH, columnCount, in.address(i, 0), out.data + i * out.stride);
 	}
-	return temp;
 }
 
-SerialMatrix SerialMatrix::componentwise(const SerialMatrix& A, const SerialMatrix& B)
+template <typename T, typename Acc>
+size_t BasicSerialMatrix<T, Acc>::getCapacity() const
 {
-	if (A.capacity != B.capacity)throw std::length_error(R"(Componentwise multiplication of 
-		matrices requires the matrices have the same total cardinality;
-		A has: )" + std::to_string(A.capacity) + " while B has: " + std::to_string(B.capacity));
-	SerialMatrix temp(A.rows, A.columns);
-	for (size_t i = 0; i < A.capacity; ++i) temp.data[i] = A.data[i] * B.data[i];
-	return temp;
+	return capacity;
 }
 
-size_t SerialMatrix::getCapacity() const
+template <typename T, typename Acc>
+size_t BasicSerialMatrix<T, Acc>::getStride() const
 {
-	return capacity;
+	return stride;
 }
 
-std::pair<size_t, size_t> SerialMatrix::getDimensions() const
+template <typename T, typename Acc>
+const T* BasicSerialMatrix<T, Acc>::getData() const
+{
+	return data;
+}
+
+template <typename T, typename Acc>
+std::pair<size_t, size_t> BasicSerialMatrix<T, Acc>::getDimensions() const
 {
 	return std::pair<size_t, size_t>(rows, columns);
 }
 
-std::string SerialMatrix::getInfo() const
+template <typename T, typename Acc>
+std::string BasicSerialMatrix<T, Acc>::getInfo() const
 {
 	if (data == nullptr)return "No Data Stored";
 	std::string temp = "[";
@@ -371,143 +989,203 @@ std::string SerialMatrix::getInfo() const
 			if (i != 0) temp += '\n';
 		}
 		else temp += ",";
-		temp += std::to_string(data[i]);
+		temp += std::to_string(at(i / columns, i % columns));
 	}
 	temp += ']';
 	return temp;
 }
 
-float SerialMatrix::mean(const SerialMatrix& ref)
+template <typename T, typename Acc>
+Acc BasicSerialMatrix<T, Acc>::mean(const BasicSerialMatrix& ref)
 {
-	float temp = 0.0f;
-	for (size_t i = 0; i < ref.capacity; ++i)
-	{
-		temp += ref.data[i];
-	}
-	return temp / static_cast<float>(ref.capacity);
+	std::pair<size_t, size_t> dimensions = ref.getDimensions();
+	return TypedKernels<T, Acc>::sum(ref.lines(dimensions), ref.lineLength(dimensions), ref.data, ref.stride) /
+		static_cast<Acc>(ref.capacity);
 }
 
-void SerialMatrix::activateTanH()
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::activateTanH()
 {
-	for (size_t i = 0; i < capacity; ++i)
-	{
-		data[i] = std::tanh(data[i]);
-	}
+	activateTanH(*this, *this);
 }
 
-SerialMatrix SerialMatrix::mean(const SerialMatrix& ref, bool row)
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc> BasicSerialMatrix<T, Acc>::mean(const View& ref, bool row)
 {
+	//Means along the rows of a transposed view are means along the columns of its storage
+	if (ref.isTransposed())return mean(ref.transpose(), !row);
+	size_t refRows = ref.getDimensions().first, refColumns = ref.getDimensions().second;
 	if (row)
 	{
-		SerialMatrix temp(1, ref.rows);
-		float inv = 1.0f / static_cast<float>(ref.columns);
-		for (size_t i = 0; i < ref.rows; ++i)
+		BasicSerialMatrix temp(1, refRows);
+		Acc inv = Acc(1) / static_cast<Acc>(refColumns);
+		for (size_t i = 0; i < refRows; ++i)
 		{
-			float cur = 0.0f;
-			size_t curIndex = 0;
-			for (size_t j = 0; j < ref.columns; ++j)
-			{
-				cur += ref.data[curIndex++];
-			}
-			temp.data[i] = cur * inv;
+			temp.data[i] = static_cast<T>(TypedKernels<T, Acc>::sum(1, refColumns, ref.address(i, 0), refColumns) * inv);
 		}
 		return temp;
 	}
 	else
 	{
-		SerialMatrix temp(1, ref.columns);
-		float inv = 1.0f / static_cast<float>(ref.rows);
-		for (size_t i = 0; i < ref.columns; ++i)
-		{
-			float cur = 0.0f;
-			size_t curIndex = 0;
-			for (size_t j = 0; j < ref.rows; ++j)
-			{
-				cur += ref.data[curIndex];
-				curIndex += ref.columns;
-			}
-			temp.data[i] = cur * inv;
-		}
+		//Whole rows accumulated at a time rather than striding down each column, summed in Acc and rounded once
+		BasicSerialMatrix temp(1, refColumns);
+		std::vector<Acc> sums(refColumns, Acc(0));
+		TypedKernels<T, Acc>::columnSums(refRows, refColumns, ref.getData(), ref.getStride(), sums.data());
+		Acc inv = Acc(1) / static_cast<Acc>(refRows);
+		for (size_t i = 0; i < refColumns; ++i)temp.data[i] = static_cast<T>(sums[i] * inv);
 		return temp;
 	}
 }
 
-SerialMatrix SerialMatrix::standardDeviations(const SerialMatrix& ref, bool row)
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc> BasicSerialMatrix<T, Acc>::standardDeviations(const View& ref, bool row)
 {
-	if (row)
+	BasicSerialMatrix mean, deviation;
+	statistics(mean, deviation, ref, row);
+	return deviation;
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::statistics(BasicSerialMatrix& mean, BasicSerialMatrix& deviation, const View& ref, bool row)
+{
+	if (ref.isTransposed())return statistics(mean, deviation, ref.transpose(), !row);
+	std::vector<Acc> means, m2s;
+	uint64_t blocks = prepareStatistics(ref, row, means, m2s);
+	statisticsBlocks(ref, row, 0, blocks, means.data(), m2s.data());
+	mergeStatistics(ref, row, means.data(), m2s.data(), mean, deviation);
+}
+
+template <typename T, typename Acc>
+uint64_t BasicSerialMatrix<T, Acc>::prepareStatistics(const View& ref, bool row, std::vector<Acc>& means, std::vector<Acc>& m2s)
+{
+	size_t refRows = ref.getDimensions().first, refColumns = ref.getDimensions().second;
+	uint64_t blocks = (refRows + MATRIX_STATISTICS_BLOCK - 1) / MATRIX_STATISTICS_BLOCK;
+	size_t count = row ? refRows : blocks * refColumns;
+	means.assign(count, Acc(0));
+	m2s.assign(count, Acc(0));
+	return blocks;
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::statisticsBlocks(const View& ref, bool row, uint64_t start, uint64_t end, Acc* means, Acc* m2s)
+{
+	size_t refRows = ref.getDimensions().first, refColumns = ref.getDimensions().second;
+	for (uint64_t b = start; b < end; ++b)
 	{
-		SerialMatrix temp = SerialMatrix::mean(ref, row);
-		for (size_t i = 0; i < ref.rows; ++i)
+		size_t rowBegin = b * MATRIX_STATISTICS_BLOCK, rowEnd = std::min(rowBegin + MATRIX_STATISTICS_BLOCK, refRows);
+		if (row)
 		{
-			float squareMeanDifference = 0.0f;
-			size_t curIndex = 0;
-			for (size_t j = 0; j < ref.columns; ++j)
+			//A row is still in cache for its second pass, so each row keeps the two pass mean then deviation
+			Acc inv = Acc(1) / static_cast<Acc>(refColumns);
+			for (size_t i = rowBegin; i < rowEnd; ++i)
 			{
-				float diff = ref.data[curIndex++] - temp.data[i];
-				squareMeanDifference = diff * diff;
+				const T* values = ref.address(i, 0);
+				Acc mean = TypedKernels<T, Acc>::sum(1, refColumns, values, refColumns) * inv, squareMeanDifference = Acc(0);
+				for (size_t j = 0; j < refColumns; ++j)
+				{
+					Acc diff = static_cast<Acc>(values[j]) - mean;
+					squareMeanDifference += diff * diff;
+				}
+				means[i] = mean;
+				m2s[i] = squareMeanDifference;
 			}
-			temp.data[i] = std::sqrt(squareMeanDifference / ref.columns);
 		}
-		return temp;
+		else
+		{
+			TypedKernels<T, Acc>::columnMoments(rowEnd - rowBegin, refColumns, ref.address(rowBegin, 0), ref.getStride(), 0,
+				means + b * refColumns, m2s + b * refColumns);
+		}
 	}
-	else
+}
+
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::mergeStatistics(const View& ref, bool row, Acc* means, Acc* m2s,
+	BasicSerialMatrix& mean, BasicSerialMatrix& deviation)
+{
+	size_t refRows = ref.getDimensions().first, refColumns = ref.getDimensions().second;
+	size_t count = row ? refRows : refColumns;
+	if (!row)
 	{
-		SerialMatrix temp = SerialMatrix::mean(ref, row);
-		for (size_t i = 0; i < ref.columns; ++i)
+		//Chan et al., blocks folded into the first in order: with delta = mean b - mean a over n = na + nb rows
+		//	mean = mean a + delta * nb / n and m2 = m2 a + m2 b + delta^2 * na * nb / n
+		size_t seen = std::min<size_t>(MATRIX_STATISTICS_BLOCK, refRows);
+		for (size_t rowBegin = seen; rowBegin < refRows; rowBegin += MATRIX_STATISTICS_BLOCK)
 		{
-			float squareMeanDifference = 0.0f;
-			size_t curIndex = 0;
-			for (size_t j = 0; j < ref.rows; ++j)
+			size_t blockRows = std::min<size_t>(MATRIX_STATISTICS_BLOCK, refRows - rowBegin), total = seen + blockRows;
+			const Acc* blockMeans = means + (rowBegin / MATRIX_STATISTICS_BLOCK) * refColumns;
+			const Acc* blockM2s = m2s + (rowBegin / MATRIX_STATISTICS_BLOCK) * refColumns;
+			Acc weight = static_cast<Acc>(blockRows) / static_cast<Acc>(total);
+			Acc product = static_cast<Acc>(seen) * weight;
+			for (size_t j = 0; j < refColumns; ++j)
 			{
-				float diff = ref.data[curIndex] - temp.data[i];
-				squareMeanDifference += diff * diff;
-				curIndex += ref.columns;
+				Acc delta = blockMeans[j] - means[j];
+				means[j] += delta * weight;
+				m2s[j] += blockM2s[j] + delta * delta * product;
 			}
-			temp.data[i] = std::sqrt(squareMeanDifference / ref.rows);
+			seen = total;
 		}
-		return temp;
+	}
+	mean.resize(1, count);
+	deviation.resize(1, count);
+	Acc inv = Acc(1) / static_cast<Acc>(row ? refColumns : refRows);
+	for (size_t i = 0; i < count; ++i)
+	{
+		mean.data[i] = static_cast<T>(means[i]);
+		deviation.data[i] = static_cast<T>(std::sqrt(m2s[i] * inv));
 	}
 }
 
-SerialMatrix SerialMatrix::square(const SerialMatrix& ref)
+//Do not need all of the features from other linear algebra libraries
+//	Just including what is necessary to run the Neural Network class.
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc> BasicSerialMatrix<T, Acc>::addOnes(const BasicSerialMatrix& ref)
 {
-	SerialMatrix temp(ref.rows, ref.columns);
-	for (size_t i = 0; i < ref.capacity; ++i)
+	BasicSerialMatrix temp(ref.rows, ref.columns + 1);
+	addOnesRows(temp, ref.view(), 0, ref.rows);
+	return temp;
+}
+
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc> BasicSerialMatrix<T, Acc>::addOnes(BasicSerialMatrix&& ref)
+{
+	if (ref.layout != MatrixLayout::RowMajor || ref.data == nullptr || ref.stride != strideFor(ref.columns + 1))return addOnes(ref);
+	//Each row moves one element right, within its own stride, so rows never overlap
+	for (size_t i = 0; i < ref.rows; ++i)
 	{
-		temp.data[i] = ref.data[i] * ref.data[i];
+		T* row = ref.data + i * ref.stride;
+		std::copy_backward(row, row + ref.columns, row + ref.columns + 1);
+		row[0] = T(1);
 	}
-	return temp;
+	++ref.columns;
+	ref.capacity = ref.rows * ref.columns;
+	return BasicSerialMatrix(std::move(ref));
 }
 
-//Do not need all of the features from other linear algebra libraries
-//	Just including what is necessary to run the Neural Network class.
-SerialMatrix SerialMatrix::addOnes(const SerialMatrix& ref)
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::addOnesRows(BasicSerialMatrix& out, const View& in, size_t rowBegin, size_t rowEnd)
 {
-	SerialMatrix temp(ref.rows, ref.columns + 1);
-	size_t columnCount = 0;// ref.columns;
-	size_t curIndex = 0;
-	for (size_t i = 0; i < ref.capacity; ++i)
+	size_t columnCount = in.getDimensions().second;
+	for (size_t i = rowBegin; i < rowEnd; ++i)
 	{
-		if (columnCount == 0)
+		T* row = out.data + i * out.stride;
+		row[0] = T(1);
+		if (in.isTransposed())
 		{
-			temp.data[curIndex] = 1.0f;
-			++curIndex;
-			columnCount = ref.columns;
+			for (size_t j = 0; j < columnCount; ++j)row[j + 1] = *in.address(i, j);
+			continue;
 		}
-		temp.data[curIndex] = ref.data[i];
-		++curIndex;
-		--columnCount;
+		std::copy(in.address(i, 0), in.address(i, 0) + columnCount, row + 1);
 	}
-	return temp;
 }
 
-void SerialMatrix::deepCopy(const SerialMatrix& cp, bool allocate)
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::deepCopy(const BasicSerialMatrix& cp, bool allocate)
 {
 	bool cleanStart = true;
 	if (allocate || data == nullptr) {}
 	else
 	{
-		if (capacity == cp.capacity)
+		if (storage() == cp.storage())
 		{
 			cleanStart = false;
 		}
@@ -515,85 +1193,72 @@ void SerialMatrix::deepCopy(const SerialMatrix& cp, bool allocate)
 	rows = cp.rows;
 	columns = cp.columns;
 	capacity = cp.capacity;
+	stride = cp.stride;
+	layout = cp.layout;
 	if (cleanStart)
 	{
-		delete[] data;
-		data = new (std::nothrow)float[capacity];
+		release(data);
+		data = BasicSerialMatrix::allocate(storage());
 		if (data == nullptr)throw std::bad_alloc();//"Serial Matrix class, bad allocation on Matrix DeepCopy"
 	}
-	for (size_t i = 0; i < capacity; ++i)
+	//Stored rows, or columns, as they are in cp
+	size_t count = lines(getDimensions()), length = lineLength(getDimensions());
+	for (size_t i = 0; i < count; ++i)
 	{
-		data[i] = cp.data[i];
+		std::copy(cp.data + i * stride, cp.data + i * stride + length, data + i * stride);
 	}
 }
 
-void SerialMatrix::deepCopy(const std::vector<std::vector<float>>& values, bool allocate)
+template <typename T, typename Acc>
+void BasicSerialMatrix<T, Acc>::deepCopy(const std::vector<std::vector<Acc>>& values, bool allocate)
 {
 	bool cleanStart = true;
 	if (allocate || data == nullptr) {}
 	else
 	{
-		if (capacity == (values.size() * values[0].size()))
+		if (storage() == (values.size() * strideFor(values[0].size())))
 		{
 			cleanStart = false;
 		}
 	}
+	layout = MatrixLayout::RowMajor;
 	rows = static_cast<size_t>(values.size());
 	columns = static_cast<size_t>(values[0].size());
 	capacity = rows * columns;
+	stride = strideFor(columns);
 	if (cleanStart)
 	{
-		delete[] data;
-		data = new (std::nothrow)float[capacity];
+		release(data);
+		data = BasicSerialMatrix::allocate(storage());
 		if (data == nullptr)throw std::bad_alloc();//"Serial Matrix class, bad allocation on STD::Vector DeepCopy"
 	}
 	for (auto itr = values.begin(); itr != values.end(); ++itr)
 	{
 		for (auto jtr = itr->begin(); jtr != itr->end(); ++jtr)
 		{
-			//Row major in flattened indexing
-			data[(itr - values.begin()) * columns + (jtr - itr->begin())] = *jtr;
+			//Row major, rows stride apart
+			data[(itr - values.begin()) * stride + (jtr - itr->begin())] = static_cast<T>(*jtr);
 		}
 	}
 }
 
-std::ostream& operator<<(std::ostream& out, const SerialMatrix& mat)
-{
-	return out << mat.getInfo();
-}
-
-bool operator==(const SerialMatrix& A, const SerialMatrix& B)
+template <typename T, typename Acc>
+bool operator==(const BasicSerialMatrix<T, Acc>& A, const BasicSerialMatrix<T, Acc>& B)
 {
 	if (A.capacity != B.capacity)return false;
 	for (size_t i = 0; i < A.capacity; ++i)
 	{
-		if (A.data[i] != B.data[i])return false;
+		if (A.at(i / A.columns, i % A.columns) != B.at(i / B.columns, i % B.columns))return false;
 	}
 	return true;
 }
 
-SerialMatrix operator-(const float lhs, const SerialMatrix& rhs)
-{
-	SerialMatrix temp(rhs.rows, rhs.columns);
-	for (size_t i = 0; i < rhs.capacity; ++i)
-	{
-		temp.data[i] = lhs - rhs.data[i];
-	}
-	return temp;
-}
-
-SerialMatrix operator/(const float lhs, const SerialMatrix& rhs)
-{
-	float inv = 1.0f / lhs;
-	return inv * rhs;
-}
-
-SerialMatrix operator*(const float lhs, const SerialMatrix& rhs)
-{
-	SerialMatrix temp(rhs.rows, rhs.columns);
-	for (size_t i = 0; i < rhs.capacity; ++i)
-	{
-		temp.data[i] = lhs * rhs.data[i];
-	}
-	return temp;
-}
\ No newline at end of file
+//The element types the library is built for, see MatrixTypes.hpp
+template class BasicSerialMatrix<float>;
+template class BasicSerialMatrix<double>;
+template class BasicSerialMatrix<BFloat16>;
+template class BasicSerialMatrix<Float16>;
+template bool operator==(const BasicSerialMatrix<float>& A, const BasicSerialMatrix<float>& B);
+template bool operator==(const BasicSerialMatrix<double>& A, const BasicSerialMatrix<double>& B);
+template bool operator==(const BasicSerialMatrix<BFloat16>& A, const BasicSerialMatrix<BFloat16>& B);
+template bool operator==(const BasicSerialMatrix<Float16>& A, const BasicSerialMatrix<Float16>& B);
\ No newline at end of file
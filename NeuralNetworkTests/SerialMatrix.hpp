@@ -1,14 +1,22 @@
 /*
 Author: Dan Rehberg
-Modified Date: 12/9/2022
+Modified Date: 10/19/2026
 Purpose: Serial Matrix class build from the prior tested ParallelMatrix class.
 	2D matrix for the Neural Network structure being built.
 	2D works because it is merely vectors of features, stacked by the number of samples gathered.
+	BasicSerialMatrix<T, Acc> stores T and computes in Acc (MatrixTypes.hpp), SerialMatrix is the float one the networks use.
+		Definitions are in SerialMatrix.cpp and instantiated there for float, double, BFloat16 and Float16 storage
+		with their default accumulators; another pairing needs its own line at the end of that file.
+	A matrix is row major unless constructed or converted (setLayout) column major; the layout only changes when asked.
+		at(row, column), dimensions, and views read the same either way: a column major matrix's view is the transposed view
+		of its storage, so products, statistics and transposes fold the layout in as they fold in any transposed view.
+		Elementwise expressions walk storage when every matrix in them is stored as the destination, tiles otherwise.
 */
 
 #ifndef __SERIAL_MATRIX__
 #define __SERIAL_MATRIX__
 
+#include <algorithm>
 #include <array>
 #include <string>
 #include <vector>
@@ -19,96 +27,575 @@ Purpose: Serial Matrix class build from the prior tested ParallelMatrix class.
 #include <new>
 #include <exception>
 #include <cmath>
+#include <cstdint>
+#include "MatrixExpressions.hpp"
+#include "MatrixTypes.hpp"
+#include "MatrixView.hpp"
+#include "TypedKernels.hpp"
+
+//Every buffer starts on a cache line, which is also the widest vector load (AVX-512)
+#define MATRIX_ALIGNMENT 64
+//Rows of at least this many floats (64 bytes) are padded to a multiple of it, so each row starts on a cache line
+//	other element types pad to the same byte counts
+#define MATRIX_STRIDE_MULTIPLE 16
+//A stride that is a multiple of this many floats (1KB) maps the same column of consecutive rows
+//	onto a handful of cache sets, such strides get one more cache line of padding
+#define MATRIX_SET_PERIOD 256
+//Rows per Welford block of statistics, partial means are merged per block (Chan) so float error grows with the block
+//	rather than the whole matrix, and blocks are the tasks of the parallel form
+#define MATRIX_STATISTICS_BLOCK 256
+//Below this many elements (128KB of floats) elementwise work on the pool costs more in the dispatch than it saves
+#define MATRIX_PARALLEL_THRESHOLD (1 << 15)
+//Square products of at least this size recurse with Strassen-Winograd in strassen(), measured with KernelBenchmarks::strassen
+#define MATRIX_STRASSEN_CUTOFF 1024
+
+template <typename T, typename Acc>
+class BasicSparseMatrix;
+template <typename T, typename Acc>
+class BasicDatasetLoader;
 
 //Is just a 2D matrix class to start playing around with Neural Networks in C++
-class SerialMatrix
+//	Elementwise arithmetic is lazy, see MatrixExpressions.hpp
+template <typename T, typename Acc>
+class BasicSerialMatrix : public MatrixExpression<BasicSerialMatrix<T, Acc>>
 {
 public:
-	SerialMatrix();//Used to explicitly instantiate variables
-	SerialMatrix(size_t rows, size_t columns);//POD, could used fixed length if so desired
-	template <size_t T, size_t S>
-	SerialMatrix(const std::array<std::array<float, S>, T>& array2D)
+	typedef T Element;//as stored
+	typedef Acc Value;//as computed, what at() returns and what the containers below hold
+	typedef BasicSerialMatrix Result;
+	typedef BasicMatrixView<T, Acc> View;
+	BasicSerialMatrix();//Used to explicitly instantiate variables
+	BasicSerialMatrix(size_t rows, size_t columns, MatrixLayout layout = MatrixLayout::RowMajor);//POD, could used fixed length if so desired
+	template <size_t N, size_t M>
+	BasicSerialMatrix(const std::array<std::array<Acc, M>, N>& array2D) : BasicSerialMatrix()
 	{
 		if ((array2D.size() * array2D[0].size()) == 0)throw std::length_error("(array copy) Cannot have a matrix with zero elements");
 		deepCopy(array2D);
 	}
-	SerialMatrix(const std::vector<std::vector<float>>& vector2D);
-	SerialMatrix(const SerialMatrix& cp);
-	SerialMatrix(SerialMatrix&& rhs);
-	~SerialMatrix();
-	SerialMatrix& operator=(const SerialMatrix& cp);//!!DATA MODIFICATION!! -- managed through deep copy
-	SerialMatrix& operator=(SerialMatrix&& rhs);
-	template <size_t T, size_t S>
-	SerialMatrix& operator=(const std::array<std::array<float, S>, T>& array2D)
+	BasicSerialMatrix(const std::vector<std::vector<Acc>>& vector2D);
+	BasicSerialMatrix(const BasicSerialMatrix& cp);
+	BasicSerialMatrix(BasicSerialMatrix&& rhs);
+	template <typename E>
+	BasicSerialMatrix(const MatrixExpression<E>& expression, MatrixLayout order = MatrixLayout::RowMajor) : BasicSerialMatrix()
+	{
+		std::pair<size_t, size_t> dimensions = expression.self().getDimensions();
+		if ((dimensions.first * dimensions.second) == 0)throw std::length_error("(expression copy) Cannot have a matrix with zero elements");
+		layout = order;
+		size_t ld = strideFor(lineLength(dimensions));
+		BasicSerialMatrix* leaf = expiringBuffer(expression.self(), dimensions);
+		if (leaf != nullptr)
+		{
+			evaluateLayout(expression.self(), leaf->data, ld, layout);
+			*this = std::move(*leaf);
+			return;
+		}
+		data = allocate(lines(dimensions) * ld);
+		if (data == nullptr)throw std::bad_alloc();//"Serial Matrix class, bad allocation on Expression Constructor"
+		evaluateLayout(expression.self(), data, ld, layout);
+		rows = dimensions.first;
+		columns = dimensions.second;
+		capacity = rows * columns;
+		stride = ld;
+	}
+	~BasicSerialMatrix();
+	BasicSerialMatrix& operator=(const BasicSerialMatrix& cp);//!!DATA MODIFICATION!! -- managed through deep copy
+	BasicSerialMatrix& operator=(BasicSerialMatrix&& rhs);
+	template <size_t N, size_t M>
+	BasicSerialMatrix& operator=(const std::array<std::array<Acc, M>, N>& array2D)
 	{
 		if ((array2D.size() * array2D[0].size()) == 0)throw std::length_error("(array =) Cannot have a matrix with zero elements");
 		deepCopy(array2D, false);
+		return *this;
 	}
-	SerialMatrix& operator=(const std::vector<std::vector<float>>& vector2D);
-	friend bool operator==(const SerialMatrix& A, const SerialMatrix& B);
-	friend SerialMatrix operator-(const float lhs, const SerialMatrix& rhs);
-	friend SerialMatrix operator/(const float lhs, const SerialMatrix& rhs);
-	friend SerialMatrix operator*(const float lhs, const SerialMatrix& rhs);
-	SerialMatrix operator*(const SerialMatrix& rhs) const;
-	SerialMatrix operator-(const SerialMatrix& rhs) const;
-	SerialMatrix operator/(const SerialMatrix& rhs) const;
-	SerialMatrix operator+(const SerialMatrix& rhs) const;
-	SerialMatrix& operator+=(const SerialMatrix& rhs);
-	size_t getCapacity() const;
+	BasicSerialMatrix& operator=(const std::vector<std::vector<Acc>>& vector2D);
+	template <typename E>
+	BasicSerialMatrix& operator=(const MatrixExpression<E>& expression)//!!DATA MODIFICATION!! -- the expression may read this matrix (in place unless readsAcross), the layout is kept
+	{
+		std::pair<size_t, size_t> dimensions = expression.self().getDimensions();
+		size_t ld = strideFor(lineLength(dimensions));
+		if (data != nullptr && storage() == lines(dimensions) * ld && !readsAcross(expression.self(), target(data, ld, dimensions)))
+		{
+			evaluateLayout(expression.self(), data, ld, layout);
+		}
+		else if (BasicSerialMatrix* leaf = expiringBuffer(expression.self(), dimensions))
+		{
+			evaluateLayout(expression.self(), leaf->data, ld, layout);
+			return *this = std::move(*leaf);
+		}
+		else
+		{
+			//Old buffer kept until the expression has been read
+			T* fresh = allocate(lines(dimensions) * ld);
+			if (fresh == nullptr)throw std::bad_alloc();//"Serial Matrix class, bad allocation on Expression ="
+			evaluateLayout(expression.self(), fresh, ld, layout);
+			release(data);
+			data = fresh;
+		}
+		rows = dimensions.first;
+		columns = dimensions.second;
+		capacity = rows * columns;
+		stride = ld;
+		return *this;
+	}
+	template <typename E>
+	BasicSerialMatrix& operator+=(const MatrixExpression<E>& expression)
+	{
+		if (readsAcross(expression.self(), target(data, stride, getDimensions())))
+			return *this = MatrixBinary<BasicSerialMatrix, E, ElementOp::Add>(*this, expression.self());
+		evaluateLayout(MatrixBinary<BasicSerialMatrix, E, ElementOp::Add>(*this, expression.self()), data, stride, layout);
+		return *this;
+	}
+	template <typename U, typename V>
+	friend bool operator==(const BasicSerialMatrix<U, V>& A, const BasicSerialMatrix<U, V>& B);
+	template <typename U, typename V>
+	friend class BasicSparseMatrix;//Sparse products write rows of their dense result
+	template <typename U, typename V>
+	friend class BasicDatasetLoader;//Parsed values are stored straight into the destinations
+	BasicSerialMatrix operator*(const BasicSerialMatrix& rhs) const;
+	size_t getCapacity() const;//rows * columns, the padding is not counted
+	size_t getStride() const;//Elements from one stored row (column when column major) to the next
+	const T* getData() const;//Read only access, e.g., for locking or prefaulting the buffer (storage lines * stride elements)
 	std::pair<size_t, size_t> getDimensions() const;
+	MatrixLayout getLayout() const;
+	//!!DATA MODIFICATION!! -- the elements are kept and restored in the other order (square matrices in place), views are invalidated
+	void setLayout(MatrixLayout order);
 	std::string getInfo() const;
+	Acc at(size_t row, size_t column) const
+	{
+		return static_cast<Acc>(layout == MatrixLayout::RowMajor ? data[row * stride + column] : data[column * stride + row]);
+	}
+	Acc get(size_t row, size_t column) const { return static_cast<Acc>(data[row * stride + column]); }//Expression leaf, storage order
+	bool contiguous() const { return stride == lineLength(getDimensions()); }
+	unsigned int leaves() const { return layout == MatrixLayout::RowMajor ? LeafRowMajor : LeafColumnMajor; }
+	View view() const//The whole matrix, slice it from here
+	{
+		return layout == MatrixLayout::RowMajor ? View(data, rows, columns, stride) : View(data, columns, rows, stride).transpose();
+	}
+	operator View() const { return view(); }
 	void activateTanH();
-	static float mean(const SerialMatrix& ref);//total arithmetic mean
-	static SerialMatrix mean(const SerialMatrix& ref, bool row);//row or column arithmetic means
-	static SerialMatrix standardDeviations(const SerialMatrix& ref, bool row);//row true means mean of each row
-	static SerialMatrix square(const SerialMatrix& ref);
+	static Acc mean(const BasicSerialMatrix& ref);//total arithmetic mean
+	template <typename E>
+	static Acc mean(const MatrixExpression<E>& expression)//total arithmetic mean, summed as it is evaluated
+	{
+		return static_cast<Acc>(sumExpression(expression.self())) / static_cast<Acc>(expression.self().getCapacity());
+	}
+	static BasicSerialMatrix mean(const View& ref, bool row);//row or column arithmetic means
+	static BasicSerialMatrix standardDeviations(const View& ref, bool row);//row true means deviation of each row, a statistics call
+	//Means and (population) standard deviations of each row or column together, ref is read once
+	//	columns fold blocks of MATRIX_STATISTICS_BLOCK rows in with Welford and merge the blocks in order with Chan's formula,
+	//	so the serial and parallel forms below give the same bits
+	static void statistics(BasicSerialMatrix& mean, BasicSerialMatrix& deviation, const View& ref, bool row);
+	template <typename E>
+	static MatrixSquare<E> square(const MatrixExpression<E>& ref)
+	{
+		return MatrixSquare<E>(ref.self());
+	}
+	static MatrixSquare<MatrixExpiring<BasicSerialMatrix>> square(BasicSerialMatrix&& ref)
+	{
+		return MatrixSquare<MatrixExpiring<BasicSerialMatrix>>(MatrixExpiring<BasicSerialMatrix>(ref));
+	}
 	//static SerialMatrix sqaureroot(const SerialMatrix& ref);
-	static SerialMatrix addOnes(const SerialMatrix& ref);
-	static SerialMatrix transpose(const SerialMatrix& ref, size_t rowStart = 0);
-	static SerialMatrix componentwise(const SerialMatrix& A, const SerialMatrix& B);
+	static BasicSerialMatrix addOnes(const BasicSerialMatrix& ref);
+	static BasicSerialMatrix addOnes(BasicSerialMatrix&& ref);//Rows shift into ref's padding when it has room for the column
+	static BasicSerialMatrix transpose(const BasicSerialMatrix& ref, size_t rowStart = 0);//A copy, ref.view().rowSlice(rowStart, rows).transpose() reads in place
+	static void transpose(BasicSerialMatrix& out, const View& in);//Tiled copy of in transposed, out must not share in's storage
+	void transposeInPlace();//!!DATA MODIFICATION!! -- square matrices swap mirrored tiles in place, others go through a new buffer
+	template <typename L, typename R>
+	static MatrixBinary<L, R, ElementOp::Multiply> componentwise(const MatrixExpression<L>& A, const MatrixExpression<R>& B)
+	{
+		return MatrixBinary<L, R, ElementOp::Multiply>(A.self(), B.self(), false);
+	}
+	template <typename R>
+	static MatrixBinary<MatrixExpiring<BasicSerialMatrix>, R, ElementOp::Multiply> componentwise(BasicSerialMatrix&& A,
+		const MatrixExpression<R>& B)
+	{
+		return MatrixBinary<MatrixExpiring<BasicSerialMatrix>, R, ElementOp::Multiply>(MatrixExpiring<BasicSerialMatrix>(A), B.self(), false);
+	}
+	template <typename L>
+	static MatrixBinary<L, MatrixExpiring<BasicSerialMatrix>, ElementOp::Multiply> componentwise(const MatrixExpression<L>& A,
+		BasicSerialMatrix&& B)
+	{
+		return MatrixBinary<L, MatrixExpiring<BasicSerialMatrix>, ElementOp::Multiply>(A.self(), MatrixExpiring<BasicSerialMatrix>(B), false);
+	}
+	static MatrixBinary<MatrixExpiring<BasicSerialMatrix>, MatrixExpiring<BasicSerialMatrix>, ElementOp::Multiply> componentwise(
+		BasicSerialMatrix&& A, BasicSerialMatrix&& B)
+	{
+		return MatrixBinary<MatrixExpiring<BasicSerialMatrix>, MatrixExpiring<BasicSerialMatrix>, ElementOp::Multiply>(
+			MatrixExpiring<BasicSerialMatrix>(A), MatrixExpiring<BasicSerialMatrix>(B), false);
+	}
+	//op(A) * op(B) read in place, op transposes when its flag is set; rowStartB skips leading rows of B as in transpose
+	static BasicSerialMatrix multiply(const BasicSerialMatrix& A, bool transposeA, const BasicSerialMatrix& B, bool transposeB,
+		size_t rowStartB = 0);
+	static BasicSerialMatrix addOnesTransposeMultiply(const BasicSerialMatrix& A, const BasicSerialMatrix& B);//transpose(addOnes(A)) * B, neither built
+	//Products below read their operands through views, so transposes and slices are folded in rather than copied
+	//Destination passing, nothing is allocated unless the destination's storage (rows * stride) has to change
+	//	so a steady state training epoch allocates nothing; destinations must not alias product operands
+	void resize(size_t rows, size_t columns);//!!DATA MODIFICATION!! -- contents are kept only when the storage is unchanged, as is the layout
+	static void gemm(BasicSerialMatrix& C, const View& A, const View& B, Acc alpha = Acc(1),
+		Acc beta = Acc(0));//C = alpha * A * B + beta * C, a column major C as C^T = B^T * A^T
+	//The bias and activation are written along rows of C, so these two throw on a column major C
+	//C = activation(addOnes(A) * B), the first row of B is a bias added with the activation as each tile of C is written
+	//	B may be column major (or a transposed view), e.g., a layer's weights, its first row is then packed once per call
+	static void addOnesMultiply(BasicSerialMatrix& C, const View& A, const View& B, Activation activation = Activation::None);
+	static void addOnesTransposeMultiply(BasicSerialMatrix& C, const View& A, const View& B);//C = transpose(addOnes(A)) * B
+	//C = A * B with Strassen-Winograd for square untransposed float or double operands of at least cutoff, gemm for anything else
+	//	Fewer multiplies (n^2.81) at the cost of error growing with the recursion depth, so it is only used where asked for
+	static void strassen(BasicSerialMatrix& C, const View& A, const View& B, size_t cutoff = MATRIX_STRASSEN_CUTOFF);
+	//Many small independent products, C[p] = activation(A[p] * B[p]) or activation(addOnes(A[p]) * B[p]) as addOnesMultiply
+	//	A or B of a single view is shared by every product, e.g., one input against a sweep of models' weights
+	//	C is resized to the batch and each destination to its product, so a steady state batch allocates nothing
+	static void multiplyBatched(std::vector<BasicSerialMatrix>& C, const std::vector<View>& A, const std::vector<View>& B,
+		bool addOnesA = false, Activation activation = Activation::None);
+	static void axpy(BasicSerialMatrix& Y, Acc a, const View& X);//Y += a * X
+	static void elementwise(BasicSerialMatrix& C, ElementOp op, const BasicSerialMatrix& A,
+		const BasicSerialMatrix& B);//C = A op B, B may be a broadcast row, C may be A
+	static void activateTanH(BasicSerialMatrix& out, const View& in);//out may be in, either layout
 	//Parallel operations
-	static SerialMatrix* mA, * mB, mC;
-	static void setParallelMatrixOps(SerialMatrix& matA, SerialMatrix& matB, bool multiplication = true);
-	static void parallelDotProducts(std::mutex& m, unsigned int taskIndex);//Dot product managed per thread
-	static SerialMatrix&& moveParallelResult();
+	static BasicSerialMatrix* mA, * mB, mC;
+	static void setParallelMatrixOps(BasicSerialMatrix& matA, BasicSerialMatrix& matB, bool multiplication = true);
+	static void parallelDotProducts(std::mutex& m, uint64_t taskIndex);//Dot product managed per thread
+	static void parallelDotProductRange(std::mutex& m, uint64_t startTask, uint64_t endTask);//Contiguous components per thread, a row's share at a time through the vector kernels
+	//As multiply, addOnesA builds addOnes(A) into the product after any transpose of A, as addOnesMultiply;
+	//	returns the row count of C to dispatch, 0 when C has one row, which is computed by the call
+	static uint64_t setParallelProductOps(BasicSerialMatrix& matA, bool transposeA, BasicSerialMatrix& matB, bool transposeB,
+		size_t rowStartB = 0, bool addOnesA = false);
+	static uint64_t setParallelProductOps(BasicSerialMatrix& C, BasicSerialMatrix& matA, bool transposeA, BasicSerialMatrix& matB,
+		bool transposeB, size_t rowStartB = 0, bool addOnesA = false);//Result written to C rather than mC
+	static uint64_t setParallelProductOps(BasicSerialMatrix& C, const View& A, const View& B,
+		bool addOnesA = false, Activation activation = Activation::None);//Views must stay valid until the dispatch returns
+	static uint64_t setParallelAddOnesTransposeOps(BasicSerialMatrix& C, const View& A,
+		const View& B);//C = transpose(addOnes(A)) * B as addOnesTransposeMultiply, rows to dispatch as above
+	static void parallelProductRows(std::mutex& m, uint64_t startRow, uint64_t endRow);//Rows of C per thread, blocked GEMM per range
+	static BasicSerialMatrix&& moveParallelResult();
+	//strassen on the pool: the top level's 7 products are the tasks to parallelRange, each recursing on its own thread,
+	//	then mergeParallelStrassen adds them into C; where strassen would run gemm the tasks are rows of C and the merge does nothing
+	static uint64_t setParallelStrassenOps(BasicSerialMatrix& C, const View& A, const View& B, size_t cutoff = MATRIX_STRASSEN_CUTOFF);
+	static void mergeParallelStrassen();
+	//multiplyBatched on the pool: whole products are the tasks to parallelRange, rather than rows of one product,
+	//	since splitting a product as small as the {10, 5} network's costs more in the dispatch than it saves
+	//	The vectors must stay valid until the dispatch returns
+	static uint64_t setParallelBatchedOps(std::vector<BasicSerialMatrix>& C, const std::vector<View>& A,
+		const std::vector<View>& B, bool addOnesA = false, Activation activation = Activation::None);
+	//statistics on the pool: dispatch the returned block count to parallelStatisticsRange, then merge into the destinations
+	static uint64_t setParallelStatisticsOps(const View& ref, bool row);//The view must stay valid until the merge
+	static void parallelStatisticsRange(std::mutex& m, uint64_t startBlock, uint64_t endBlock);
+	static void mergeParallelStatistics(BasicSerialMatrix& mean, BasicSerialMatrix& deviation);
+	//Elementwise work on the pool: each set...Ops below returns the tasks to dispatch to parallelRange, or does the work itself
+	//	and returns 0 under MATRIX_PARALLEL_THRESHOLD elements (a dispatch of no tasks returns at once)
+	//	What they are given must stay valid until the dispatch returns, temporaries built in the dispatch call itself are
+	//	an expression reading out other than element for element is evaluated serially into a new buffer and returns 0
+	//	Work that is not row major throughout (a column major out or leaf) is done serially and returns 0
+	template <typename E>
+	static uint64_t setParallelExpressionOps(BasicSerialMatrix& out, const MatrixExpression<E>& expression)//out = expression, rows per task
+	{
+		std::pair<size_t, size_t> dimensions = expression.self().getDimensions();
+		if (out.data != nullptr && readsAcross(expression.self(), out.target(out.data, out.stride, out.getDimensions())))
+		{
+			out = expression.self();//Rows could overwrite what other tasks still read, so one pass into other storage
+			return 0;
+		}
+		out.resize(dimensions.first, dimensions.second);
+		if (dimensions.first * dimensions.second < MATRIX_PARALLEL_THRESHOLD || dimensions.first == 1 ||
+			out.layout != MatrixLayout::RowMajor || (expression.self().leaves() & LeafColumnMajor) != 0)
+		{
+			evaluateLayout(expression.self(), out.data, out.stride, out.layout);
+			return 0;
+		}
+		mExpression = &expression.self();
+		mParallelOut = &out;
+		mRangeTask = &expressionRows<E>;
+		return dimensions.first;
+	}
+	template <typename E>
+	static uint64_t setParallelSumOps(const MatrixExpression<E>& expression)//Blocks of rows per task, then getParallelSum
+	{
+		std::pair<size_t, size_t> dimensions = expression.self().getDimensions();
+		mPartialSums.clear();
+		if (dimensions.first * dimensions.second < MATRIX_PARALLEL_THRESHOLD || dimensions.first == 1 ||
+			(expression.self().leaves() & LeafColumnMajor) != 0)
+		{
+			mParallelSum = static_cast<Acc>(sumExpression(expression.self()));
+			return 0;
+		}
+		uint64_t blocks = (dimensions.first + MATRIX_STATISTICS_BLOCK - 1) / MATRIX_STATISTICS_BLOCK;
+		mPartialSums.assign(blocks, Acc(0));
+		mExpression = &expression.self();
+		mRangeTask = &sumBlocks<E>;
+		return blocks;
+	}
+	static Acc getParallelSum();//Block sums added in order, so the total does not depend on the thread count
+	static uint64_t setParallelActivationOps(BasicSerialMatrix& out, const View& in);//out = tanh(in), rows per task
+	static uint64_t setParallelAddOnesOps(BasicSerialMatrix& out, const View& in);//out = addOnes(in), rows per task
+	static uint64_t setParallelTransposeOps(BasicSerialMatrix& out, const View& in);//out = a copy of in transposed, rows of out per task
+	static uint64_t setParallelMeanOps(const View& ref, bool row);//As mean(ref, row), then mergeParallelMean
+	static void mergeParallelMean(BasicSerialMatrix& mean);
+	static void parallelRange(std::mutex& m, uint64_t startTask, uint64_t endTask);//The tasks of the last set...Ops above
 private:
 	size_t rows, columns;//length of 2D matrix
 	size_t capacity;//total cardinality of the 2D matrix
-	float* data;//the matrix innards
-	void deepCopy(const SerialMatrix& cp, bool allocate = true);//!!DATA MODIFICATION!! -- allocate is true, deletes if not nullptr : false, then checks for like parameters to determine deletion
-	template <size_t T, size_t S>
-	void deepCopy(const std::array<std::array<float, S>, T>& values, bool allocate = true)//!!DATA MODIFICATION!! -- allocate is true, deletes if not nullptr : false, then checks for like parameters to determine deletion
+	size_t stride;//leading dimension, row i starts at data + i * stride (column i when column major)
+	T* data;//the matrix innards, MATRIX_ALIGNMENT aligned
+	MatrixLayout layout;
+	size_t lines(std::pair<size_t, size_t> dimensions) const//Stored rows, or columns when column major
+	{
+		return layout == MatrixLayout::RowMajor ? dimensions.first : dimensions.second;
+	}
+	size_t lineLength(std::pair<size_t, size_t> dimensions) const
+	{
+		return layout == MatrixLayout::RowMajor ? dimensions.second : dimensions.first;
+	}
+	size_t storage() const { return lines(getDimensions()) * stride; }//elements allocated
+	//An expiring matrix of expression stored exactly as this matrix would store the result, nullptr when there is none
+	template <typename E>
+	BasicSerialMatrix* expiringBuffer(const E& expression, std::pair<size_t, size_t> dimensions) const
+	{
+		BasicSerialMatrix* leaf = expiringLeaf<BasicSerialMatrix>(expression);
+		if (leaf == nullptr || leaf->data == nullptr || leaf->layout != layout || leaf->getDimensions() != dimensions ||
+			leaf->stride != strideFor(lineLength(dimensions)) || readsAcross(expression, target(leaf->data, leaf->stride, dimensions)))
+			return nullptr;
+		return leaf;
+	}
+	//buffer as the storage of a result of dimensions in this matrix's layout
+	ExpressionTarget target(const T* buffer, size_t ld, std::pair<size_t, size_t> dimensions) const
+	{
+		return ExpressionTarget{ buffer, buffer + lines(dimensions) * ld, ld, dimensions, layout == MatrixLayout::ColumnMajor };
+	}
+	void flip();//Reads the storage the other way: rows and columns swap along with the layout, nothing moves
+	static size_t strideFor(size_t columns);
+	static T* allocate(size_t count);//nullptr on failure, as new (std::nothrow); from MatrixBufferPool unless MATRIX_BUFFER_POOL is 0
+	static void release(T* memory);
+	static View mViewA, mViewB;//setParallelProductOps state
+	static bool mAddOnesA, mOnesRowA;
+	static Activation mActivation;
+	static BasicSerialMatrix* mProduct;//mC or the destination given to setParallelProductOps
+	static const void* mExpression;//setParallel...Ops state for parallelRange, the expression as its own type
+	static BasicSerialMatrix* mParallelOut;
+	static void(*mRangeTask)(uint64_t startTask, uint64_t endTask);//What parallelRange runs
+	static std::vector<Acc> mPartialSums;
+	static Acc mParallelSum;//The whole sum when it was not worth dispatching
+	template <typename E>
+	static void expressionRows(uint64_t start, uint64_t end)
+	{
+		BasicSerialMatrix& out = *mParallelOut;
+		evaluateExpression(MatrixRows<E>(*static_cast<const E*>(mExpression), start, end - start),
+			out.data + start * out.stride, out.stride);
+	}
+	template <typename E>
+	static void sumBlocks(uint64_t start, uint64_t end)
+	{
+		const E& expression = *static_cast<const E*>(mExpression);
+		size_t expressionRows = expression.getDimensions().first;
+		for (uint64_t b = start; b < end; ++b)
+		{
+			size_t rowBegin = b * MATRIX_STATISTICS_BLOCK, rowEnd = std::min<size_t>(rowBegin + MATRIX_STATISTICS_BLOCK, expressionRows);
+			mPartialSums[b] = static_cast<Acc>(sumExpression(MatrixRows<E>(expression, rowBegin, rowEnd - rowBegin)));
+		}
+	}
+	static void activationRows(uint64_t start, uint64_t end);//Row tasks of the non template set...Ops, mViewA is their input
+	static void addOnesRows(uint64_t start, uint64_t end);
+	static void transposeRows(uint64_t start, uint64_t end);//Rows of the transpose are columns of mViewA
+	static void meanBlocks(uint64_t start, uint64_t end);
+	static void productTask(uint64_t start, uint64_t end);//parallelProductRows for parallelRange
+	static void strassenProducts(uint64_t start, uint64_t end);
+	static uint64_t prepareBatched(std::vector<BasicSerialMatrix>& C, const std::vector<View>& A, const std::vector<View>& B,
+		bool addOnesA, Activation activation);//Checks and sizes every product, returns the batch size
+	static void batchedProducts(std::vector<BasicSerialMatrix>& C, const std::vector<View>& A, const std::vector<View>& B,
+		bool addOnesA, Activation activation, uint64_t start, uint64_t end);
+	static void batchedTask(uint64_t start, uint64_t end);
+	static std::vector<BasicSerialMatrix>* mBatchOut;//setParallelBatchedOps state
+	static const std::vector<View>* mBatchA, * mBatchB;
+	static bool strassenApplies(const View& A, const View& B, size_t cutoff);
+	static std::vector<T> mStrassenWorkspace;//Grown once, kept between products
+	static size_t mStrassenCutoff;
+	static bool mStrassen;//Whether the last setParallelStrassenOps split into products
+	static void activationRows(BasicSerialMatrix& out, const View& in, size_t rowBegin, size_t rowEnd);
+	static void addOnesRows(BasicSerialMatrix& out, const View& in, size_t rowBegin, size_t rowEnd);
+	static View mStatistics;//setParallelStatisticsOps state, stored rows after any transpose is resolved
+	static bool mStatisticsRows;
+	static std::vector<Acc> mPartialMeans, mPartialM2s;//One row of columns per block, or one value per stored row
+	static uint64_t prepareStatistics(const View& ref, bool row, std::vector<Acc>& means,
+		std::vector<Acc>& m2s);//Sizes the partials, returns the block count
+	static void statisticsBlocks(const View& ref, bool row, uint64_t startBlock, uint64_t endBlock, Acc* means, Acc* m2s);
+	static void mergeStatistics(const View& ref, bool row, Acc* means, Acc* m2s,
+		BasicSerialMatrix& mean, BasicSerialMatrix& deviation);
+	//addOnesA prepends a column of ones to A as read, after any transpose; onesRowA prepends a row of ones instead,
+	//	only for transpose(addOnes(A)) * B where A is already passed transposed
+	static std::pair<size_t, size_t> productDimensions(const View& A, bool addOnesA,
+		const View& B, bool onesRowA = false);//Dimensions of C, throws on a mismatch
+	static void productRows(const View& A, bool addOnesA, const View& B, Acc alpha, Acc beta, BasicSerialMatrix& C,
+		size_t rowBegin, size_t rowEnd, Activation activation = Activation::None, bool onesRowA = false);
+	static uint64_t prepareProduct(BasicSerialMatrix& C, const View& A, const View& B, bool addOnesA, bool onesRowA,
+		Activation activation);//setParallelProductOps and setParallelAddOnesTransposeOps
+	void deepCopy(const BasicSerialMatrix& cp, bool allocate = true);//!!DATA MODIFICATION!! -- allocate is true, deletes if not nullptr : false, then checks for like parameters to determine deletion
+	template <size_t N, size_t M>
+	void deepCopy(const std::array<std::array<Acc, M>, N>& values, bool allocate = true)//!!DATA MODIFICATION!! -- allocate is true, deletes if not nullptr : false, then checks for like parameters to determine deletion
 	{
 		bool cleanStart = true;
 		if (allocate || data == nullptr) {}
 		else
 		{
-			if (capacity == (values.size() * values[0].size()))
+			if (storage() == (values.size() * strideFor(values[0].size())))
 			{
 				cleanStart = false;
 			}
 		}
+		layout = MatrixLayout::RowMajor;
 		rows = values.size();
 		columns = values[0].size();
 		capacity = rows * columns;
+		stride = strideFor(columns);
 		if (cleanStart)
 		{
-			delete[] data;
-			data = new (std::nothrow)float[capacity];
+			release(data);
+			data = BasicSerialMatrix::allocate(storage());
 			if (data == nullptr)throw std::bad_alloc();//"Serial Matrix class, bad allocation on STD::Array DeepCopy"
 		}
 		for (auto itr = values.begin(); itr != values.end(); ++itr)
 		{
 			for (auto jtr = itr->begin(); jtr != itr->end(); ++jtr)
 			{
-				//Row major in flattened indexing
-				data[(itr - values.begin()) * columns + (jtr - itr->begin())] = *jtr;
+				//Row major, rows stride apart
+				data[(itr - values.begin()) * stride + (jtr - itr->begin())] = static_cast<T>(*jtr);
 			}
 		}
 	}
-	void deepCopy(const std::vector<std::vector<float>>& values, bool allocate = true);
+	void deepCopy(const std::vector<std::vector<Acc>>& values, bool allocate = true);
 };
 
-std::ostream& operator<<(std::ostream& out, const SerialMatrix& mat);
+typedef BasicSerialMatrix<float> SerialMatrix;
+
+extern template class BasicSerialMatrix<float>;
+extern template class BasicSerialMatrix<double>;
+extern template class BasicSerialMatrix<BFloat16>;
+extern template class BasicSerialMatrix<Float16>;
+
+template <typename T, typename Acc>
+std::ostream& operator<<(std::ostream& out, const BasicSerialMatrix<T, Acc>& mat)
+{
+	return out << mat.getInfo();
+}
+
+//The matrix itself is the only leaf that starts at out's storage, safe while its rows are where the result's go
+template <typename T, typename Acc>
+bool readsAcross(const BasicSerialMatrix<T, Acc>& e, const ExpressionTarget& out)
+{
+	if (!out.holds(e.getData()))return false;
+	return e.getData() != out.begin || e.getStride() != out.stride || e.getDimensions() != out.dimensions;
+}
+
+//Single operator trees over matrices have nothing to fuse, so they go to the runtime dispatched kernels
+//	rows and columns are of storage, a column major tree's are its transpose's
+template <ElementOp Op, typename T, typename Acc>
+void evaluateStorage(const MatrixBinary<BasicSerialMatrix<T, Acc>, BasicSerialMatrix<T, Acc>, Op>& e, size_t rows, size_t columns,
+	T* out, size_t ldOut)
+{
+	if (e.broadcast)TypedKernels<T, Acc>::broadcastRow(Op, rows, columns, e.lhs.getData(), e.lhs.getStride(), e.rhs.getData(),
+		out, ldOut);
+	else TypedKernels<T, Acc>::elementwise(Op, rows, columns, e.lhs.getData(), e.lhs.getStride(), e.rhs.getData(),
+		e.rhs.getStride(), out, ldOut);
+}
+
+template <ElementOp Op, typename T, typename Acc>
+void evaluateStorage(const MatrixScalarLeft<BasicSerialMatrix<T, Acc>, Op>& e, size_t rows, size_t columns, T* out, size_t ldOut)
+{
+	TypedKernels<T, Acc>::scalarLeft(Op, rows, columns, e.s, e.rhs.getData(), e.rhs.getStride(), out, ldOut);
+}
+
+template <typename T, typename Acc>
+void evaluateStorage(const MatrixSquare<BasicSerialMatrix<T, Acc>>& e, size_t rows, size_t columns, T* out, size_t ldOut)
+{
+	TypedKernels<T, Acc>::square(rows, columns, e.ref.getData(), e.ref.getStride(), out, ldOut);
+}
+
+//The same operators with expiring leaves, whose storage is read as the matrices' own
+template <ElementOp Op, typename T, typename Acc>
+void evaluateStorage(const MatrixBinary<MatrixExpiring<BasicSerialMatrix<T, Acc>>, BasicSerialMatrix<T, Acc>, Op>& e, size_t rows,
+	size_t columns, T* out, size_t ldOut)
+{
+	evaluateStorage(MatrixBinary<BasicSerialMatrix<T, Acc>, BasicSerialMatrix<T, Acc>, Op>(e.lhs.ref, e.rhs), rows, columns, out, ldOut);
+}
+
+template <ElementOp Op, typename T, typename Acc>
+void evaluateStorage(const MatrixBinary<BasicSerialMatrix<T, Acc>, MatrixExpiring<BasicSerialMatrix<T, Acc>>, Op>& e, size_t rows,
+	size_t columns, T* out, size_t ldOut)
+{
+	evaluateStorage(MatrixBinary<BasicSerialMatrix<T, Acc>, BasicSerialMatrix<T, Acc>, Op>(e.lhs, e.rhs.ref), rows, columns, out, ldOut);
+}
+
+template <ElementOp Op, typename T, typename Acc>
+void evaluateStorage(const MatrixBinary<MatrixExpiring<BasicSerialMatrix<T, Acc>>, MatrixExpiring<BasicSerialMatrix<T, Acc>>, Op>& e,
+	size_t rows, size_t columns, T* out, size_t ldOut)
+{
+	evaluateStorage(MatrixBinary<BasicSerialMatrix<T, Acc>, BasicSerialMatrix<T, Acc>, Op>(e.lhs.ref, e.rhs.ref), rows, columns, out,
+		ldOut);
+}
+
+template <ElementOp Op, typename T, typename Acc>
+void evaluateStorage(const MatrixScalarLeft<MatrixExpiring<BasicSerialMatrix<T, Acc>>, Op>& e, size_t rows, size_t columns, T* out,
+	size_t ldOut)
+{
+	TypedKernels<T, Acc>::scalarLeft(Op, rows, columns, e.s, e.rhs.ref.getData(), e.rhs.ref.getStride(), out, ldOut);
+}
+
+template <typename T, typename Acc>
+void evaluateStorage(const MatrixSquare<MatrixExpiring<BasicSerialMatrix<T, Acc>>>& e, size_t rows, size_t columns, T* out, size_t ldOut)
+{
+	TypedKernels<T, Acc>::square(rows, columns, e.ref.ref.getData(), e.ref.ref.getStride(), out, ldOut);
+}
+
+//A copy of a view, a transposed one through the tiled transpose rather than down its columns
+template <typename T, typename Acc>
+void evaluateStorage(const BasicMatrixView<T, Acc>& e, size_t rows, size_t columns, T* out, size_t ldOut)
+{
+	if (e.isTransposed())
+	{
+		TypedKernels<T, Acc>::transpose(columns, rows, e.getData(), e.getStride(), out, ldOut);
+		return;
+	}
+	for (size_t i = 0; i < rows; ++i)
+	{
+		std::copy(e.address(i, 0), e.address(i, 0) + columns, out + i * ldOut);
+	}
+}
+
+//A view into a column major destination is its transpose into row major storage
+template <typename T, typename Acc>
+void evaluateLayout(const BasicMatrixView<T, Acc>& e, T* out, size_t ldOut, MatrixLayout layout)
+{
+	evaluateExpression(layout == MatrixLayout::RowMajor ? e : e.transpose(), out, ldOut);
+}
+
+//M += s * N in place is an axpy
+template <typename T, typename Acc>
+void evaluateStorage(const MatrixBinary<BasicSerialMatrix<T, Acc>, MatrixScalarLeft<BasicSerialMatrix<T, Acc>,
+	ElementOp::Multiply>, ElementOp::Add>& e, size_t rows, size_t columns, T* out, size_t ldOut)
+{
+	if (e.broadcast || out != e.lhs.getData() || ldOut != e.lhs.getStride())
+	{
+		evaluateStorage<MatrixBinary<BasicSerialMatrix<T, Acc>, MatrixScalarLeft<BasicSerialMatrix<T, Acc>,
+			ElementOp::Multiply>, ElementOp::Add>>(e, rows, columns, out, ldOut);
+		return;
+	}
+	TypedKernels<T, Acc>::axpy(rows, columns, e.rhs.s, e.rhs.rhs.getData(), e.rhs.rhs.getStride(), out, ldOut);
+}
+
+template <typename T, typename Acc>
+const BasicSerialMatrix<T, Acc>& evaluated(const BasicSerialMatrix<T, Acc>& mat)
+{
+	return mat;
+}
+
+template <typename E>
+typename E::Result evaluated(const MatrixExpression<E>& expression)
+{
+	return typename E::Result(expression);
+}
+
+//Products are not elementwise, so a lazy operand is evaluated before the GEMM
+template <typename L, typename R>
+typename L::Result operator*(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs)
+{
+	return evaluated(lhs.self()) * evaluated(rhs.self());
+}
 
 #endif // !__SERIAL_MATRIX__
\ No newline at end of file
@@ -0,0 +1,373 @@
+/*
+Author: Dan Rehberg
+Modified Date: 10/19/2026
+*/
+#include "SparseMatrix.hpp"
+#include "TypedKernels.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+template <typename T, typename Acc>
+const BasicSparseMatrix<T, Acc>* BasicSparseMatrix<T, Acc>::mSparse = nullptr;
+template <typename T, typename Acc>
+BasicMatrixView<T, Acc> BasicSparseMatrix<T, Acc>::mDense;
+template <typename T, typename Acc>
+BasicSerialMatrix<T, Acc>* BasicSparseMatrix<T, Acc>::mProduct = nullptr;
+template <typename T, typename Acc>
+bool BasicSparseMatrix<T, Acc>::mSparseLeft = false;
+template <typename T, typename Acc>
+bool BasicSparseMatrix<T, Acc>::mAddOnesA = false;
+template <typename T, typename Acc>
+Activation BasicSparseMatrix<T, Acc>::mActivation = Activation::None;
+
+//Row or column sums of one task, grown once per thread and kept, so steady state products allocate nothing
+template <typename Acc>
+static Acc* sparseScratch(size_t count)
+{
+	static thread_local std::vector<Acc> scratch;
+	if (scratch.size() < count)scratch.resize(count);
+	std::fill(scratch.begin(), scratch.begin() + count, Acc(0));
+	return scratch.data();
+}
+
+//Element (i, j) of a view is at base + i * rowStep + j * columnStep, whether or not it is transposed
+template <typename T, typename Acc>
+static std::pair<size_t, size_t> steps(const BasicMatrixView<T, Acc>& view)
+{
+	return view.isTransposed() ? std::pair<size_t, size_t>(1, view.getStride()) : std::pair<size_t, size_t>(view.getStride(), 1);
+}
+
+template <typename T, typename Acc>
+BasicSparseMatrix<T, Acc>::BasicSparseMatrix() : rows(0), columns(0), format(SparseFormat::CSR), offsets(1, 0)
+{
+
+}
+
+template <typename T, typename Acc>
+BasicSparseMatrix<T, Acc>::BasicSparseMatrix(const View& dense, SparseFormat order, Acc threshold, size_t keptRows) : BasicSparseMatrix()
+{
+	std::pair<size_t, size_t> dimensions = dense.getDimensions();
+	if (dimensions.first > std::numeric_limits<uint32_t>::max() || dimensions.second > std::numeric_limits<uint32_t>::max())
+		throw std::length_error(R"(Sparse matrix indices are 32 bit, dimensions were: )" + std::to_string(dimensions.first) +
+			", " + std::to_string(dimensions.second));
+	rows = dimensions.first;
+	columns = dimensions.second;
+	format = order;
+	size_t count = lines(), length = format == SparseFormat::CSR ? columns : rows;
+	offsets.assign(count + 1, 0);
+	for (size_t line = 0; line < count; ++line)
+	{
+		for (size_t k = 0; k < length; ++k)
+		{
+			size_t i = format == SparseFormat::CSR ? line : k, j = format == SparseFormat::CSR ? k : line;
+			Acc value = dense.at(i, j);
+			if (i < keptRows ? value == Acc(0) : !(std::fabs(value) > threshold))continue;
+			indices.push_back(static_cast<uint32_t>(k));
+			values.push_back(static_cast<T>(value));
+		}
+		offsets[line + 1] = values.size();
+	}
+}
+
+template <typename T, typename Acc>
+Acc BasicSparseMatrix<T, Acc>::pruningThreshold(const View& dense, double sparsity)
+{
+	std::pair<size_t, size_t> dimensions = dense.getDimensions();
+	size_t count = dimensions.first * dimensions.second;
+	size_t pruned = static_cast<size_t>(std::min(1.0, std::max(0.0, sparsity)) * static_cast<double>(count));
+	if (pruned == 0)return Acc(0);
+	std::vector<Acc> magnitudes;
+	magnitudes.reserve(count);
+	for (size_t i = 0; i < dimensions.first; ++i)
+	{
+		for (size_t j = 0; j < dimensions.second; ++j)magnitudes.push_back(std::fabs(dense.at(i, j)));
+	}
+	std::nth_element(magnitudes.begin(), magnitudes.begin() + (pruned - 1), magnitudes.end());
+	return magnitudes[pruned - 1];
+}
+
+template <typename T, typename Acc>
+std::pair<size_t, size_t> BasicSparseMatrix<T, Acc>::getDimensions() const
+{
+	return std::pair<size_t, size_t>(rows, columns);
+}
+
+template <typename T, typename Acc>
+size_t BasicSparseMatrix<T, Acc>::getNonZeros() const
+{
+	return values.size();
+}
+
+template <typename T, typename Acc>
+double BasicSparseMatrix<T, Acc>::getDensity() const
+{
+	return rows * columns == 0 ? 0.0 : static_cast<double>(values.size()) / (static_cast<double>(rows) * static_cast<double>(columns));
+}
+
+template <typename T, typename Acc>
+SparseFormat BasicSparseMatrix<T, Acc>::getFormat() const
+{
+	return format;
+}
+
+template <typename T, typename Acc>
+void BasicSparseMatrix<T, Acc>::setFormat(SparseFormat order)
+{
+	if (order == format)return;
+	//Counting sort by the other index, entries visited in line order so each new line stays sorted
+	size_t count = order == SparseFormat::CSR ? rows : columns;
+	std::vector<size_t> converted(count + 1, 0);
+	for (uint32_t index : indices)++converted[index + 1];
+	for (size_t line = 0; line < count; ++line)converted[line + 1] += converted[line];
+	std::vector<size_t> next(converted.begin(), converted.end() - 1);
+	std::vector<uint32_t> convertedIndices(indices.size());
+	std::vector<T> convertedValues(values.size());
+	for (size_t line = 0; line < lines(); ++line)
+	{
+		for (size_t p = offsets[line]; p < offsets[line + 1]; ++p)
+		{
+			size_t q = next[indices[p]]++;
+			convertedIndices[q] = static_cast<uint32_t>(line);
+			convertedValues[q] = values[p];
+		}
+	}
+	offsets.swap(converted);
+	indices.swap(convertedIndices);
+	values.swap(convertedValues);
+	format = order;
+}
+
+template <typename T, typename Acc>
+const std::vector<size_t>& BasicSparseMatrix<T, Acc>::getOffsets() const
+{
+	return offsets;
+}
+
+template <typename T, typename Acc>
+const std::vector<uint32_t>& BasicSparseMatrix<T, Acc>::getIndices() const
+{
+	return indices;
+}
+
+template <typename T, typename Acc>
+const std::vector<T>& BasicSparseMatrix<T, Acc>::getValues() const
+{
+	return values;
+}
+
+template <typename T, typename Acc>
+Acc BasicSparseMatrix<T, Acc>::at(size_t row, size_t column) const
+{
+	size_t line = format == SparseFormat::CSR ? row : column, index = format == SparseFormat::CSR ? column : row;
+	std::vector<uint32_t>::const_iterator begin = indices.begin() + offsets[line], end = indices.begin() + offsets[line + 1];
+	std::vector<uint32_t>::const_iterator found = std::lower_bound(begin, end, static_cast<uint32_t>(index));
+	if (found == end || *found != index)return Acc(0);
+	return static_cast<Acc>(values[found - indices.begin()]);
+}
+
+template <typename T, typename Acc>
+void BasicSparseMatrix<T, Acc>::toDense(Dense& out) const
+{
+	out.resize(rows, columns);
+	bool rowMajor = out.getLayout() == MatrixLayout::RowMajor;
+	size_t storedLines = rowMajor ? rows : columns, length = rowMajor ? columns : rows;
+	for (size_t line = 0; line < storedLines; ++line)std::fill(out.data + line * out.stride, out.data + line * out.stride + length, T(0));
+	for (size_t line = 0; line < lines(); ++line)
+	{
+		for (size_t p = offsets[line]; p < offsets[line + 1]; ++p)
+		{
+			size_t i = format == SparseFormat::CSR ? line : indices[p], j = format == SparseFormat::CSR ? indices[p] : line;
+			out.data[rowMajor ? i * out.stride + j : j * out.stride + i] = values[p];
+		}
+	}
+}
+
+template <typename T, typename Acc>
+uint64_t BasicSparseMatrix<T, Acc>::prepareSparseDense(Dense& C, const BasicSparseMatrix& A, const View& B)
+{
+	std::pair<size_t, size_t> b = B.getDimensions();
+	if (A.columns != b.first)throw std::range_error(R"(Sparse product requires the left matrix columns
+		match the right matrix rows: left has: )" + std::to_string(A.columns) + " while right has: " + std::to_string(b.first));
+	if (C.getLayout() != MatrixLayout::RowMajor)throw std::range_error(R"(Sparse products write whole rows
+		of their destination, which must be row major)");
+	C.resize(A.rows, b.second);
+	return A.format == SparseFormat::CSR ? A.rows : (b.second + SPARSE_COLUMN_BAND - 1) / SPARSE_COLUMN_BAND;
+}
+
+template <typename T, typename Acc>
+uint64_t BasicSparseMatrix<T, Acc>::prepareDenseSparse(Dense& C, const View& A, const BasicSparseMatrix& B, bool addOnesA)
+{
+	std::pair<size_t, size_t> a = A.getDimensions();
+	size_t inner = a.second + (addOnesA ? 1 : 0);
+	if (inner != B.rows)throw std::range_error(R"(Sparse product requires the left matrix columns
+		match the right matrix rows after any leading ones: left has: )" + std::to_string(inner) + " while right has: " +
+		std::to_string(B.rows));
+	if (C.getLayout() != MatrixLayout::RowMajor)throw std::range_error(R"(Sparse products write whole rows
+		of their destination, which must be row major)");
+	C.resize(a.first, B.columns);
+	return a.first;
+}
+
+template <typename T, typename Acc>
+void BasicSparseMatrix<T, Acc>::sparseDense(Dense& C, const BasicSparseMatrix& A, const View& B, uint64_t start, uint64_t end)
+{
+	size_t n = B.getDimensions().second;
+	std::pair<size_t, size_t> step = steps(B);
+	const T* b = B.getData();
+	if (A.format == SparseFormat::CSR)
+	{
+		//Row i of C is row i of A's entries times the rows of B they pick, each added whole
+		Acc* sums = sparseScratch<Acc>(n);
+		for (uint64_t i = start; i < end; ++i)
+		{
+			std::fill(sums, sums + n, Acc(0));
+			for (size_t p = A.offsets[i]; p < A.offsets[i + 1]; ++p)
+			{
+				Acc value = static_cast<Acc>(A.values[p]);
+				const T* row = b + A.indices[p] * step.first;
+				if (step.second == 1)
+				{
+					for (size_t j = 0; j < n; ++j)sums[j] += value * static_cast<Acc>(row[j]);
+				}
+				else
+				{
+					for (size_t j = 0; j < n; ++j)sums[j] += value * static_cast<Acc>(row[j * step.second]);
+				}
+			}
+			T* c = C.data + i * C.stride;
+			for (size_t j = 0; j < n; ++j)c[j] = static_cast<T>(sums[j]);
+		}
+		return;
+	}
+	//Column k of A scatters into every row of C it has an entry in, a band of C's columns per task
+	for (uint64_t band = start; band < end; ++band)
+	{
+		size_t j0 = band * SPARSE_COLUMN_BAND, width = std::min<size_t>(SPARSE_COLUMN_BAND, n - j0);
+		Acc* sums = sparseScratch<Acc>(A.rows * width);
+		for (size_t k = 0; k < A.columns; ++k)
+		{
+			const T* row = b + k * step.first + j0 * step.second;
+			for (size_t p = A.offsets[k]; p < A.offsets[k + 1]; ++p)
+			{
+				Acc value = static_cast<Acc>(A.values[p]);
+				Acc* out = sums + A.indices[p] * width;
+				for (size_t j = 0; j < width; ++j)out[j] += value * static_cast<Acc>(row[j * step.second]);
+			}
+		}
+		for (size_t i = 0; i < A.rows; ++i)
+		{
+			T* c = C.data + i * C.stride + j0;
+			for (size_t j = 0; j < width; ++j)c[j] = static_cast<T>(sums[i * width + j]);
+		}
+	}
+}
+
+template <typename T, typename Acc>
+void BasicSparseMatrix<T, Acc>::denseSparse(Dense& C, const View& A, const BasicSparseMatrix& B, bool addOnesA,
+	Activation activation, uint64_t start, uint64_t end)
+{
+	//SPARSE_ROW_BLOCK rows of A at a time, packed transposed so every entry of B is one multiply add across the block
+	//	rather than one per row; the ones column is a row of ones in the pack, so the bias is just B's row 0
+	size_t inner = A.getDimensions().second, n = B.columns, ones = addOnesA ? 1 : 0;
+	std::pair<size_t, size_t> step = steps(A);
+	Acc* packed = sparseScratch<Acc>((B.rows + n) * SPARSE_ROW_BLOCK);
+	Acc* sums = packed + B.rows * SPARSE_ROW_BLOCK;
+	for (uint64_t i0 = start; i0 < end; i0 += SPARSE_ROW_BLOCK)
+	{
+		size_t count = std::min<size_t>(SPARSE_ROW_BLOCK, end - i0);
+		if (addOnesA)std::fill(packed, packed + SPARSE_ROW_BLOCK, Acc(1));
+		for (size_t k = 0; k < inner; ++k)
+		{
+			const T* a = A.getData() + i0 * step.first + k * step.second;
+			Acc* column = packed + (k + ones) * SPARSE_ROW_BLOCK;
+			for (size_t r = 0; r < count; ++r)column[r] = static_cast<Acc>(a[r * step.first]);
+			for (size_t r = count; r < SPARSE_ROW_BLOCK; ++r)column[r] = Acc(0);
+		}
+		std::fill(sums, sums + n * SPARSE_ROW_BLOCK, Acc(0));
+		if (B.format == SparseFormat::CSR)
+		{
+			for (size_t line = 0; line < B.rows; ++line)
+			{
+				const Acc* x = packed + line * SPARSE_ROW_BLOCK;
+				for (size_t p = B.offsets[line]; p < B.offsets[line + 1]; ++p)
+				{
+					Acc value = static_cast<Acc>(B.values[p]);
+					Acc* out = sums + B.indices[p] * SPARSE_ROW_BLOCK;
+					for (size_t r = 0; r < SPARSE_ROW_BLOCK; ++r)out[r] += value * x[r];
+				}
+			}
+		}
+		else
+		{
+			for (size_t j = 0; j < n; ++j)
+			{
+				Acc* out = sums + j * SPARSE_ROW_BLOCK;
+				for (size_t p = B.offsets[j]; p < B.offsets[j + 1]; ++p)
+				{
+					Acc value = static_cast<Acc>(B.values[p]);
+					const Acc* x = packed + B.indices[p] * SPARSE_ROW_BLOCK;
+					for (size_t r = 0; r < SPARSE_ROW_BLOCK; ++r)out[r] += value * x[r];
+				}
+			}
+		}
+		for (size_t r = 0; r < count; ++r)
+		{
+			T* c = C.data + (i0 + r) * C.stride;
+			for (size_t j = 0; j < n; ++j)c[j] = static_cast<T>(sums[j * SPARSE_ROW_BLOCK + r]);
+			if (activation != Activation::None)TypedKernels<T, Acc>::activate(activation, n, c, c);
+		}
+	}
+}
+
+template <typename T, typename Acc>
+void BasicSparseMatrix<T, Acc>::multiply(Dense& C, const BasicSparseMatrix& A, const View& B)
+{
+	sparseDense(C, A, B, 0, prepareSparseDense(C, A, B));
+}
+
+template <typename T, typename Acc>
+void BasicSparseMatrix<T, Acc>::multiply(Dense& C, const View& A, const BasicSparseMatrix& B, bool addOnesA, Activation activation)
+{
+	denseSparse(C, A, B, addOnesA, activation, 0, prepareDenseSparse(C, A, B, addOnesA));
+}
+
+template <typename T, typename Acc>
+uint64_t BasicSparseMatrix<T, Acc>::setParallelMultiplyOps(Dense& C, const BasicSparseMatrix& A, const View& B)
+{
+	uint64_t tasks = prepareSparseDense(C, A, B);
+	mSparse = &A;
+	mDense = B;
+	mProduct = &C;
+	mSparseLeft = true;
+	return tasks;
+}
+
+template <typename T, typename Acc>
+uint64_t BasicSparseMatrix<T, Acc>::setParallelMultiplyOps(Dense& C, const View& A, const BasicSparseMatrix& B, bool addOnesA,
+	Activation activation)
+{
+	uint64_t tasks = prepareDenseSparse(C, A, B, addOnesA);
+	mSparse = &B;
+	mDense = A;
+	mProduct = &C;
+	mSparseLeft = false;
+	mAddOnesA = addOnesA;
+	mActivation = activation;
+	return tasks;
+}
+
+template <typename T, typename Acc>
+void BasicSparseMatrix<T, Acc>::parallelRange(std::mutex&, uint64_t start, uint64_t end)
+{
+	if (mSparseLeft)sparseDense(*mProduct, *mSparse, mDense, start, end);
+	else denseSparse(*mProduct, mDense, *mSparse, mAddOnesA, mActivation, start, end);
+}
+
+//The element types the library is built for, as SerialMatrix
+template class BasicSparseMatrix<float>;
+template class BasicSparseMatrix<double>;
+template class BasicSparseMatrix<BFloat16>;
+template class BasicSparseMatrix<Float16>;
\ No newline at end of file
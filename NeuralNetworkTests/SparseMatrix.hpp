@@ -0,0 +1,90 @@
+/*
+Author: Dan Rehberg
+Modified Date: 10/19/2026
+Purpose: Compressed sparse matrix for mostly zero operands, e.g., weights after magnitude pruning.
+	CSR stores each row's nonzeros one row after another, CSC each column's; offsets[line] to offsets[line + 1] are a line's
+		entries, sorted by their index (column for CSR, row for CSC).
+	Products with a dense SerialMatrix operand write a dense row major result, summed in Acc and rounded once as stored:
+		sparse * dense and dense * sparse, serially or as tasks of a ThreadPool through set...Ops and parallelRange.
+	dense * sparse takes addOnesA and an activation as SerialMatrix::addOnesMultiply does, so a pruned layer is one call;
+		the first row of the sparse operand is then the bias.
+	BasicSparseMatrix<T, Acc> stores T as BasicSerialMatrix does, SparseMatrix is the float one.
+*/
+
+#ifndef __SPARSE_MATRIX__
+#define __SPARSE_MATRIX__
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "SerialMatrix.hpp"
+
+//Columns of the result per task for a CSC matrix on the left, whose entries scatter down the result's rows
+#define SPARSE_COLUMN_BAND 64
+//Rows of the dense left operand multiplied together by a sparse right operand, 16 floats is one AVX-512 register
+#define SPARSE_ROW_BLOCK 16
+
+enum class SparseFormat { CSR, CSC };
+
+template <typename T, typename Acc = typename MatrixAccumulator<T>::type>
+class BasicSparseMatrix
+{
+public:
+	typedef T Element;
+	typedef Acc Value;
+	typedef BasicSerialMatrix<T, Acc> Dense;
+	typedef BasicMatrixView<T, Acc> View;
+	BasicSparseMatrix();
+	//Elements of dense with a magnitude over threshold, every nonzero of the first keptRows rows (a bias row)
+	BasicSparseMatrix(const View& dense, SparseFormat format = SparseFormat::CSR, Acc threshold = Acc(0), size_t keptRows = 0);
+	//Magnitude at or under which the smallest sparsity (0 to 1) of dense's elements fall, a threshold for the constructor
+	static Acc pruningThreshold(const View& dense, double sparsity);
+	std::pair<size_t, size_t> getDimensions() const;
+	size_t getNonZeros() const;
+	double getDensity() const;//Nonzeros over rows * columns
+	SparseFormat getFormat() const;
+	void setFormat(SparseFormat order);//Recompressed along the other dimension
+	const std::vector<size_t>& getOffsets() const;
+	const std::vector<uint32_t>& getIndices() const;
+	const std::vector<T>& getValues() const;
+	Acc at(size_t row, size_t column) const;//A search of the line, zero when not stored
+	void toDense(Dense& out) const;//out is resized, its layout kept
+	static void multiply(Dense& C, const BasicSparseMatrix& A, const View& B);//C = A * B
+	//C = activation(A * B), or activation(addOnes(A) * B) with the first row of B the bias
+	static void multiply(Dense& C, const View& A, const BasicSparseMatrix& B, bool addOnesA = false,
+		Activation activation = Activation::None);
+	//As multiply, the tasks to dispatch to parallelRange: rows of C, or bands of SPARSE_COLUMN_BAND columns for a CSC A
+	//	The operands must stay valid until the dispatch returns
+	static uint64_t setParallelMultiplyOps(Dense& C, const BasicSparseMatrix& A, const View& B);
+	static uint64_t setParallelMultiplyOps(Dense& C, const View& A, const BasicSparseMatrix& B, bool addOnesA = false,
+		Activation activation = Activation::None);
+	static void parallelRange(std::mutex& m, uint64_t startTask, uint64_t endTask);
+private:
+	size_t rows, columns;
+	SparseFormat format;
+	std::vector<size_t> offsets;//One per stored line and one past the last
+	std::vector<uint32_t> indices;//Column (CSR) or row (CSC) of each entry
+	std::vector<T> values;
+	size_t lines() const { return format == SparseFormat::CSR ? rows : columns; }
+	static uint64_t prepareSparseDense(Dense& C, const BasicSparseMatrix& A, const View& B);//Sizes C, returns the task count
+	static uint64_t prepareDenseSparse(Dense& C, const View& A, const BasicSparseMatrix& B, bool addOnesA);
+	static void sparseDense(Dense& C, const BasicSparseMatrix& A, const View& B, uint64_t startTask, uint64_t endTask);
+	static void denseSparse(Dense& C, const View& A, const BasicSparseMatrix& B, bool addOnesA, Activation activation,
+		uint64_t startRow, uint64_t endRow);
+	static const BasicSparseMatrix* mSparse;//setParallelMultiplyOps state
+	static View mDense;
+	static Dense* mProduct;
+	static bool mSparseLeft, mAddOnesA;
+	static Activation mActivation;
+};
+
+typedef BasicSparseMatrix<float> SparseMatrix;
+
+extern template class BasicSparseMatrix<float>;
+extern template class BasicSparseMatrix<double>;
+extern template class BasicSparseMatrix<BFloat16>;
+extern template class BasicSparseMatrix<Float16>;
+
+#endif // !__SPARSE_MATRIX__
\ No newline at end of file
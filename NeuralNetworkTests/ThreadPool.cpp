@@ -1,6 +1,6 @@
 /*
 Author: Dan Rehberg
-Date Modified: 8/5/2021
+Date Modified: 10/19/2026
 Notes: While from a single use case, creating the unique locks in the sleep sync method
 		can be seen as taking an exorbitant amount of time, empirically testing the
 		single creation of unique locks (for the main and Daemon threads) proved to average
@@ -20,6 +20,18 @@ Notes: While from a single use case, creating the unique locks in the sleep sync
 
 #include "ThreadPool.hpp"
 #include <iostream>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 ThreadPool::ThreadPool() : threadCount(std::thread::hardware_concurrency())
 {
@@ -51,6 +63,38 @@ ThreadPool::ThreadPool(unsigned int threadCount) : threadCount(threadCount)
 	}
 }
 
+ThreadPool::ThreadPool(unsigned int threadCount, const LowJitterSettings& settings) : jitter(settings),
+	lowJitter(true), threadCount(threadCount)
+{
+	//Process wide lock is done once here so the workers (and their stacks) are covered by it too
+	if (jitter.lockMemory)
+	{
+#if defined(_WIN32)
+		deny("lockMemory: no process wide page lock on Windows, use prefault per buffer");
+#else
+		if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+			deny(std::string("lockMemory: mlockall failed: ") + std::strerror(errno));
+#endif
+	}
+	threads = new std::thread[this->threadCount];
+	completeCounter.store(0, std::memory_order_relaxed);
+	terminated.store(0, std::memory_order_relaxed);
+	for (unsigned int i = 0; i < this->threadCount; ++i)
+	{
+		threads[i] = std::move(std::thread(&ThreadPool::g, this, i));
+	}
+	for (unsigned int i = 0; i < this->threadCount; ++i)
+	{
+		threads[i].detach();//daemon threads
+	}
+	//Workers apply their settings before the starting line, so all denials are known after this
+	initialized();
+	for (auto itr = denied.begin(); itr != denied.end(); ++itr)
+	{
+		std::cerr << "Low jitter setting denied: " << *itr << "\n";
+	}
+}
+
 ThreadPool::~ThreadPool()
 {
 	if (terminated.load(std::memory_order_relaxed) != (threadCount - 1))
@@ -67,20 +111,40 @@ ThreadPool::~ThreadPool()
 	{
 	}
 	f = nullptr;
+	fRange = nullptr;
 	delete[] threads;
 }
 
-void ThreadPool::dispatch(uint32_t taskCount, void(*task)(std::mutex&, unsigned int))
+void ThreadPool::dispatch(uint64_t taskCount, void(*task)(std::mutex&, uint64_t))
 {
-	if (!init)initialized();
-	N = taskCount;
-	n = (N + (threadCount - 1)) / threadCount;
 	if (task == nullptr)
 	{
 		std::cerr << "Invalid function given to dispatch call\n";
 		return;
 	}
 	f = task;
+	fRange = nullptr;
+	run(taskCount);
+}
+
+void ThreadPool::dispatch(uint64_t taskCount, void(*task)(std::mutex&, uint64_t, uint64_t))
+{
+	if (task == nullptr)
+	{
+		std::cerr << "Invalid function given to dispatch call\n";
+		return;
+	}
+	f = nullptr;
+	fRange = task;
+	run(taskCount);
+}
+
+void ThreadPool::run(uint64_t taskCount)
+{
+	if (taskCount == 0)return;//Nothing to wake the threads for, e.g., work its set up call ran serially
+	if (!init)initialized();
+	N = taskCount;
+	n = (N + (threadCount - 1)) / threadCount;
 	blockIsFinished = false;
 	blockIsMain = false;// true;
 	completeCounter.store(0, std::memory_order_relaxed);
@@ -113,6 +177,7 @@ void ThreadPool::dispatch(uint32_t taskCount, void(*task)(std::mutex&, unsigned
 
 void ThreadPool::g(const unsigned int i)//the ith thread in the argument
 {
+	if (lowJitter)applyLowJitter(i);
 	while (!close)
 	{
 		//Starting line
@@ -132,8 +197,8 @@ void ThreadPool::g(const unsigned int i)//the ith thread in the argument
 		}
 #endif
 		//distribute tasks
-		uint32_t t0 = static_cast<uint32_t>(i) * n;
-		uint32_t t1 = t0 + n;
+		uint64_t t0 = static_cast<uint64_t>(i) * n;
+		uint64_t t1 = t0 + n;
 		if (t0 >= N)
 		{
 			t0 = 0;
@@ -144,9 +209,16 @@ void ThreadPool::g(const unsigned int i)//the ith thread in the argument
 			t1 = N;
 		}
 		//Execute on tasks
-		for (uint32_t j = t0; j < t1; ++j)
+		if (fRange != nullptr)
 		{
-			f(lockShared, j);
+			if (t0 != t1)fRange(lockShared, t0, t1);
+		}
+		else
+		{
+			for (uint64_t j = t0; j < t1; ++j)
+			{
+				f(lockShared, j);
+			}
 		}
 
 		//Finish line
@@ -175,4 +247,109 @@ void ThreadPool::initialized()
 	if (!init)while (!blockIsMain) {}
 	init = true;
 	return;
+}
+
+const std::vector<std::string>& ThreadPool::getDeniedSettings() const
+{
+	return denied;
+}
+
+void ThreadPool::prefault(const void* buffer, size_t bytes)
+{
+	if (buffer == nullptr || bytes == 0)return;
+#if defined(_WIN32)
+	if (VirtualLock(const_cast<void*>(buffer), bytes) == 0)
+		deny("prefault: VirtualLock failed with error " + std::to_string(GetLastError()));
+	const size_t page = 4096;
+#else
+	if (mlock(buffer, bytes) != 0)
+		deny(std::string("prefault: mlock failed: ") + std::strerror(errno));
+	const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+	//Read only, so read only mappings (MappedMatrix) and buffers other threads write are safe to pass
+	//	The lock already faults every page in, writable ones for writing; where it was denied the reads still map them
+	const volatile unsigned char* itr = static_cast<const volatile unsigned char*>(buffer);
+	unsigned char touched = 0;
+	for (size_t offset = 0; offset < bytes; offset += page)
+	{
+		touched ^= itr[offset];
+	}
+	touched ^= itr[bytes - 1];
+	(void)touched;
+}
+
+//Kept out of line so the touched frame sits below the worker loop's frame
+#if defined(_MSC_VER)
+__declspec(noinline)
+#else
+__attribute__((noinline))
+#endif
+static void prefaultStack()
+{
+	volatile unsigned char stack[LOW_JITTER_STACK_BYTES];
+	for (size_t offset = 0; offset < LOW_JITTER_STACK_BYTES; offset += 1024)
+	{
+		stack[offset] = 0;
+	}
+	(void)stack[0];
+}
+
+void ThreadPool::applyLowJitter(const unsigned int i)
+{
+	const std::string worker = "worker " + std::to_string(i) + " ";
+#if defined(_WIN32)
+	HANDLE self = GetCurrentThread();
+	if (!jitter.cpus.empty())
+	{
+		unsigned int cpu = jitter.cpus[i % jitter.cpus.size()];
+		if (SetThreadAffinityMask(self, static_cast<DWORD_PTR>(1) << cpu) == 0)
+			deny(worker + "cpu " + std::to_string(cpu) + ": SetThreadAffinityMask failed with error " +
+				std::to_string(GetLastError()));
+	}
+	if ((jitter.fifoPriority != 0 && jitter.cpus.size() >= threadCount) || jitter.niceValue != 0)
+	{
+		if (SetThreadPriority(self, THREAD_PRIORITY_TIME_CRITICAL) == 0)
+			deny(worker + "priority: SetThreadPriority failed with error " + std::to_string(GetLastError()));
+	}
+#else
+	pthread_t self = pthread_self();
+	if (!jitter.cpus.empty())
+	{
+		unsigned int cpu = jitter.cpus[i % jitter.cpus.size()];
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(cpu, &set);
+		int err = pthread_setaffinity_np(self, sizeof(set), &set);
+		if (err != 0)deny(worker + "cpu " + std::to_string(cpu) + ": " + std::strerror(err));
+	}
+	bool fifo = false;
+	if (jitter.fifoPriority != 0 && jitter.cpus.size() < threadCount)
+	{
+		//A spinning FIFO worker never yields, sharing a CPU would starve the other workers or the dispatcher
+		deny(worker + "SCHED_FIFO: needs one isolated cpu per worker, " + std::to_string(jitter.cpus.size()) +
+			" given for " + std::to_string(threadCount) + " workers");
+	}
+	else if (jitter.fifoPriority != 0)
+	{
+		sched_param param;
+		param.sched_priority = jitter.fifoPriority;
+		int err = pthread_setschedparam(self, SCHED_FIFO, &param);
+		if (err != 0)deny(worker + "SCHED_FIFO " + std::to_string(jitter.fifoPriority) + ": " + std::strerror(err));
+		else fifo = true;
+	}
+	if (!fifo && jitter.niceValue != 0)
+	{
+		//Linux applies nice per thread id
+		id_t tid = static_cast<id_t>(syscall(SYS_gettid));
+		if (setpriority(PRIO_PROCESS, tid, jitter.niceValue) != 0)
+			deny(worker + "nice " + std::to_string(jitter.niceValue) + ": " + std::strerror(errno));
+	}
+#endif
+	if (jitter.prefaultStacks)prefaultStack();
+}
+
+void ThreadPool::deny(const std::string& setting)
+{
+	std::lock_guard<std::mutex> lock(lockShared);
+	denied.push_back(setting);
 }
\ No newline at end of file
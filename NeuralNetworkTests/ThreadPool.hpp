@@ -1,6 +1,6 @@
 /*
 Author: Dan Rehberg
-Date Modified: 8/4/2021
+Date Modified: 10/19/2026
 */
 
 #ifndef __THREAD_POOL__
@@ -10,21 +10,40 @@ Date Modified: 8/4/2021
 #include <condition_variable>//setting threads to sleep
 #include <cstdint>
 #include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
 
 //0 to sleep, 1 to spin - this is just which mechanism to synchronize threads
 #define SLEEP_OR_SPIN 1
+//Bytes of each worker's stack touched before the first dispatch when in low jitter mode
+#define LOW_JITTER_STACK_BYTES (64 * 1024)
+
+//Opt-in settings for reducing tail latency of the spin mode, each setting is only attempted
+//	and any the environment denies (permissions, rlimits, platform) is reported by the pool
+struct LowJitterSettings
+{
+	int fifoPriority = 1;//SCHED_FIFO priority, only attempted with one cpu per worker (spinning never yields), 0 to skip
+	int niceValue = -10;//Fallback when SCHED_FIFO is denied, 0 to skip
+	bool lockMemory = true;//Lock current and future pages of the process (matrix buffers included)
+	bool prefaultStacks = true;//Touch LOW_JITTER_STACK_BYTES of each worker stack before running tasks
+	std::vector<unsigned int> cpus;//Isolated CPUs the workers are restricted to (worker i to cpus[i % size]), empty to not pin
+};
 
 class ThreadPool final
 {
 public:
 	ThreadPool();//To let the class decide the size of the thread pool
 	ThreadPool(unsigned int threadCount);//Manually set size of the thread pool
+	ThreadPool(unsigned int threadCount, const LowJitterSettings& settings);//Low jitter mode, settings applied before returning
 	~ThreadPool();
 	ThreadPool(const ThreadPool&) = delete;
 	ThreadPool& operator=(const ThreadPool&) = delete;
-	void dispatch(uint32_t taskCount, void(*task)(std::mutex&, unsigned int));
+	void dispatch(uint64_t taskCount, void(*task)(std::mutex&, uint64_t));
+	void dispatch(uint64_t taskCount, void(*task)(std::mutex&, uint64_t, uint64_t));//Range based, each thread is given its [start, end) once
 	void initialized();
+	const std::vector<std::string>& getDeniedSettings() const;//Low jitter settings the environment refused
+	void prefault(const void* buffer, size_t bytes);//Lock and read every page of a buffer (e.g., matrix data) before timing, nothing is written
 private:
 	std::condition_variable blockFinish;
 	volatile bool blockIsFinished = false;
@@ -33,15 +52,22 @@ private:
 	std::atomic_bool mainRest = false;
 	std::condition_variable blockMain;
 	std::condition_variable blockStart;
+	void applyLowJitter(const unsigned int i);//Called by each worker on itself before the starting line
+	void deny(const std::string& setting);
+	std::vector<std::string> denied;
+	LowJitterSettings jitter;
+	bool lowJitter = false;
 	volatile bool close = false;//If the thread pool needs to stop running -- set destructor explicitly to verify threads terminated before destroying threads array
 	std::atomic_uint32_t completeCounter;//How many threads have finished something...
-	void(*f)(std::mutex&, unsigned int) = nullptr;
+	void(*f)(std::mutex&, uint64_t) = nullptr;
+	void(*fRange)(std::mutex&, uint64_t, uint64_t) = nullptr;
 	void g(const unsigned int i);//The function for the thread(s) to exist in until the program needs to close
 	bool init = false;
 	std::mutex lockShared;
 	std::mutex lockThreads;
-	volatile uint32_t n = 0;//This is the number of tasks a thread might work on - maximum
-	volatile uint32_t N = 0;//Total number of tasks in a Dispatch call
+	void run(uint64_t taskCount);//Releases the threads on the current task function and waits for them
+	volatile uint64_t n = 0;//This is the number of tasks a thread might work on - maximum
+	volatile uint64_t N = 0;//Total number of tasks in a Dispatch call
 	std::atomic_uint32_t terminated;
 	const unsigned int threadCount;
 	std::thread* threads = nullptr;//Thread pool itself
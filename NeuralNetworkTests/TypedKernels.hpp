@@ -0,0 +1,478 @@
+/*
+Author: Dan Rehberg
+Modified Date: 10/19/2026
+Purpose: The MatrixKernels operations for matrices stored as T and computed in Acc, as used by BasicSerialMatrix.
+	float stored and computed in float is MatrixKernels as it is.
+	A float accumulator over other storage (BFloat16, Float16) converts one row at a time into a per thread float buffer,
+		runs the SIMD kernels on it, and rounds the result back on store; the GEMM converts its operands as it packs them,
+		so only C is held in float for the length of the product.
+	Any other accumulator (double) runs plain loops, vectorized as far as the compiler manages.
+*/
+
+#ifndef __TYPED_KERNELS__
+#define __TYPED_KERNELS__
+
+#include "MatrixKernels.hpp"
+#include "MatrixExpressions.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+template <typename T, typename Acc = typename MatrixAccumulator<T>::type>
+class TypedKernels final
+{
+public:
+	TypedKernels() = delete;
+	static constexpr bool native = std::is_same<T, float>::value && std::is_same<Acc, float>::value;
+	static constexpr bool simd = std::is_same<Acc, float>::value;//Rows in float run the MatrixKernels
+	static constexpr bool packed = simd && (std::is_same<T, BFloat16>::value || std::is_same<T, Float16>::value);
+
+	//C = activation(alpha * op(A) * op(B) + beta * C + bias), as MatrixKernels::gemm
+	static void gemm(bool transA, bool transB, size_t m, size_t n, size_t k, Acc alpha, const T* A, size_t lda,
+		const T* B, size_t ldb, Acc beta, T* C, size_t ldc, const T* bias = nullptr, Activation activation = Activation::None)
+	{
+		if constexpr (native)MatrixKernels::gemm(transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, bias, activation);
+		else if constexpr (packed)
+		{
+			if (m == 0 || n == 0)return;
+			std::vector<Acc>& c = buffer(2);
+			if (c.size() < m * n)c.resize(m * n);
+			if (beta != Acc(0))
+			{
+				for (size_t i = 0; i < m; ++i)convert(C + i * ldc, n, c.data() + i * n);
+			}
+			MatrixKernels::gemm(transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, c.data(), n,
+				bias != nullptr ? load(bias, n, buffer(0)) : nullptr, activation);
+			for (size_t i = 0; i < m; ++i)store(c.data() + i * n, n, C + i * ldc);
+		}
+		else
+		{
+			//Row i of C accumulates alpha * A(i, p) * row p of B, so B and C are both walked along rows
+			const Acc* b = (bias != nullptr) ? load(bias, n, buffer(0)) : nullptr;
+			for (size_t i = 0; i < m; ++i)
+			{
+				Acc* c = (beta == Acc(0)) ? target(C + i * ldc, n, buffer(2)) : modify(C + i * ldc, n, buffer(2));
+				for (size_t j = 0; j < n; ++j)c[j] = ((beta == Acc(0)) ? Acc(0) : beta * c[j]) + (b != nullptr ? b[j] : Acc(0));
+				for (size_t p = 0; p < k; ++p)
+				{
+					Acc a = alpha * static_cast<Acc>(transA ? A[p * lda + i] : A[i * lda + p]);
+					if (transB)
+					{
+						for (size_t j = 0; j < n; ++j)c[j] += a * static_cast<Acc>(B[j * ldb + p]);
+						continue;
+					}
+					const Acc* row = load(B + p * ldb, n, buffer(1));
+					for (size_t j = 0; j < n; ++j)c[j] += a * row[j];
+				}
+				if (activation == Activation::TanH)tanh(n, c, c);
+				store(c, n, C + i * ldc);
+			}
+		}
+	}
+	static void elementwise(ElementOp op, size_t rows, size_t columns, const T* A, size_t lda,
+		const T* B, size_t ldb, T* C, size_t ldc)//C = A op B
+	{
+		if constexpr (native)MatrixKernels::elementwise(op, rows, columns, A, lda, B, ldb, C, ldc);
+		else
+		{
+			for (size_t i = 0; i < rows; ++i)
+			{
+				Acc* c = target(C + i * ldc, columns, buffer(2));
+				binary(op, columns, load(A + i * lda, columns, buffer(0)), load(B + i * ldb, columns, buffer(1)), c);
+				store(c, columns, C + i * ldc);
+			}
+		}
+	}
+	static void broadcastRow(ElementOp op, size_t rows, size_t columns, const T* A, size_t lda,
+		const T* row, T* C, size_t ldc)//Each row of C = row of A op the row vector
+	{
+		if constexpr (native)MatrixKernels::broadcastRow(op, rows, columns, A, lda, row, C, ldc);
+		else
+		{
+			const Acc* r = load(row, columns, buffer(1));
+			for (size_t i = 0; i < rows; ++i)
+			{
+				Acc* c = target(C + i * ldc, columns, buffer(2));
+				binary(op, columns, load(A + i * lda, columns, buffer(0)), r, c);
+				store(c, columns, C + i * ldc);
+			}
+		}
+	}
+	static void scalarLeft(ElementOp op, size_t rows, size_t columns, Acc s, const T* A, size_t lda, T* C, size_t ldc)//C = s op A
+	{
+		if constexpr (native)MatrixKernels::scalarLeft(op, rows, columns, s, A, lda, C, ldc);
+		else
+		{
+			for (size_t i = 0; i < rows; ++i)
+			{
+				const Acc* a = load(A + i * lda, columns, buffer(0));
+				Acc* c = target(C + i * ldc, columns, buffer(2));
+				if constexpr (simd)MatrixKernels::scalarLeft(op, columns, s, a, c);
+				else
+				{
+					switch (op)
+					{
+					case ElementOp::Add: for (size_t j = 0; j < columns; ++j)c[j] = s + a[j]; break;
+					case ElementOp::Subtract: for (size_t j = 0; j < columns; ++j)c[j] = s - a[j]; break;
+					case ElementOp::Multiply: for (size_t j = 0; j < columns; ++j)c[j] = s * a[j]; break;
+					default: for (size_t j = 0; j < columns; ++j)c[j] = s / a[j]; break;
+					}
+				}
+				store(c, columns, C + i * ldc);
+			}
+		}
+	}
+	static void square(size_t rows, size_t columns, const T* A, size_t lda, T* C, size_t ldc)
+	{
+		if constexpr (native)MatrixKernels::square(rows, columns, A, lda, C, ldc);
+		else
+		{
+			for (size_t i = 0; i < rows; ++i)
+			{
+				const Acc* a = load(A + i * lda, columns, buffer(0));
+				Acc* c = target(C + i * ldc, columns, buffer(2));
+				if constexpr (simd)MatrixKernels::square(columns, a, c);
+				else
+				{
+					for (size_t j = 0; j < columns; ++j)c[j] = a[j] * a[j];
+				}
+				store(c, columns, C + i * ldc);
+			}
+		}
+	}
+	static void axpy(size_t rows, size_t columns, Acc a, const T* X, size_t ldx, T* Y, size_t ldy)//Y += a * X
+	{
+		if constexpr (native)MatrixKernels::axpy(rows, columns, a, X, ldx, Y, ldy);
+		else
+		{
+			Acc* y = nullptr;
+			for (size_t i = 0; i < rows; ++i)
+			{
+				//ldy 0 sums every row of X into the one row of Y, converted and rounded once rather than per row
+				if (i == 0 || ldy != 0)y = modify(Y + i * ldy, columns, buffer(2));
+				const Acc* x = load(X + i * ldx, columns, buffer(0));
+				if constexpr (simd)MatrixKernels::axpy(columns, a, x, y);
+				else
+				{
+					for (size_t j = 0; j < columns; ++j)y[j] += a * x[j];
+				}
+				if (ldy != 0 || i + 1 == rows)store(y, columns, Y + i * ldy);
+			}
+		}
+	}
+	static Acc sum(size_t rows, size_t columns, const T* A, size_t lda)
+	{
+		if constexpr (native)return MatrixKernels::sum(rows, columns, A, lda);
+		else
+		{
+			Acc total = Acc(0);
+			for (size_t i = 0; i < rows; ++i)
+			{
+				const Acc* a = load(A + i * lda, columns, buffer(0));
+				if constexpr (simd)total += MatrixKernels::sum(columns, a);
+				else
+				{
+					for (size_t j = 0; j < columns; ++j)total += a[j];
+				}
+			}
+			return total;
+		}
+	}
+	static void columnSums(size_t rows, size_t columns, const T* A, size_t lda, Acc* sums)//sums += each row
+	{
+		if constexpr (native)MatrixKernels::columnSums(rows, columns, A, lda, sums);
+		else
+		{
+			for (size_t i = 0; i < rows; ++i)binary(ElementOp::Add, columns, sums, load(A + i * lda, columns, buffer(0)), sums);
+		}
+	}
+	static void columnSquaredDeviations(size_t rows, size_t columns, const T* A, size_t lda,
+		const Acc* mean, Acc* sums)//sums += (each row - mean)^2
+	{
+		if constexpr (native)MatrixKernels::columnSquaredDeviations(rows, columns, A, lda, mean, sums);
+		else
+		{
+			for (size_t i = 0; i < rows; ++i)
+			{
+				const Acc* a = load(A + i * lda, columns, buffer(0));
+				if constexpr (simd)MatrixKernels::columnSquaredDeviations(1, columns, a, columns, mean, sums);
+				else
+				{
+					for (size_t j = 0; j < columns; ++j)sums[j] += (a[j] - mean[j]) * (a[j] - mean[j]);
+				}
+			}
+		}
+	}
+	static void columnMoments(size_t rows, size_t columns, const T* A, size_t lda, size_t seen,
+		Acc* mean, Acc* m2)//Welford, as MatrixKernels::columnMoments
+	{
+		if constexpr (native)MatrixKernels::columnMoments(rows, columns, A, lda, seen, mean, m2);
+		else
+		{
+			for (size_t i = 0; i < rows; ++i)
+			{
+				const Acc* a = load(A + i * lda, columns, buffer(0));
+				if constexpr (simd)MatrixKernels::columnMoments(1, columns, a, columns, seen + i, mean, m2);
+				else
+				{
+					Acc inv = Acc(1) / static_cast<Acc>(seen + i + 1);
+					for (size_t j = 0; j < columns; ++j)
+					{
+						Acc d = a[j] - mean[j];
+						mean[j] += d * inv;
+						m2[j] += d * (a[j] - mean[j]);
+					}
+				}
+			}
+		}
+	}
+	//Transposes move elements as they are stored, so only float has the register tiles; other types are blocked the same way
+	static void transpose(size_t rows, size_t columns, const T* A, size_t lda, T* B, size_t ldb)//B = A^T
+	{
+		if constexpr (std::is_same<T, float>::value)MatrixKernels::transpose(rows, columns, A, lda, B, ldb);
+		else
+		{
+			for (size_t i0 = 0; i0 < rows; i0 += TRANSPOSE_BLOCK)
+			{
+				size_t i1 = std::min<size_t>(i0 + TRANSPOSE_BLOCK, rows);
+				for (size_t j0 = 0; j0 < columns; j0 += TRANSPOSE_BLOCK)
+				{
+					size_t j1 = std::min<size_t>(j0 + TRANSPOSE_BLOCK, columns);
+					for (size_t i = i0; i < i1; ++i)
+					{
+						for (size_t j = j0; j < j1; ++j)B[j * ldb + i] = A[i * lda + j];
+					}
+				}
+			}
+		}
+	}
+	static void transposeSquare(size_t n, T* A, size_t lda)//In place
+	{
+		if constexpr (std::is_same<T, float>::value)MatrixKernels::transposeSquare(n, A, lda);
+		else
+		{
+			for (size_t i0 = 0; i0 < n; i0 += TRANSPOSE_BLOCK)
+			{
+				for (size_t j0 = i0; j0 < n; j0 += TRANSPOSE_BLOCK)
+				{
+					for (size_t i = i0; i < std::min<size_t>(i0 + TRANSPOSE_BLOCK, n); ++i)
+					{
+						for (size_t j = std::max(j0, i + 1); j < std::min<size_t>(j0 + TRANSPOSE_BLOCK, n); ++j)
+							std::swap(A[i * lda + j], A[j * lda + i]);
+					}
+				}
+			}
+		}
+	}
+	//Strassen-Winograd, C = A * B for n x n operands: 7 half size products and 15 additions per level rather than 8 products,
+	//	recursing while n is at least cutoff and running gemm below it; an odd n leaves its last row and column to gemm
+	//	The sums are stored as T, so 16 bit types would round at every level; workspace holds strassenWorkspace(n, cutoff) elements
+	static size_t strassenWorkspace(size_t n, size_t cutoff)//Two half size temporaries per level
+	{
+		size_t total = 0;
+		for (; n >= cutoff && n >= 2; n /= 2)total += 2 * (n / 2) * (n / 2);
+		return total;
+	}
+	static void gemmStrassen(size_t n, const T* A, size_t lda, const T* B, size_t ldb, T* C, size_t ldc, size_t cutoff, T* workspace)
+	{
+		if (n < cutoff || n < 2)
+		{
+			gemm(false, false, n, n, n, Acc(1), A, lda, B, ldb, Acc(0), C, ldc);
+			return;
+		}
+		//Boyer et al.'s schedule, the quadrants of C hold products and partial sums so X and Y are the only temporaries
+		size_t h = n / 2;
+		const T* A12 = A + h, * A21 = A + h * lda, * A22 = A21 + h;
+		const T* B12 = B + h, * B21 = B + h * ldb, * B22 = B21 + h;
+		T* C12 = C + h, * C21 = C + h * ldc, * C22 = C21 + h;
+		T* X = workspace, * Y = workspace + h * h, * next = Y + h * h;
+		elementwise(ElementOp::Subtract, h, h, A, lda, A21, lda, X, h);//S3
+		elementwise(ElementOp::Subtract, h, h, B22, ldb, B12, ldb, Y, h);//T3
+		gemmStrassen(h, X, h, Y, h, C21, ldc, cutoff, next);//M7
+		elementwise(ElementOp::Add, h, h, A21, lda, A22, lda, X, h);//S1
+		elementwise(ElementOp::Subtract, h, h, B12, ldb, B, ldb, Y, h);//T1
+		gemmStrassen(h, X, h, Y, h, C22, ldc, cutoff, next);//M5
+		elementwise(ElementOp::Subtract, h, h, X, h, A, lda, X, h);//S2
+		elementwise(ElementOp::Subtract, h, h, B22, ldb, Y, h, Y, h);//T2
+		gemmStrassen(h, X, h, Y, h, C12, ldc, cutoff, next);//M6
+		elementwise(ElementOp::Subtract, h, h, A12, lda, X, h, X, h);//S4
+		gemmStrassen(h, X, h, B22, ldb, C, ldc, cutoff, next);//M3
+		gemmStrassen(h, A, lda, B, ldb, X, h, cutoff, next);//M1
+		elementwise(ElementOp::Add, h, h, X, h, C12, ldc, C12, ldc);//M1 + M6
+		elementwise(ElementOp::Add, h, h, C12, ldc, C21, ldc, C21, ldc);//+ M7
+		elementwise(ElementOp::Add, h, h, C12, ldc, C22, ldc, C12, ldc);//M1 + M6 + M5
+		elementwise(ElementOp::Add, h, h, C21, ldc, C22, ldc, C22, ldc);//C22
+		elementwise(ElementOp::Add, h, h, C12, ldc, C, ldc, C12, ldc);//C12
+		elementwise(ElementOp::Subtract, h, h, Y, h, B21, ldb, Y, h);//T4
+		gemmStrassen(h, A22, lda, Y, h, C, ldc, cutoff, next);//M4
+		elementwise(ElementOp::Subtract, h, h, C21, ldc, C, ldc, C21, ldc);//C21
+		gemmStrassen(h, A12, lda, B21, ldb, C, ldc, cutoff, next);//M2
+		elementwise(ElementOp::Add, h, h, X, h, C, ldc, C, ldc);//C11
+		strassenEdges(n, A, lda, B, ldb, C, ldc);
+	}
+	//The top level's 7 products as independent tasks: strassenProduct(p) for p in [0, 7), in any order or at once,
+	//	then strassenCombine; each product has its own operands and recursion in workspace (strassenParallelWorkspace elements)
+	static size_t strassenParallelWorkspace(size_t n, size_t cutoff)
+	{
+		size_t h = n / 2;
+		return 3 * h * h + 7 * (2 * h * h + strassenWorkspace(h, cutoff));
+	}
+	static void strassenProduct(size_t product, size_t n, const T* A, size_t lda, const T* B, size_t ldb, T* C, size_t ldc,
+		size_t cutoff, T* workspace)
+	{
+		size_t h = n / 2;
+		const T* A12 = A + h, * A21 = A + h * lda, * A22 = A21 + h;
+		const T* B12 = B + h, * B21 = B + h * ldb, * B22 = B21 + h;
+		T* X = workspace + 3 * h * h + product * (2 * h * h + strassenWorkspace(h, cutoff)), * Y = X + h * h, * next = Y + h * h;
+		//M2, M5, M6 and M7 are written where the serial schedule leaves them, M1, M3 and M4 to the front of workspace
+		switch (product)
+		{
+		case 0:
+			gemmStrassen(h, A, lda, B, ldb, workspace, h, cutoff, next);
+			break;
+		case 1:
+			gemmStrassen(h, A12, lda, B21, ldb, C, ldc, cutoff, next);
+			break;
+		case 2:
+			elementwise(ElementOp::Add, h, h, A21, lda, A22, lda, X, h);
+			elementwise(ElementOp::Subtract, h, h, X, h, A, lda, X, h);
+			elementwise(ElementOp::Subtract, h, h, A12, lda, X, h, X, h);
+			gemmStrassen(h, X, h, B22, ldb, workspace + h * h, h, cutoff, next);
+			break;
+		case 3:
+			elementwise(ElementOp::Subtract, h, h, B12, ldb, B, ldb, Y, h);
+			elementwise(ElementOp::Subtract, h, h, B22, ldb, Y, h, Y, h);
+			elementwise(ElementOp::Subtract, h, h, Y, h, B21, ldb, Y, h);
+			gemmStrassen(h, A22, lda, Y, h, workspace + 2 * h * h, h, cutoff, next);
+			break;
+		case 4:
+			elementwise(ElementOp::Add, h, h, A21, lda, A22, lda, X, h);
+			elementwise(ElementOp::Subtract, h, h, B12, ldb, B, ldb, Y, h);
+			gemmStrassen(h, X, h, Y, h, C + h * ldc + h, ldc, cutoff, next);
+			break;
+		case 5:
+			elementwise(ElementOp::Add, h, h, A21, lda, A22, lda, X, h);
+			elementwise(ElementOp::Subtract, h, h, X, h, A, lda, X, h);
+			elementwise(ElementOp::Subtract, h, h, B12, ldb, B, ldb, Y, h);
+			elementwise(ElementOp::Subtract, h, h, B22, ldb, Y, h, Y, h);
+			gemmStrassen(h, X, h, Y, h, C + h, ldc, cutoff, next);
+			break;
+		default:
+			elementwise(ElementOp::Subtract, h, h, A, lda, A21, lda, X, h);
+			elementwise(ElementOp::Subtract, h, h, B22, ldb, B12, ldb, Y, h);
+			gemmStrassen(h, X, h, Y, h, C + h * ldc, ldc, cutoff, next);
+			break;
+		}
+	}
+	static void strassenCombine(size_t n, const T* A, size_t lda, const T* B, size_t ldb, T* C, size_t ldc, const T* workspace)
+	{
+		size_t h = n / 2;
+		const T* M1 = workspace, * M3 = M1 + h * h, * M4 = M3 + h * h;
+		T* C12 = C + h, * C21 = C + h * ldc, * C22 = C21 + h;
+		elementwise(ElementOp::Add, h, h, M1, h, C12, ldc, C12, ldc);
+		elementwise(ElementOp::Add, h, h, C12, ldc, C21, ldc, C21, ldc);
+		elementwise(ElementOp::Add, h, h, C12, ldc, C22, ldc, C12, ldc);
+		elementwise(ElementOp::Add, h, h, C21, ldc, C22, ldc, C22, ldc);
+		elementwise(ElementOp::Add, h, h, C12, ldc, M3, h, C12, ldc);
+		elementwise(ElementOp::Subtract, h, h, C21, ldc, M4, h, C21, ldc);
+		elementwise(ElementOp::Add, h, h, M1, h, C, ldc, C, ldc);
+		strassenEdges(n, A, lda, B, ldb, C, ldc);
+	}
+	static void activate(Activation activation, size_t count, const T* A, T* C)//C = activation(A)
+	{
+		if constexpr (native)MatrixKernels::activate(activation, count, A, C);
+		else
+		{
+			const Acc* a = load(A, count, buffer(0));
+			Acc* c = target(C, count, buffer(2));
+			if (activation == Activation::TanH)tanh(count, a, c);
+			else std::copy(a, a + count, c);
+			store(c, count, C);
+		}
+	}
+private:
+	//An odd n: the even leading block gets the last column of A times the last row of B, then the last row and column of C
+	static void strassenEdges(size_t n, const T* A, size_t lda, const T* B, size_t ldb, T* C, size_t ldc)
+	{
+		if (n % 2 == 0)return;
+		size_t m = n - 1;
+		gemm(false, false, m, m, 1, Acc(1), A + m, lda, B + m * ldb, ldb, Acc(1), C, ldc);
+		gemm(false, false, m, 1, n, Acc(1), A, lda, B + m, ldb, Acc(0), C + m, ldc);
+		gemm(false, false, 1, n, n, Acc(1), A + m * lda, lda, B, ldb, Acc(0), C + m * ldc, ldc);
+	}
+	//Conversion buffers per thread: 0 and 1 for operands, 2 for the result; grown once, then reused
+	static std::vector<Acc>& buffer(size_t which)
+	{
+		thread_local std::vector<Acc> buffers[3];
+		return buffers[which];
+	}
+	static void convert(const T* values, size_t count, Acc* out)
+	{
+		for (size_t j = 0; j < count; ++j)out[j] = static_cast<Acc>(values[j]);
+	}
+	//A row as Acc, read in place when no conversion is needed
+	static const Acc* load(const T* values, size_t count, std::vector<Acc>& scratch)
+	{
+		if constexpr (std::is_same<T, Acc>::value)return values;
+		else
+		{
+			if (scratch.size() < count)scratch.resize(count);
+			convert(values, count, scratch.data());
+			return scratch.data();
+		}
+	}
+	//Where a result row is computed before store, modify also reads the row's current values
+	static Acc* target(T* values, size_t count, std::vector<Acc>& scratch)
+	{
+		if constexpr (std::is_same<T, Acc>::value)return values;
+		else
+		{
+			if (scratch.size() < count)scratch.resize(count);
+			return scratch.data();
+		}
+	}
+	static Acc* modify(T* values, size_t count, std::vector<Acc>& scratch)
+	{
+		Acc* out = target(values, count, scratch);
+		if constexpr (!std::is_same<T, Acc>::value)convert(values, count, out);
+		return out;
+	}
+	static void store(const Acc* values, size_t count, T* out)
+	{
+		if constexpr (!std::is_same<T, Acc>::value)
+		{
+			for (size_t j = 0; j < count; ++j)out[j] = static_cast<T>(values[j]);
+		}
+	}
+	template <ElementOp Op>
+	static void binaryLoop(size_t count, const Acc* A, const Acc* B, Acc* C)
+	{
+		for (size_t j = 0; j < count; ++j)C[j] = ElementFunction<Op>::apply(A[j], B[j]);
+	}
+	static void binary(ElementOp op, size_t count, const Acc* A, const Acc* B, Acc* C)
+	{
+		if constexpr (simd)MatrixKernels::elementwise(op, count, A, B, C);
+		else
+		{
+			switch (op)
+			{
+			case ElementOp::Add: binaryLoop<ElementOp::Add>(count, A, B, C); break;
+			case ElementOp::Subtract: binaryLoop<ElementOp::Subtract>(count, A, B, C); break;
+			case ElementOp::Multiply: binaryLoop<ElementOp::Multiply>(count, A, B, C); break;
+			default: binaryLoop<ElementOp::Divide>(count, A, B, C); break;
+			}
+		}
+	}
+	static void tanh(size_t count, const Acc* A, Acc* C)
+	{
+		if constexpr (simd)MatrixKernels::activate(Activation::TanH, count, A, C);
+		else
+		{
+			for (size_t j = 0; j < count; ++j)C[j] = std::tanh(A[j]);
+		}
+	}
+};
+
+#endif // !__TYPED_KERNELS__
\ No newline at end of file
@@ -1,19 +1,310 @@
 /*
 Author: Dan Rehberg
-Modified Date: 12/9/2022
+Modified Date: 10/19/2026
 */
 #include <iostream>
 #include <stdexcept>
 #include <array>
 #include <vector>
 #include <chrono>
+#include <cmath>
+#include <limits>
 #include "SerialMatrix.hpp"
 #include "ThreadPool.hpp"
 #include "NeuralNetwork.hpp"
 #include "NeuralNetworkParallel.hpp"
+#include "KernelBenchmarks.hpp"
+
+//1 to time the raw kernels against the implementations they replaced before the network cases
+#define RUN_KERNEL_BENCHMARKS 0
+//1 to count heap allocations in a steady state training epoch, replaces the global allocation functions
+#define CHECK_EPOCH_ALLOCATIONS 0
+//1 to run the matrix cases below, each printed as pass or FAIL
+#define CHECK_MATRIX_CASES 0
+
+#if CHECK_EPOCH_ALLOCATIONS
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+static std::atomic<uint64_t> allocationCount(0);
+
+void* operator new(size_t size)
+{
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	void* memory = std::malloc(size == 0 ? 1 : size);
+	if (memory == nullptr)throw std::bad_alloc();
+	return memory;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept
+{
+	return operator new(size, tag);
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+	std::free(memory);
+}
+
+//Matrices allocate MATRIX_ALIGNMENT aligned buffers, counted the same way
+static void* alignedAllocate(size_t size, std::align_val_t alignment)
+{
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	size_t bytes = static_cast<size_t>(alignment);
+	size = (size == 0 ? 1 : size);
+#ifdef _WIN32
+	return _aligned_malloc(size, bytes);
+#else
+	return std::aligned_alloc(bytes, (size + bytes - 1) / bytes * bytes);
+#endif
+}
+
+static void alignedRelease(void* memory)
+{
+#ifdef _WIN32
+	_aligned_free(memory);
+#else
+	std::free(memory);
+#endif
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	void* memory = alignedAllocate(size, alignment);
+	if (memory == nullptr)throw std::bad_alloc();
+	return memory;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	return operator new(size, alignment);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return alignedAllocate(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return alignedAllocate(size, alignment);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+	alignedRelease(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept
+{
+	alignedRelease(memory);
+}
+
+void operator delete(void* memory, size_t, std::align_val_t) noexcept
+{
+	alignedRelease(memory);
+}
+
+void operator delete[](void* memory, size_t, std::align_val_t) noexcept
+{
+	alignedRelease(memory);
+}
+
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	alignedRelease(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	alignedRelease(memory);
+}
+
+//train(11 epochs) - train(1 epoch) on a warmed up network leaves 10 epochs with the per call setup cancelled out
+template <typename Network>
+static uint64_t allocationsPerEpoch(Network& nn, const SerialMatrix& X, const SerialMatrix& T)
+{
+	nn.testWeights();
+	nn.train(X, T, 1, 0.1f);//First epoch sizes every buffer
+	uint64_t start = allocationCount.load();
+	nn.train(X, T, 1, 0.1f);
+	uint64_t one = allocationCount.load() - start;
+	start = allocationCount.load();
+	nn.train(X, T, 11, 0.1f);
+	uint64_t eleven = allocationCount.load() - start;
+	return (eleven - one) / 10;
+}
+
+static void checkEpochAllocations()
+{
+	std::vector<std::vector<float>> xData;
+	std::vector<std::vector<float>> tData;
+	for (unsigned int i = 0; i < 100; ++i)
+	{
+		float val = static_cast<float>(i) * 0.1f;
+		xData.push_back({ val });
+		tData.push_back({ std::sin(val) + 0.01f * (val * val) });
+	}
+	SerialMatrix X(xData);
+	SerialMatrix T(tData);
+	NeuralNetwork nn(1, { 10,5 }, 1);
+	NeuralNetworkParallel pnn(1, { 10,5 }, 1);
+	uint64_t serial = allocationsPerEpoch(nn, X, T);
+	uint64_t parallel = allocationsPerEpoch(pnn, X, T);
+	std::cout << "Heap allocations per steady state epoch: serial " << serial << ", parallel " << parallel <<
+		((serial == 0 && parallel == 0) ? " (pass)\n" : " (FAIL, expected 0)\n");
+}
+#endif
+
+#if CHECK_MATRIX_CASES
+static void checkCase(const char* name, bool passed)
+{
+	std::cout << name << (passed ? ": pass\n" : ": FAIL\n");
+}
+
+static SerialMatrix countingMatrix(size_t rows, size_t columns)
+{
+	std::vector<std::vector<float>> values(rows, std::vector<float>(columns));
+	for (size_t i = 0; i < rows; ++i)
+		for (size_t j = 0; j < columns; ++j)values[i][j] = static_cast<float>(i * columns + j);
+	return SerialMatrix(values);
+}
+
+//Within a relative 1e-5 of the expected row of values
+static bool nearRow(const SerialMatrix& A, const std::vector<float>& values)
+{
+	if (A.getDimensions() != std::pair<size_t, size_t>(1, values.size()))return false;
+	for (size_t j = 0; j < values.size(); ++j)
+	{
+		if (std::abs(A.at(0, j) - values[j]) > 1e-5f * std::abs(values[j]))return false;
+	}
+	return true;
+}
+
+static void checkMatrixCases()
+{
+	std::cout << "\nMatrix cases\n";
+	//Views of the destination read other than as it is written go through a new buffer
+	SerialMatrix A = countingMatrix(5, 5), expected = SerialMatrix::transpose(A);
+	A = A.view().transpose();
+	checkCase("A = transpose of A, 5x5", A == expected);
+	SerialMatrix W = countingMatrix(2, 3);
+	expected = SerialMatrix::transpose(W);
+	W = W.view().transpose();
+	checkCase("A = transpose of A, 2x3 into a 3x2 of the same storage", W == expected);
+	SerialMatrix B = countingMatrix(4, 3);
+	expected = B + SerialMatrix(B.view().rowSlice(0, 1));
+	B = B + B.view().rowSlice(0, 1);
+	checkCase("B = B + first row of B", B == expected);
+	//The ones column is added to A as read, after its transpose, as SparseMatrix::multiply does
+	SerialMatrix X = countingMatrix(8, 50), W9 = countingMatrix(9, 9), C;
+	expected = SerialMatrix::addOnes(SerialMatrix::transpose(X)) * W9;
+	SerialMatrix::addOnesMultiply(C, X.view().transpose(), W9);
+	checkCase("addOnesMultiply of a transposed view, 50x9", C == expected);
+	//Fixed size arrays, constructed and assigned over an existing buffer
+	std::array<std::array<float, 3>, 2> values = { { { 1.0f, 2.0f, 3.0f }, { 4.0f, 5.0f, 6.0f } } };
+	SerialMatrix F(values), G(2, 3);
+	G = values;
+	expected = SerialMatrix(std::vector<std::vector<float>>{ { 1.0f, 2.0f, 3.0f }, { 4.0f, 5.0f, 6.0f } });
+	checkCase("std::array construction and assignment", F == expected && G == expected);
+	//A transposed input takes the same tanh, at the set accuracy, as the matrix it is a view of
+	TanHAccuracy accuracy = MatrixKernels::getTanHAccuracy();
+	MatrixKernels::setTanHAccuracy(TanHAccuracy::Fast);
+	SerialMatrix H = 0.1f * countingMatrix(6, 4), activated;
+	SerialMatrix::activateTanH(expected, SerialMatrix::transpose(H).view());
+	SerialMatrix::activateTanH(activated, H.view().transpose());
+	MatrixKernels::setTanHAccuracy(accuracy);
+	checkCase("tanh of a transposed view at TanHAccuracy::Fast", activated == expected);
+	//Column statistics reduce each column, until user-029 every column was given the first column's
+	SerialMatrix S(std::vector<std::vector<float>>{ { 1.0f, 10.0f }, { 2.0f, 20.0f }, { 3.0f, 30.0f }, { 4.0f, 40.0f } });
+	std::vector<float> columnMeans = { 2.5f, 25.0f }, columnDeviations = { std::sqrt(1.25f), std::sqrt(125.0f) };
+	SerialMatrix means, deviations;
+	SerialMatrix::statistics(means, deviations, S, false);
+	checkCase("column means", nearRow(SerialMatrix::mean(S, false), columnMeans) && nearRow(means, columnMeans));
+	checkCase("column standard deviations", nearRow(SerialMatrix::standardDeviations(S, false), columnDeviations) &&
+		nearRow(deviations, columnDeviations));
+	checkCase("row means", nearRow(SerialMatrix::mean(S, true), { 5.5f, 11.0f, 16.5f, 22.0f }));
+	//Column major weights through the leading ones products, as the same weights stored row major
+	SerialMatrix L = countingMatrix(5, 3), weights = countingMatrix(4, 2), columnWeights = weights, product;
+	columnWeights.setLayout(MatrixLayout::ColumnMajor);
+	SerialMatrix::addOnesMultiply(expected, L, weights);
+	SerialMatrix::addOnesMultiply(product, L, columnWeights);
+	checkCase("addOnesMultiply with column major weights", product == expected);
+	SerialMatrix errors = countingMatrix(5, 2), columnErrors = errors;
+	columnErrors.setLayout(MatrixLayout::ColumnMajor);
+	SerialMatrix::addOnesTransposeMultiply(expected, L, errors);
+	SerialMatrix::addOnesTransposeMultiply(product, L, columnErrors);
+	checkCase("addOnesTransposeMultiply with a column major right matrix", product == expected);
+	//NaN passes through every tanh and +-inf saturates to exactly +-1, on every ISA the machine has
+	float special[3] = { std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity(),
+		-std::numeric_limits<float>::infinity() }, saturated[3];
+	bool passed = true;
+	KernelISA best = MatrixKernels::detectISA();
+	for (int i = 0; i <= static_cast<int>(best); ++i)
+		for (int mode = 0; mode < 3; ++mode)
+		{
+			MatrixKernels::setISA(static_cast<KernelISA>(i));
+			MatrixKernels::setTanHAccuracy(static_cast<TanHAccuracy>(mode));
+			MatrixKernels::activate(Activation::TanH, 3, special, saturated);
+			passed = passed && std::isnan(saturated[0]) && saturated[1] == 1.0f && saturated[2] == -1.0f;
+		}
+	MatrixKernels::setISA(best);
+	MatrixKernels::setTanHAccuracy(accuracy);
+	checkCase("tanh of NaN and +-inf at every accuracy and ISA", passed);
+}
+#endif
 
 int main()
 {
+#if RUN_KERNEL_BENCHMARKS
+	KernelBenchmarks::all();
+#endif
+#if CHECK_EPOCH_ALLOCATIONS
+	checkEpochAllocations();
+#endif
+#if CHECK_MATRIX_CASES
+	checkMatrixCases();
+#endif
 	
 	
 
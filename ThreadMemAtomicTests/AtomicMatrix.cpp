@@ -1,6 +1,6 @@
 /*
 Author: Dan Rehberg
-Modified Date: 12/20/2022
+Modified Date: 10/19/2026
 */
 #include "AtomicMatrix.hpp"
 
@@ -12,9 +12,9 @@ AtomicMatrix FloatMatrix::atom = std::move(AtomicMatrix(1, 1));
 
 AtomicMatrix::AtomicMatrix() : data(nullptr) {}
 
-AtomicMatrix::AtomicMatrix(unsigned int rows, unsigned int columns) : AtomicMatrix()
+AtomicMatrix::AtomicMatrix(size_t rows, size_t columns) : AtomicMatrix()
 {
-	unsigned int capacity = rows * columns;
+	size_t capacity = rows * columns;
 #if DEBUG_MATRIX >= 1
 	if (capacity == 0)throw std::length_error("(r,c constructor) Cannot have a matrix with zero elements");
 #endif
@@ -23,7 +23,7 @@ AtomicMatrix::AtomicMatrix(unsigned int rows, unsigned int columns) : AtomicMatr
 	if (data == nullptr)std::cout << "ATOMIC ALLOCATION FAILURE!\n";
 #endif
 	if (data == nullptr)return;
-	for (unsigned int i = 0; i < capacity; ++i)
+	for (size_t i = 0; i < capacity; ++i)
 	{
 		data[i].store(0, std::memory_order_relaxed);
 	}
@@ -57,7 +57,7 @@ FloatMatrix::FloatMatrix() : rows(0), columns(0), capacity(0), data(nullptr)
 
 }
 
-FloatMatrix::FloatMatrix(unsigned int r, unsigned int c) : FloatMatrix()
+FloatMatrix::FloatMatrix(size_t r, size_t c) : FloatMatrix()
 {
 	rows = r;
 	columns = c;
@@ -138,9 +138,9 @@ FloatMatrix FloatMatrix::operator*(const FloatMatrix& rhs) const
 	}
 	FloatMatrix temp(rows, rhs.columns);
 	//Going to avoid divisions here with a simple conditional
-	unsigned int offset = 0;
-	unsigned int curRow = 0;
-	for (unsigned int i = 0; offset < temp.capacity; ++i)
+	size_t offset = 0;
+	size_t curRow = 0;
+	for (size_t i = 0; offset < temp.capacity; ++i)
 	{
 		if (i == temp.columns)
 		{
@@ -148,11 +148,11 @@ FloatMatrix FloatMatrix::operator*(const FloatMatrix& rhs) const
 			++curRow;
 		}
 		float sum = 0;
-		unsigned int rowOffset = curRow * this->columns;
+		size_t rowOffset = curRow * this->columns;
 #if DEBUG_MATRIX == 1
 		std::cout << "Dot Product indices\n";
 #endif
-		for (unsigned int j = 0; j < this->columns; ++j)
+		for (size_t j = 0; j < this->columns; ++j)
 		{
 			sum += data[j + rowOffset] * rhs.data[j * rhs.columns + i];
 #if DEBUG_MATRIX == 1
@@ -164,14 +164,14 @@ FloatMatrix FloatMatrix::operator*(const FloatMatrix& rhs) const
 	return temp;
 }
 
-unsigned int FloatMatrix::getCapacity() const
+size_t FloatMatrix::getCapacity() const
 {
 	return capacity;
 }
 
-std::pair<unsigned int, unsigned int> FloatMatrix::getDimensions() const
+std::pair<size_t, size_t> FloatMatrix::getDimensions() const
 {
-	return std::pair<unsigned int, unsigned int>(rows, columns);
+	return std::pair<size_t, size_t>(rows, columns);
 }
 
 std::string FloatMatrix::getInfo() const
@@ -179,7 +179,7 @@ std::string FloatMatrix::getInfo() const
 	if (data == nullptr)return "No Data Stored";
 	std::string temp = "[";
 	//To Mod or not to Mod
-	for (unsigned int i = 0; i < capacity; ++i)
+	for (size_t i = 0; i < capacity; ++i)
 	{
 		if (i % columns == 0)
 		{
@@ -220,13 +220,13 @@ void FloatMatrix::setParallelMatrixOps(FloatMatrix& matA, FloatMatrix& matB, boo
 {
 	FloatMatrix& A = *mA;
 	FloatMatrix& B = *mB;
-	unsigned int dotSize = A.columns;
-	unsigned int c = component / dotSize;
-	unsigned int tModS = component - (c * dotSize);// component% dotSize;
-	unsigned int cDiv = (c / dotSize);
-	unsigned int cMod = c - (cDiv * dotSize);
-	unsigned int indexA = cDiv * dotSize + tModS;// (c / dotSize)* dotSize + tModS;
-	unsigned int indexB = cMod + tModS * dotSize;// (c % dotSize) + tModS * dotSize;
+	size_t dotSize = A.columns;
+	size_t c = component / dotSize;
+	size_t tModS = component - (c * dotSize);// component% dotSize;
+	size_t cDiv = (c / dotSize);
+	size_t cMod = c - (cDiv * dotSize);
+	size_t indexA = cDiv * dotSize + tModS;// (c / dotSize)* dotSize + tModS;
+	size_t indexB = cMod + tModS * dotSize;// (c % dotSize) + tModS * dotSize;
 	if (c != mem.curJob)
 	{
 		if (mem.curJob >= 0) 
@@ -237,21 +237,21 @@ void FloatMatrix::setParallelMatrixOps(FloatMatrix& matA, FloatMatrix& matB, boo
 	mem.memory += mA->data[indexA] * mB->data[indexB];
 }*/
 
-void FloatMatrix::parallelTrialC0AltAlt(std::mutex& m, unsigned int start, unsigned int end)
+void FloatMatrix::parallelTrialC0AltAlt(std::mutex& m, uint64_t start, uint64_t end)
 {
 	FloatMatrix& A = *mA;
 	FloatMatrix& B = *mB;
-	unsigned int dotSize = A.columns;//i.e., how many elements in a row
-	unsigned int bColumns = B.columns;
-	unsigned int c = start / dotSize;
-	unsigned int tModS = start - (c * dotSize);
-	unsigned int cDiv = (c / dotSize);
-	unsigned int cMod = c - (cDiv * dotSize);
-	unsigned int indexA = cDiv * dotSize + tModS;// (c / dotSize)* dotSize + tModS;
-	unsigned int indexB = cMod + tModS * dotSize;// (c % dotSize) + tModS * dotSize;
-	unsigned int cur = indexA % dotSize;
+	size_t dotSize = A.columns;//i.e., how many elements in a row
+	size_t bColumns = B.columns;
+	size_t c = start / dotSize;
+	size_t tModS = start - (c * dotSize);
+	size_t cDiv = (c / dotSize);
+	size_t cMod = c - (cDiv * dotSize);
+	size_t indexA = cDiv * dotSize + tModS;// (c / dotSize)* dotSize + tModS;
+	size_t indexB = cMod + tModS * dotSize;// (c % dotSize) + tModS * dotSize;
+	size_t cur = indexA % dotSize;
 	float count = 0.0f;
-	for (unsigned int i = start; i < end; ++i)
+	for (size_t i = start; i < end; ++i)
 	{
 		++indexA;
 		indexB += bColumns;
@@ -303,7 +303,7 @@ void FloatMatrix::deepCopy(const FloatMatrix& cp, bool allocate)
 	else
 		std::cout << "DEBUG (deepCopy PMat): Repurposing Matrix Data\n";
 #endif
-	for (unsigned int i = 0; i < capacity; ++i)
+	for (size_t i = 0; i < capacity; ++i)
 	{
 		data[i] = cp.data[i];
 	}
@@ -320,8 +320,8 @@ void FloatMatrix::deepCopy(const std::vector<std::vector<float>>& values, bool a
 			cleanStart = false;
 		}
 	}
-	rows = static_cast<unsigned int>(values.size());
-	columns = static_cast<unsigned int>(values[0].size());
+	rows = static_cast<size_t>(values.size());
+	columns = static_cast<size_t>(values[0].size());
 	capacity = rows * columns;
 	if (cleanStart)
 	{
@@ -357,7 +357,7 @@ std::ostream& operator<<(std::ostream& out, const FloatMatrix& mat)
 bool operator==(const FloatMatrix& A, const FloatMatrix& B)
 {
 	if (A.capacity != B.capacity)return false;
-	for (unsigned int i = 0; i < A.capacity; ++i)
+	for (size_t i = 0; i < A.capacity; ++i)
 	{
 		if (A.data[i] != B.data[i])return false;
 	}
@@ -45,7 +45,7 @@ class AtomicMatrix
 private:
 	AtomicMatrix();
 public:
-	AtomicMatrix(unsigned int rows, unsigned int columns); //Not directly accessible
+	AtomicMatrix(size_t rows, size_t columns); //Not directly accessible
 	AtomicMatrix(AtomicMatrix&& rhs);
 	~AtomicMatrix();
 	AtomicMatrix& operator=(AtomicMatrix&& rhs);
@@ -65,7 +65,7 @@ class FloatMatrix
 private:
 	FloatMatrix();//Used to explicitly instantiate variables
 public:
-	FloatMatrix(unsigned int rows, unsigned int columns);//POD, could used fixed length if so desired
+	FloatMatrix(size_t rows, size_t columns);//POD, could used fixed length if so desired
 	template <size_t T, size_t S>
 	FloatMatrix(const std::array<std::array<float, S>, T>& array2D)
 	{
@@ -89,21 +89,21 @@ public:
 	FloatMatrix& operator=(const std::vector<std::vector<float>>& vector2D);
 	friend bool operator==(const FloatMatrix& A, const FloatMatrix& B);
 	FloatMatrix operator*(const FloatMatrix& rhs) const;
-	unsigned int getCapacity() const;
-	std::pair<unsigned int, unsigned int> getDimensions() const;
+	size_t getCapacity() const;
+	std::pair<size_t, size_t> getDimensions() const;
 	std::string getInfo() const;
 	static FloatMatrix getParallelResult();
 	static void setFloatMatrixOps(FloatMatrix& matA);
 	//TODO -- isolate the parallel operations after testing them via MACRO settings
 	static void setParallelMatrixOps(FloatMatrix& matA, FloatMatrix& matB, bool multiplication = true);
 	//static void parallelTrialC0AltAlt(MemoryTest& mem, std::mutex& m, unsigned int taskIndex);
-	static void parallelTrialC0AltAlt(std::mutex& m, unsigned int startTask, unsigned int endTask);
+	static void parallelTrialC0AltAlt(std::mutex& m, uint64_t startTask, uint64_t endTask);
 private:
 	static FloatMatrix* mA, * mB, mC, mD;//C is a resultant, so no pointers; mD is a temporary for the log base 2 dispatch
-	static unsigned int M, N, rI, cJ, curN, curItr;
+	static size_t M, N, rI, cJ, curN, curItr;
 	static AtomicMatrix atom;//for the atomic multiplication tests
-	unsigned int rows, columns;//length of 2D matrix
-	unsigned int capacity;//total cardinality of the 2D matrix
+	size_t rows, columns;//length of 2D matrix
+	size_t capacity;//total cardinality of the 2D matrix
 	float* data;//the matrix innards
 	void deepCopy(const FloatMatrix& cp, bool allocate = true);//!!DATA MODIFICATION!! -- allocate is true, deletes if not nullptr : false, then checks for like parameters to determine deletion
 	template <size_t T, size_t S>
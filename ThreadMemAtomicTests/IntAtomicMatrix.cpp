@@ -1,6 +1,6 @@
 /*
 Author: Dan Rehberg
-Modified Date: 1/3/2023
+Modified Date: 10/19/2026
 */
 #include "IntAtomicMatrix.hpp"
 
@@ -9,14 +9,14 @@ IntegerMatrix* IntegerMatrix::mA = nullptr;
 IntegerMatrix* IntegerMatrix::mB = nullptr;
 IntegerMatrix IntegerMatrix::mC = IntegerMatrix(1, 1);
 AtomicMatrix IntegerMatrix::atom = std::move(AtomicMatrix(1, 1));
-unsigned int IntegerMatrix::atomSize = 0;
+size_t IntegerMatrix::atomSize = 0;
 
 IntegerMatrix::IntegerMatrix() : rows(0), columns(0), capacity(0), data(nullptr)
 {
 
 }
 
-IntegerMatrix::IntegerMatrix(unsigned int r, unsigned int c) : IntegerMatrix()
+IntegerMatrix::IntegerMatrix(size_t r, size_t c) : IntegerMatrix()
 {
 	rows = r;
 	columns = c;
@@ -97,9 +97,9 @@ IntegerMatrix IntegerMatrix::operator*(const IntegerMatrix& rhs) const
 	}
 	IntegerMatrix temp(rows, rhs.columns);
 	//Going to avoid divisions here with a simple conditional
-	unsigned int offset = 0;
-	unsigned int curRow = 0;
-	for (unsigned int i = 0; offset < temp.capacity; ++i)
+	size_t offset = 0;
+	size_t curRow = 0;
+	for (size_t i = 0; offset < temp.capacity; ++i)
 	{
 		if (i == temp.columns)
 		{
@@ -107,11 +107,11 @@ IntegerMatrix IntegerMatrix::operator*(const IntegerMatrix& rhs) const
 			++curRow;
 		}
 		float sum = 0;
-		unsigned int rowOffset = curRow * this->columns;
+		size_t rowOffset = curRow * this->columns;
 #if DEBUG_MATRIX == 1
 		std::cout << "Dot Product indices\n";
 #endif
-		for (unsigned int j = 0; j < this->columns; ++j)
+		for (size_t j = 0; j < this->columns; ++j)
 		{
 			sum += data[j + rowOffset] * rhs.data[j * rhs.columns + i];
 #if DEBUG_MATRIX == 1
@@ -123,14 +123,14 @@ IntegerMatrix IntegerMatrix::operator*(const IntegerMatrix& rhs) const
 	return temp;
 }
 
-unsigned int IntegerMatrix::getCapacity() const
+size_t IntegerMatrix::getCapacity() const
 {
 	return capacity;
 }
 
-std::pair<unsigned int, unsigned int> IntegerMatrix::getDimensions() const
+std::pair<size_t, size_t> IntegerMatrix::getDimensions() const
 {
-	return std::pair<unsigned int, unsigned int>(rows, columns);
+	return std::pair<size_t, size_t>(rows, columns);
 }
 
 std::string IntegerMatrix::getInfo() const
@@ -138,7 +138,7 @@ std::string IntegerMatrix::getInfo() const
 	if (data == nullptr)return "No Data Stored";
 	std::string temp = "[";
 	//To Mod or not to Mod
-	for (unsigned int i = 0; i < capacity; ++i)
+	for (size_t i = 0; i < capacity; ++i)
 	{
 		if (i % columns == 0)
 		{
@@ -179,13 +179,13 @@ void IntegerMatrix::setParallelMatrixOps(IntegerMatrix& matA, IntegerMatrix& mat
 {
 	IntegerMatrix& A = *mA;
 	IntegerMatrix& B = *mB;
-	unsigned int dotSize = A.columns;
-	unsigned int c = component / dotSize;
-	unsigned int tModS = component - (c * dotSize);// component% dotSize;
-	unsigned int cDiv = (c / dotSize);
-	unsigned int cMod = c - (cDiv * dotSize);
-	unsigned int indexA = cDiv * dotSize + tModS;// (c / dotSize)* dotSize + tModS;
-	unsigned int indexB = cMod + tModS * dotSize;// (c % dotSize) + tModS * dotSize;
+	size_t dotSize = A.columns;
+	size_t c = component / dotSize;
+	size_t tModS = component - (c * dotSize);// component% dotSize;
+	size_t cDiv = (c / dotSize);
+	size_t cMod = c - (cDiv * dotSize);
+	size_t indexA = cDiv * dotSize + tModS;// (c / dotSize)* dotSize + tModS;
+	size_t indexB = cMod + tModS * dotSize;// (c % dotSize) + tModS * dotSize;
 	if (c != mem.curJob)
 	{
 		if (mem.curJob >= 0)
@@ -196,21 +196,21 @@ void IntegerMatrix::setParallelMatrixOps(IntegerMatrix& matA, IntegerMatrix& mat
 	mem.memory += mA->data[indexA] * mB->data[indexB];
 }*/
 
-void IntegerMatrix::parallelTrialC0AltAlt(std::mutex& m, unsigned int start, unsigned int end)
+void IntegerMatrix::parallelTrialC0AltAlt(std::mutex& m, uint64_t start, uint64_t end)
 {
 	IntegerMatrix& A = *mA;
 	IntegerMatrix& B = *mB;
-	unsigned int dotSize = A.columns;//i.e., how many elements in a row
-	unsigned int bColumns = B.columns;
-	unsigned int c = start / dotSize;
-	unsigned int tModS = start - (c * dotSize);
-	unsigned int cDiv = (c / dotSize);
-	unsigned int cMod = c - (cDiv * dotSize);
-	unsigned int indexA = cDiv * dotSize + tModS;// (c / dotSize)* dotSize + tModS;
-	unsigned int indexB = cMod + tModS * dotSize;// (c % dotSize) + tModS * dotSize;
-	unsigned int cur = indexA % dotSize;
-	int count = 0;
-	for (unsigned int i = start; i < end; ++i)
+	size_t dotSize = A.columns;//i.e., how many elements in a row
+	size_t bColumns = B.columns;
+	size_t c = start / dotSize;
+	size_t tModS = start - (c * dotSize);
+	size_t cDiv = (c / dotSize);
+	size_t cMod = c - (cDiv * dotSize);
+	size_t indexA = cDiv * dotSize + tModS;// (c / dotSize)* dotSize + tModS;
+	size_t indexB = cMod + tModS * dotSize;// (c % dotSize) + tModS * dotSize;
+	size_t cur = indexA % dotSize;
+	int_fast64_t count = 0;
+	for (size_t i = start; i < end; ++i)
 	{
 		++indexA;
 		indexB += bColumns;
@@ -232,20 +232,20 @@ void IntegerMatrix::parallelTrialC0AltAlt(std::mutex& m, unsigned int start, uns
 	}
 	atom.data[c].fetch_add(count, std::memory_order_relaxed);
 }
-void IntegerMatrix::parallelTrialC0AltAltAlt(std::mutex& m, unsigned int start, unsigned int end)
+void IntegerMatrix::parallelTrialC0AltAltAlt(std::mutex& m, uint64_t start, uint64_t end)
 {
 	IntegerMatrix& A = *mA;
 	IntegerMatrix& B = *mB;
-	unsigned int dotSize = A.columns;
-	unsigned int c = start / dotSize;//index into the C data
-	unsigned int baseA = c / B.columns;// *dotSize;//starting row index for A data
-	unsigned int baseB = c - (baseA * dotSize);// c% B.columns;//starting column index for B data
+	size_t dotSize = A.columns;
+	size_t c = start / dotSize;//index into the C data
+	size_t baseA = c / B.columns;// *dotSize;//starting row index for A data
+	size_t baseB = c - (baseA * dotSize);// c% B.columns;//starting column index for B data
 	baseA *= dotSize;//Removed calculation in declaration to use data to avoid modulus above (no noticable performance change as it occurs once per thread..)
-	unsigned int counter = start - (c * dotSize);//starting position in a dot product (reset per new dot product)
-	unsigned int indexA = baseA + counter;
-	unsigned int indexB = baseB + counter * B.columns;
-	int sum = 0;
-	for (unsigned int i = start; i < end; ++i)
+	size_t counter = start - (c * dotSize);//starting position in a dot product (reset per new dot product)
+	size_t indexA = baseA + counter;
+	size_t indexB = baseB + counter * B.columns;
+	int_fast64_t sum = 0;
+	for (size_t i = start; i < end; ++i)
 	{
 		sum += A.data[indexA] * B.data[indexB];
 		if (++counter == dotSize)
@@ -302,7 +302,7 @@ void IntegerMatrix::deepCopy(const IntegerMatrix& cp, bool allocate)
 	else
 		std::cout << "DEBUG (deepCopy PMat): Repurposing Matrix Data\n";
 #endif
-	for (unsigned int i = 0; i < capacity; ++i)
+	for (size_t i = 0; i < capacity; ++i)
 	{
 		data[i] = cp.data[i];
 	}
@@ -319,8 +319,8 @@ void IntegerMatrix::deepCopy(const std::vector<std::vector<float>>& values, bool
 			cleanStart = false;
 		}
 	}
-	rows = static_cast<unsigned int>(values.size());
-	columns = static_cast<unsigned int>(values[0].size());
+	rows = static_cast<size_t>(values.size());
+	columns = static_cast<size_t>(values[0].size());
 	capacity = rows * columns;
 	if (cleanStart)
 	{
@@ -356,7 +356,7 @@ std::ostream& operator<<(std::ostream& out, const IntegerMatrix& mat)
 bool operator==(const IntegerMatrix& A, const IntegerMatrix& B)
 {
 	if (A.capacity != B.capacity)return false;
-	for (unsigned int i = 0; i < A.capacity; ++i)
+	for (size_t i = 0; i < A.capacity; ++i)
 	{
 		if (A.data[i] != B.data[i])return false;
 	}
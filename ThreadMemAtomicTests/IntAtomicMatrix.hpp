@@ -1,6 +1,6 @@
 /*
 Author: Dan Rehberg
-Date Modified: 1/3/2023
+Date Modified: 10/19/2026
 */
 
 #ifndef __INT_ATOMIC_MATRIX__
@@ -34,7 +34,7 @@ class IntegerMatrix
 private:
 	IntegerMatrix();//Used to explicitly instantiate variables
 public:
-	IntegerMatrix(unsigned int rows, unsigned int columns);//POD, could used fixed length if so desired
+	IntegerMatrix(size_t rows, size_t columns);//POD, could used fixed length if so desired
 	template <size_t T, size_t S>
 	IntegerMatrix(const std::array<std::array<float, S>, T>& array2D)
 	{
@@ -58,22 +58,22 @@ public:
 	IntegerMatrix& operator=(const std::vector<std::vector<float>>& vector2D);
 	friend bool operator==(const IntegerMatrix& A, const IntegerMatrix& B);
 	IntegerMatrix operator*(const IntegerMatrix& rhs) const;
-	unsigned int getCapacity() const;
-	std::pair<unsigned int, unsigned int> getDimensions() const;
+	size_t getCapacity() const;
+	std::pair<size_t, size_t> getDimensions() const;
 	std::string getInfo() const;
 	static IntegerMatrix getParallelResult();
 	static void setIntegerMatrixOps(IntegerMatrix& matA);
 	//TODO -- isolate the parallel operations after testing them via MACRO settings
 	static void setParallelMatrixOps(IntegerMatrix& matA, IntegerMatrix& matB, bool multiplication = true);
 	//static void parallelTrialC0AltAlt(MemoryTest& mem, std::mutex& m, unsigned int taskIndex);
-	static void parallelTrialC0AltAlt(std::mutex& m, unsigned int startTask, unsigned int endTask);
-	static void parallelTrialC0AltAltAlt(std::mutex& m, unsigned int startTask, unsigned int endTask);
+	static void parallelTrialC0AltAlt(std::mutex& m, uint64_t startTask, uint64_t endTask);
+	static void parallelTrialC0AltAltAlt(std::mutex& m, uint64_t startTask, uint64_t endTask);
 private:
 	static IntegerMatrix* mA, * mB, mC, mD;//C is a resultant, so no pointers; mD is a temporary for the log base 2 dispatch
-	static unsigned int atomSize;
+	static size_t atomSize;
 	static AtomicMatrix atom;//for the atomic multiplication tests
-	unsigned int rows, columns;//length of 2D matrix
-	unsigned int capacity;//total cardinality of the 2D matrix
+	size_t rows, columns;//length of 2D matrix
+	size_t capacity;//total cardinality of the 2D matrix
 	int_fast64_t* data;//the matrix innards
 	void deepCopy(const IntegerMatrix& cp, bool allocate = true);//!!DATA MODIFICATION!! -- allocate is true, deletes if not nullptr : false, then checks for like parameters to determine deletion
 	template <size_t T, size_t S>
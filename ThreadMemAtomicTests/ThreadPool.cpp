@@ -1,6 +1,6 @@
 /*
 Author: Dan Rehberg
-Date Modified: 8/5/2021
+Date Modified: 10/19/2026
 Notes: While from a single use case, creating the unique locks in the sleep sync method
 		can be seen as taking an exorbitant amount of time, empirically testing the
 		single creation of unique locks (for the main and Daemon threads) proved to average
@@ -114,7 +114,7 @@ ThreadPool::~ThreadPool()
 	return;
 }*/
 
-void ThreadPool::dispatch(uint32_t taskCount, void(*task)(std::mutex&, unsigned int, unsigned int))
+void ThreadPool::dispatch(uint64_t taskCount, void(*task)(std::mutex&, uint64_t, uint64_t))
 {
 	if (!init)initialized();
 	N = taskCount;
@@ -237,8 +237,8 @@ void ThreadPool::g(const unsigned int i)//the ith thread in the argument
 		}
 #endif
 		//distribute tasks
-		uint32_t t0 = static_cast<uint32_t>(i) * n;
-		uint32_t t1 = t0 + n;
+		uint64_t t0 = static_cast<uint64_t>(i) * n;
+		uint64_t t1 = t0 + n;
 		if (t0 >= N)
 		{
 			t0 = 0;
@@ -249,7 +249,7 @@ void ThreadPool::g(const unsigned int i)//the ith thread in the argument
 			t1 = N;
 		}
 		//Execute on tasks
-		//for (uint32_t j = t0; j < t1; ++j)
+		//for (uint64_t j = t0; j < t1; ++j)
 		{
 			f(lockShared, t0, t1);
 		}
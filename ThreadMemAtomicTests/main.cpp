@@ -33,8 +33,8 @@ int main()
 				Mat B = testing;
 				Mat::setParallelMatrixOps(A, B, true);
 				Mat C(A.getDimensions().first, B.getDimensions().second);
-				unsigned int tempSize = A.getDimensions().first * B.getDimensions().second;
-				unsigned int totalSums = tempSize * A.getDimensions().second;
+				size_t tempSize = A.getDimensions().first * B.getDimensions().second;
+				uint64_t totalSums = tempSize * A.getDimensions().second;
 				startTime = std::chrono::steady_clock::now();
 				for (unsigned int i = 0; i < trials; ++i)
 				{
@@ -47,7 +47,7 @@ int main()
 					C = A * B;
 				endTime = std::chrono::steady_clock::now();
 				unsigned int timeB = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
-				unsigned int scale = testing.getDimensions().first;
+				size_t scale = testing.getDimensions().first;
 				std::cout << "Matrix Multiplication of: " << scale << "x" << scale << "; Parallel time: " << timeA << " (" << (static_cast<float>(timeA) / static_cast<float>(trials)) << ")" << " ms; Serial time: " <<
 					timeB << " (" << (static_cast<float>(timeB) / static_cast<float>(trials)) << ")" << " ms\n";
 			}
@@ -71,8 +71,8 @@ int main()
 				MatF B = testing;
 				MatF::setParallelMatrixOps(A, B, true);
 				MatF C(A.getDimensions().first, B.getDimensions().second);
-				unsigned int tempSize = A.getDimensions().first * B.getDimensions().second;
-				unsigned int totalSums = tempSize * A.getDimensions().second;
+				size_t tempSize = A.getDimensions().first * B.getDimensions().second;
+				uint64_t totalSums = tempSize * A.getDimensions().second;
 				startTime = std::chrono::steady_clock::now();
 				for (unsigned int i = 0; i < trials; ++i)
 				{
@@ -85,7 +85,7 @@ int main()
 					C = A * B;
 				endTime = std::chrono::steady_clock::now();
 				unsigned int timeB = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
-				unsigned int scale = testing.getDimensions().first;
+				size_t scale = testing.getDimensions().first;
 				std::cout << "Matrix Multiplication of: " << scale << "x" << scale << "; Parallel time: " << timeA << " (" << (static_cast<float>(timeA) / static_cast<float>(trials)) << ")" << " ms; Serial time: " <<
 					timeB << " (" << (static_cast<float>(timeB) / static_cast<float>(trials)) << ")" << " ms\n";
 			}
@@ -109,8 +109,8 @@ int main()
 				Mat B = testing;
 				Mat::setParallelMatrixOps(A, B, true);
 				Mat C(A.getDimensions().first, B.getDimensions().second);
-				unsigned int tempSize = A.getDimensions().first * B.getDimensions().second;
-				unsigned int totalSums = tempSize * A.getDimensions().second;
+				size_t tempSize = A.getDimensions().first * B.getDimensions().second;
+				uint64_t totalSums = tempSize * A.getDimensions().second;
 				startTime = std::chrono::steady_clock::now();
 				for (unsigned int i = 0; i < trials; ++i)
 				{
@@ -123,7 +123,7 @@ int main()
 					C = A * B;
 				endTime = std::chrono::steady_clock::now();
 				unsigned int timeB = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
-				unsigned int scale = testing.getDimensions().first;
+				size_t scale = testing.getDimensions().first;
 				std::cout << "Matrix Multiplication of: " << scale << "x" << scale << "; Parallel time: " << timeA << " (" << (static_cast<float>(timeA) / static_cast<float>(trials)) << ")" << " ms; Serial time: " <<
 					timeB << " (" << (static_cast<float>(timeB) / static_cast<float>(trials)) << ")" << " ms\n";
 			}
@@ -147,8 +147,8 @@ int main()
 				Mat B = testing;
 				Mat::setParallelMatrixOps(A, B, true);
 				Mat C(A.getDimensions().first, B.getDimensions().second);
-				unsigned int tempSize = A.getDimensions().first * B.getDimensions().second;
-				unsigned int totalSums = tempSize * A.getDimensions().second;
+				size_t tempSize = A.getDimensions().first * B.getDimensions().second;
+				uint64_t totalSums = tempSize * A.getDimensions().second;
 				startTime = std::chrono::steady_clock::now();
 				for (unsigned int i = 0; i < trials; ++i)
 				{
@@ -161,7 +161,7 @@ int main()
 					C = A * B;
 				endTime = std::chrono::steady_clock::now();
 				unsigned int timeB = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
-				unsigned int scale = testing.getDimensions().first;
+				size_t scale = testing.getDimensions().first;
 				std::cout << "Matrix Multiplication of: " << scale << "x" << scale << "; Parallel time: " << timeA << " (" << (static_cast<float>(timeA) / static_cast<float>(trials)) << ")" << " ms; Serial time: " <<
 					timeB << " (" << (static_cast<float>(timeB) / static_cast<float>(trials)) << ")" << " ms\n";
 			}
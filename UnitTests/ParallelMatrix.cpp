@@ -1,6 +1,6 @@
 /*
 Author: Dan Rehberg
-Modified Date: 12/9/2022
+Modified Date: 10/19/2026
 */
 #include "ParallelMatrix.hpp"
 
@@ -9,12 +9,12 @@ ParallelMatrix* ParallelMatrix::mA = nullptr;
 ParallelMatrix* ParallelMatrix::mB = nullptr;
 ParallelMatrix ParallelMatrix::mC = ParallelMatrix(1, 1);
 ParallelMatrix ParallelMatrix::mD = ParallelMatrix(1, 1);
-unsigned int ParallelMatrix::M = 0;
-unsigned int ParallelMatrix::N = 0;
-unsigned int ParallelMatrix::rI = 0;
-unsigned int ParallelMatrix::cJ = 0;
-unsigned int ParallelMatrix::curN = 0;
-unsigned int ParallelMatrix::curItr = 0;
+size_t ParallelMatrix::M = 0;
+size_t ParallelMatrix::N = 0;
+size_t ParallelMatrix::rI = 0;
+size_t ParallelMatrix::cJ = 0;
+size_t ParallelMatrix::curN = 0;
+size_t ParallelMatrix::curItr = 0;
 AtomicMatrix ParallelMatrix::atom = std::move(AtomicMatrix(1, 1));
 IntMatrix ParallelMatrix::intA = std::move(IntMatrix(1, 1));
 IntMatrix ParallelMatrix::intB = std::move(IntMatrix(1, 1));
@@ -25,9 +25,9 @@ std::atomic_uint32_t ParallelMatrix::multiplications = 0;
 
 AtomicMatrix::AtomicMatrix() : data(nullptr) {}
 
-AtomicMatrix::AtomicMatrix(unsigned int rows, unsigned int columns) : AtomicMatrix()
+AtomicMatrix::AtomicMatrix(size_t rows, size_t columns) : AtomicMatrix()
 {
-	unsigned int capacity = rows * columns;
+	size_t capacity = rows * columns;
 #if DEBUG_MATRIX >= 1
 	if (capacity == 0)throw std::length_error("(r,c constructor) Cannot have a matrix with zero elements");
 #endif
@@ -36,7 +36,7 @@ AtomicMatrix::AtomicMatrix(unsigned int rows, unsigned int columns) : AtomicMatr
 	if (data == nullptr)std::cout << "ATOMIC ALLOCATION FAILURE!\n";
 #endif
 	if (data == nullptr)return;
-	for (unsigned int i = 0; i < capacity; ++i)
+	for (size_t i = 0; i < capacity; ++i)
 	{
 		data[i].store(0, std::memory_order_relaxed);
 	}
@@ -67,9 +67,9 @@ AtomicMatrix& AtomicMatrix::operator=(AtomicMatrix&& rhs)
 
 IntMatrix::IntMatrix() : data(nullptr) {}
 
-IntMatrix::IntMatrix(unsigned int rows, unsigned int columns) : IntMatrix()
+IntMatrix::IntMatrix(size_t rows, size_t columns) : IntMatrix()
 {
-	unsigned int capacity = rows * columns;
+	size_t capacity = rows * columns;
 #if DEBUG_MATRIX >= 1
 	if (capacity == 0)throw std::length_error("(r,c constructor) Cannot have a matrix with zero elements");
 #endif
@@ -107,7 +107,7 @@ IntMatrix& IntMatrix::operator=(const ParallelMatrix& ref)
 	if (this->data != nullptr)delete[] this->data;
 	this->data = new (std::nothrow)int[ref.capacity];
 	if (this->data == nullptr)*this;
-	for (unsigned int i = 0; i < ref.capacity; ++i)
+	for (size_t i = 0; i < ref.capacity; ++i)
 		this->data[i] = static_cast<int>(AtomicMatrix::scale * ref.data[i]);
 	return *this;
 }
@@ -117,7 +117,7 @@ ParallelMatrix::ParallelMatrix() : rows(0), columns(0), capacity(0), data(nullpt
 
 }
 
-ParallelMatrix::ParallelMatrix(unsigned int r, unsigned int c) : ParallelMatrix()
+ParallelMatrix::ParallelMatrix(size_t r, size_t c) : ParallelMatrix()
 {
 	rows = r;
 	columns = c;
@@ -198,9 +198,9 @@ ParallelMatrix ParallelMatrix::operator*(const ParallelMatrix& rhs) const
 	}
 	ParallelMatrix temp(rows, rhs.columns);
 	//Going to avoid divisions here with a simple conditional
-	unsigned int offset = 0;
-	unsigned int curRow = 0;
-	for (unsigned int i = 0; offset < temp.capacity; ++i)
+	size_t offset = 0;
+	size_t curRow = 0;
+	for (size_t i = 0; offset < temp.capacity; ++i)
 	{
 		if (i == temp.columns)
 		{
@@ -208,11 +208,11 @@ ParallelMatrix ParallelMatrix::operator*(const ParallelMatrix& rhs) const
 			++curRow;
 		}
 		float sum = 0;
-		unsigned int rowOffset = curRow * this->columns;
+		size_t rowOffset = curRow * this->columns;
 #if DEBUG_MATRIX == 1
 		std::cout << "Dot Product indices\n";
 #endif
-		for (unsigned int j = 0; j < this->columns; ++j)
+		for (size_t j = 0; j < this->columns; ++j)
 		{
 			sum += data[j + rowOffset] * rhs.data[j * rhs.columns + i];
 #if DEBUG_MATRIX == 1
@@ -224,14 +224,19 @@ ParallelMatrix ParallelMatrix::operator*(const ParallelMatrix& rhs) const
 	return temp;
 }
 
-unsigned int ParallelMatrix::getCapacity() const
+size_t ParallelMatrix::getCapacity() const
 {
 	return capacity;
 }
 
-std::pair<unsigned int, unsigned int> ParallelMatrix::getDimensions() const
+std::pair<size_t, size_t> ParallelMatrix::getDimensions() const
 {
-	return std::pair<unsigned int, unsigned int>(rows, columns);
+	return std::pair<size_t, size_t>(rows, columns);
+}
+
+float ParallelMatrix::at(size_t row, size_t column) const
+{
+	return data[row * columns + column];
 }
 
 std::string ParallelMatrix::getInfo() const
@@ -239,7 +244,7 @@ std::string ParallelMatrix::getInfo() const
 	if (data == nullptr)return "No Data Stored";
 	std::string temp = "[";
 	//To Mod or not to Mod
-	for (unsigned int i = 0; i < capacity; ++i)
+	for (size_t i = 0; i < capacity; ++i)
 	{
 		if (i % columns == 0)
 		{
@@ -299,7 +304,7 @@ void ParallelMatrix::setParallelMatrixOps(ParallelMatrix& matA, ParallelMatrix&
 		//		curItr is what determines which buffer in the three row chunk the data is gathered vs set
 		M = mA->rows * mB->columns;
 		N = mA->columns;
-		unsigned int halved = (N + 1) >> 1;
+		size_t halved = (N + 1) >> 1;
 		mD = ParallelMatrix(3 * M, halved);
 		rI = 3 * halved;
 		cJ = 2 * halved;
@@ -316,17 +321,17 @@ void ParallelMatrix::setParallelMatrixOps(ParallelMatrix& matA, ParallelMatrix&
 	}
 }
 
-void ParallelMatrix::parallelTrialA(std::mutex& m, unsigned int component)
+void ParallelMatrix::parallelTrialA(std::mutex& m, uint64_t component)
 {
 	//First, need to determine which column and row the component index is in.
 	// So, need both the dividend and remainder..
-	unsigned int curRow = component / mC.columns, curColumn = component % mC.columns;
+	size_t curRow = component / mC.columns, curColumn = component % mC.columns;
 
 	ParallelMatrix& A = *mA;
 	ParallelMatrix& B = *mB;
 	float sum = 0;
-	unsigned int rowOffset = curRow * A.columns;
-	for (unsigned int j = 0; j < A.columns; ++j)
+	size_t rowOffset = curRow * A.columns;
+	for (size_t j = 0; j < A.columns; ++j)
 	{
 		sum += A.data[j + rowOffset] * B.data[j * B.columns + curColumn];
 	}
@@ -339,7 +344,7 @@ ParallelMatrix ParallelMatrix::getMD()
 }
 #endif
 
-void ParallelMatrix::parallelTrialB0(std::mutex& m, unsigned int component)
+void ParallelMatrix::parallelTrialB0(std::mutex& m, uint64_t component)
 {
 	//This method is the starting point of a logbase2 approach to performing matrix
 	//	multiplication in parallel -> i.e., a series of parallel dot products.
@@ -347,16 +352,16 @@ void ParallelMatrix::parallelTrialB0(std::mutex& m, unsigned int component)
 	//		and storing that result in a temporary buffer
 	ParallelMatrix& A = *mA;
 	ParallelMatrix& B = *mB;
-	unsigned int curChunk = 0; // per iteration up to M below, this += rI
-	unsigned int resetB = component * B.columns;// 0;
-	unsigned int indexA = component;
-	unsigned int indexB = resetB;// component;
-	unsigned int lengthB = resetB + B.columns;
-	unsigned int offsetA = A.columns;
-	for (unsigned int i = 0; i < M; ++i)
+	size_t curChunk = 0; // per iteration up to M below, this += rI
+	size_t resetB = component * B.columns;// 0;
+	size_t indexA = component;
+	size_t indexB = resetB;// component;
+	size_t lengthB = resetB + B.columns;
+	size_t offsetA = A.columns;
+	for (size_t i = 0; i < M; ++i)
 	{
 #if DEBUG_MATRIX == 2
-		unsigned int tempA = A.data[indexA], tempB = B.data[indexB];
+		size_t tempA = A.data[indexA], tempB = B.data[indexB];
 #endif
 		mD.data[curChunk + component] = A.data[indexA] * B.data[indexB];
 		curChunk += rI;
@@ -373,7 +378,7 @@ void ParallelMatrix::parallelTrialB0(std::mutex& m, unsigned int component)
 	}
 }
 
-void ParallelMatrix::setTrialB1(unsigned int count, bool reset)
+void ParallelMatrix::setTrialB1(size_t count, bool reset)
 {
 	//count must be the number of active values to sum
 	//	not the thread count!
@@ -386,12 +391,12 @@ void ParallelMatrix::setTrialB1(unsigned int count, bool reset)
 	curN = count - 1;
 }
 
-void ParallelMatrix::parallelTrialB1(std::mutex& m, unsigned int component)
+void ParallelMatrix::parallelTrialB1(std::mutex& m, uint64_t component)
 {
 	//Addition process will take values from the last buffer in the chunk of dot products
 	//	and sum them together to be stored in the alternate buffer location
-	unsigned int j = component;
-	unsigned int g = component * 2;
+	size_t j = component;
+	size_t g = component * 2;
 	//curItr 1 means the data to gather is at the 0th row of the chunks
 	if (g == curN)
 	{
@@ -409,7 +414,7 @@ void ParallelMatrix::parallelTrialB1(std::mutex& m, unsigned int component)
 			std::cout << "de: " << component << " index g, j: " << g << " " << j << "\n";
 		}
 #endif
-		for (unsigned int i = 0; i < M; ++i)
+		for (size_t i = 0; i < M; ++i)
 		{
 			mD.data[j] = mD.data[g];
 			j += rI;
@@ -432,7 +437,7 @@ void ParallelMatrix::parallelTrialB1(std::mutex& m, unsigned int component)
 			std::cout << "pc: " << component << " index g, j: " << g << " " << j << "\n";
 		}
 #endif
-		for (unsigned int i = 0; i < M; ++i)
+		for (size_t i = 0; i < M; ++i)
 		{
 #if DEBUG_MATRIX == 2
 			{
@@ -448,7 +453,7 @@ void ParallelMatrix::parallelTrialB1(std::mutex& m, unsigned int component)
 	}
 }
 
-void ParallelMatrix::parallelTrialC0(std::mutex& m, unsigned int component)
+void ParallelMatrix::parallelTrialC0(std::mutex& m, uint64_t component)
 {
 	//This method is the starting point of a logbase2 approach to performing matrix
 	//	multiplication in parallel -> i.e., a series of parallel dot products.
@@ -456,13 +461,13 @@ void ParallelMatrix::parallelTrialC0(std::mutex& m, unsigned int component)
 	//		and storing that result in a temporary buffer
 	ParallelMatrix& A = *mA;
 	ParallelMatrix& B = *mB;
-	unsigned int curDot = 0; // per iteration up to M below
-	unsigned int resetB = component * B.columns;// 0;
-	unsigned int indexA = component;
-	unsigned int indexB = resetB;// component;
-	unsigned int lengthB = resetB + B.columns;
-	unsigned int offsetA = A.columns;
-	for (unsigned int i = 0; i < M; ++i)
+	size_t curDot = 0; // per iteration up to M below
+	size_t resetB = component * B.columns;// 0;
+	size_t indexA = component;
+	size_t indexB = resetB;// component;
+	size_t lengthB = resetB + B.columns;
+	size_t offsetA = A.columns;
+	for (size_t i = 0; i < M; ++i)
 	{
 		atom.data[curDot].fetch_add(static_cast<int32_t>(AtomicMatrix::scale * A.data[indexA] * B.data[indexB]), std::memory_order_relaxed);
 		++curDot;
@@ -474,29 +479,29 @@ void ParallelMatrix::parallelTrialC0(std::mutex& m, unsigned int component)
 	}
 }
 
-void ParallelMatrix::parallelTrialC0Alt(std::mutex& m, unsigned int component)
+void ParallelMatrix::parallelTrialC0Alt(std::mutex& m, uint64_t component)
 {
 	ParallelMatrix& A = *mA;
 	ParallelMatrix& B = *mB;
-	unsigned int dotSize = A.columns;
-	unsigned int c = component / dotSize;
-	unsigned int tModS = component - (c * dotSize);// component% dotSize;
-	unsigned int cDiv = (c / dotSize);
-	unsigned int cMod = c - (cDiv * dotSize);
-	unsigned int indexA = cDiv * dotSize + tModS;// (c / dotSize)* dotSize + tModS;
-	unsigned int indexB = cMod + tModS * dotSize;// (c % dotSize) + tModS * dotSize;
+	size_t dotSize = A.columns;
+	size_t c = component / dotSize;
+	size_t tModS = component - (c * dotSize);// component% dotSize;
+	size_t cDiv = (c / dotSize);
+	size_t cMod = c - (cDiv * dotSize);
+	size_t indexA = cDiv * dotSize + tModS;// (c / dotSize)* dotSize + tModS;
+	size_t indexB = cMod + tModS * dotSize;// (c % dotSize) + tModS * dotSize;
 	atom.data[c].fetch_add(static_cast<int32_t>(AtomicMatrix::scale * A.data[indexA] * B.data[indexB]), std::memory_order_relaxed);
 }
 
-void ParallelMatrix::parallelTrialC0AltAlt(std::mutex& m, unsigned int component)
+void ParallelMatrix::parallelTrialC0AltAlt(std::mutex& m, uint64_t component)
 {
-	unsigned int dotSize = mA->columns;
-	unsigned int c = component / dotSize;
-	unsigned int tModS = component - (c * dotSize);// component% dotSize;
-	unsigned int cDiv = (c / dotSize);
-	unsigned int cMod = c - (cDiv * dotSize);
-	unsigned int indexA = cDiv * dotSize + tModS;// (c / dotSize)* dotSize + tModS;
-	unsigned int indexB = cMod + tModS * dotSize;// (c % dotSize) + tModS * dotSize;
+	size_t dotSize = mA->columns;
+	size_t c = component / dotSize;
+	size_t tModS = component - (c * dotSize);// component% dotSize;
+	size_t cDiv = (c / dotSize);
+	size_t cMod = c - (cDiv * dotSize);
+	size_t indexA = cDiv * dotSize + tModS;// (c / dotSize)* dotSize + tModS;
+	size_t indexB = cMod + tModS * dotSize;// (c % dotSize) + tModS * dotSize;
 	atom.data[c].fetch_add(intA.data[indexA] * intB.data[indexB], std::memory_order_relaxed);
 }
 
@@ -512,17 +517,17 @@ void ParallelMatrix::parallelTrialC0AltAlt(std::mutex& m, unsigned int component
 //		of each respective Matrix Class because it will involve modification of the parallel
 //		dispatch in the ThreadPool class.
 
-void ParallelMatrix::parallelTrialC1(std::mutex& m, unsigned int component)
+void ParallelMatrix::parallelTrialC1(std::mutex& m, uint64_t component)
 {
 	mC.data[component] = AtomicMatrix::invScale * static_cast<float>(atom.data[component].load());
 }
 
-void ParallelMatrix::parallelTrialB2(std::mutex& m, unsigned int component)
+void ParallelMatrix::parallelTrialB2(std::mutex& m, uint64_t component)
 {
 	//curItr of 1 means the data was last stored in the 3rd row of the chunks
 	//The final value is in the first index of the respective chunk row
 	//The chunks are bijectively mapped by row major order to the matrix class
-	unsigned int offset = (curItr == 1) ? cJ : 0;
+	size_t offset = (curItr == 1) ? cJ : 0;
 	mC.data[component] = mD.data[component * rI + offset];
 }
 
@@ -555,7 +560,7 @@ void ParallelMatrix::deepCopy(const ParallelMatrix& cp, bool allocate)
 	else
 		std::cout << "DEBUG (deepCopy PMat): Repurposing Matrix Data\n";
 #endif
-	for (unsigned int i = 0; i < capacity; ++i)
+	for (size_t i = 0; i < capacity; ++i)
 	{
 		data[i] = cp.data[i];
 	}
@@ -572,8 +577,8 @@ void ParallelMatrix::deepCopy(const std::vector<std::vector<float>>& values, boo
 			cleanStart = false;
 		}
 	}
-	rows = static_cast<unsigned int>(values.size());
-	columns = static_cast<unsigned int>(values[0].size());
+	rows = static_cast<size_t>(values.size());
+	columns = static_cast<size_t>(values[0].size());
 	capacity = rows * columns;
 	if (cleanStart)
 	{
@@ -608,29 +613,9 @@ std::ostream& operator<<(std::ostream& out, const ParallelMatrix& mat)
 bool operator==(const ParallelMatrix& A, const ParallelMatrix& B)
 {
 	if (A.capacity != B.capacity)return false;
-	for (unsigned int i = 0; i < A.capacity; ++i)
+	for (size_t i = 0; i < A.capacity; ++i)
 	{
 		if (A.data[i] != B.data[i])return false;
 	}
 	return true;
-}
-
-//Templated case below
-template <size_t T, size_t S>
-BaseMatrix<T, S>::BaseMatrix()
-{
-
-}
-
-template <size_t T, size_t S>
-BaseMatrix<T, S>::~BaseMatrix()
-{
-
-}
-
-template <size_t T, size_t S>
-template <size_t V>
-BaseMatrix<T, V> BaseMatrix<T, S>::operator*(BaseMatrix<S, V>& ref)
-{
-
 }
\ No newline at end of file
@@ -37,6 +37,8 @@ Goals: 4 scenarios exist to run within this class to test out performance.
 #include <atomic>
 #include <new>
 
+class ParallelMatrix;
+
 //Pretty bleak interface below..
 //	As appealing as templating might be, would require a virtual function to be overloaded to perform the atomic operations
 //	Additionally, do not have any immediate reason to require use of other numeric types
@@ -45,7 +47,7 @@ class AtomicMatrix
 private:
 	AtomicMatrix();
 public:
-	AtomicMatrix(unsigned int rows, unsigned int columns); //Not directly accessible
+	AtomicMatrix(size_t rows, size_t columns); //Not directly accessible
 	AtomicMatrix(AtomicMatrix&& rhs);
 	~AtomicMatrix();
 	AtomicMatrix& operator=(AtomicMatrix&& rhs);
@@ -63,7 +65,7 @@ class IntMatrix
 private:
 	IntMatrix();
 public:
-	IntMatrix(unsigned int rows, unsigned int columns);
+	IntMatrix(size_t rows, size_t columns);
 	IntMatrix(IntMatrix&& rhs);
 	~IntMatrix();
 	IntMatrix& operator=(IntMatrix&& rhs);
@@ -80,9 +82,9 @@ class ParallelMatrix
 private:
 	ParallelMatrix();//Used to explicitly instantiate variables
 public:
-	ParallelMatrix(unsigned int rows, unsigned int columns);//POD, could used fixed length if so desired
+	ParallelMatrix(size_t rows, size_t columns);//POD, could used fixed length if so desired
 	template <size_t T, size_t S>
-	ParallelMatrix(const std::array<std::array<float, S>, T>& array2D)
+	ParallelMatrix(const std::array<std::array<float, S>, T>& array2D) : ParallelMatrix()
 	{
 #if DEBUG_MATRIX >= 1
 		if ((array2D.size() * array2D[0].size()) == 0)throw std::length_error("(array copy) Cannot have a matrix with zero elements");
@@ -100,30 +102,32 @@ public:
 		if ((array2D.size() * array2D[0].size()) == 0)throw std::length_error("(array =) Cannot have a matrix with zero elements");
 #endif
 		deepCopy(array2D, false);
+		return *this;
 	}
 	ParallelMatrix& operator=(const std::vector<std::vector<float>>& vector2D);
 	friend bool operator==(const ParallelMatrix& A, const ParallelMatrix& B);
 	ParallelMatrix operator*(const ParallelMatrix& rhs) const;
-	unsigned int getCapacity() const;
-	std::pair<unsigned int, unsigned int> getDimensions() const;
+	size_t getCapacity() const;
+	float at(size_t row, size_t column) const;//Unchecked, row major
+	std::pair<size_t, size_t> getDimensions() const;
 	std::string getInfo() const;
 	static ParallelMatrix getParallelResult();
 	static void setParallelMatrixOps(ParallelMatrix& matA);
 	//TODO -- isolate the parallel operations after testing them via MACRO settings
 	static void setParallelMatrixOps(ParallelMatrix& matA, ParallelMatrix& matB, bool multiplication = true);
-	static void parallelTrialA(std::mutex& m, unsigned int taskIndex);//Dot product managed per thread
-	static void parallelTrialB0(std::mutex& m, unsigned int taskIndex);//Arithmetic operation paired per thread (log base 2 operations)
-	static void setTrialB1(unsigned int currentN, bool reset = false);//Changes the curN and alternates the curItr value
-	static void parallelTrialB1(std::mutex& m, unsigned int taskIndex);//Addition for log base 2 case
-	static void parallelTrialB2(std::mutex& m, unsigned int taskIndex);//Store result for log base 2 case
-	static void parallelTrialC0(std::mutex& m, unsigned int taskIndex);//Integer conversion and atomic operations
-	static void parallelTrialC0Alt(std::mutex& m, unsigned int taskIndex);
-	static void parallelTrialC0AltAlt(std::mutex& m, unsigned int taskIndex);
-	static void parallelTrialC1(std::mutex& m, unsigned int taskIndex);//Convert to the float component from the atomic integer value
+	static void parallelTrialA(std::mutex& m, uint64_t taskIndex);//Dot product managed per thread
+	static void parallelTrialB0(std::mutex& m, uint64_t taskIndex);//Arithmetic operation paired per thread (log base 2 operations)
+	static void setTrialB1(size_t currentN, bool reset = false);//Changes the curN and alternates the curItr value
+	static void parallelTrialB1(std::mutex& m, uint64_t taskIndex);//Addition for log base 2 case
+	static void parallelTrialB2(std::mutex& m, uint64_t taskIndex);//Store result for log base 2 case
+	static void parallelTrialC0(std::mutex& m, uint64_t taskIndex);//Integer conversion and atomic operations
+	static void parallelTrialC0Alt(std::mutex& m, uint64_t taskIndex);
+	static void parallelTrialC0AltAlt(std::mutex& m, uint64_t taskIndex);
+	static void parallelTrialC1(std::mutex& m, uint64_t taskIndex);//Convert to the float component from the atomic integer value
 	friend class IntMatrix;
 private:
 	static ParallelMatrix* mA, * mB, mC, mD;//C is a resultant, so no pointers; mD is a temporary for the log base 2 dispatch
-	static unsigned int M, N, rI, cJ, curN, curItr;
+	static size_t M, N, rI, cJ, curN, curItr;
 	static AtomicMatrix atom;//for the atomic multiplication tests
 	static IntMatrix intA, intB;
 #if DEBUG_MATRIX == 2
@@ -131,8 +135,8 @@ public:	static std::atomic_uint32_t multiplications;
 	  static ParallelMatrix getMD();
 private:
 #endif
-	unsigned int rows, columns;//length of 2D matrix
-	unsigned int capacity;//total cardinality of the 2D matrix
+	size_t rows, columns;//length of 2D matrix
+	size_t capacity;//total cardinality of the 2D matrix
 	float* data;//the matrix innards
 	void deepCopy(const ParallelMatrix& cp, bool allocate = true);//!!DATA MODIFICATION!! -- allocate is true, deletes if not nullptr : false, then checks for like parameters to determine deletion
 	template <size_t T, size_t S>
@@ -182,19 +186,118 @@ std::ostream& operator<<(std::ostream& out, const ParallelMatrix& mat);
 
 //Could cast to common base class if polymorphism desired 
 //Likely just for fixed usage (i.e., 4x4 homogeneous coordinates for graphics and physics of 3D space, etc..)
+//	T rows by S columns, row major on the stack; every size is a template argument, so a product of mismatched
+//		dimensions does not compile and every loop below is unrolled into straight line code (index_sequence folds).
+//	No virtual destructor, it would cost a vtable pointer per matrix and stop these from being constexpr.
+//	Unrolling is per element, so this is meant for the tens of elements of small layers, not for large matrices.
 template <size_t T, size_t S>
 class BaseMatrix
 {
+	static_assert(T != 0 && S != 0, "(BaseMatrix) Cannot have a matrix with zero elements");
 public:
-	BaseMatrix();
-	virtual ~BaseMatrix();
+	constexpr BaseMatrix() : data{} {}
+	constexpr BaseMatrix(const std::array<std::array<float, S>, T>& array2D) : data{}
+	{
+		copy(array2D, std::make_index_sequence<T * S>());
+	}
+	static constexpr std::pair<size_t, size_t> getDimensions() { return { T, S }; }
+	static constexpr size_t getCapacity() { return T * S; }
+	constexpr float& at(size_t row, size_t column) { return data[row * S + column]; }
+	constexpr float at(size_t row, size_t column) const { return data[row * S + column]; }
 	template <size_t V>
-	BaseMatrix<T, V> operator*(BaseMatrix<S, V>& rhs);
+	constexpr BaseMatrix<T, V> operator*(const BaseMatrix<S, V>& rhs) const
+	{
+		BaseMatrix<T, V> temp;
+		multiply(rhs, temp, std::make_index_sequence<T * V>());
+		return temp;
+	}
+	constexpr BaseMatrix<S, T> transpose() const
+	{
+		BaseMatrix<S, T> temp;
+		transpose(temp, std::make_index_sequence<T * S>());
+		return temp;
+	}
+	constexpr BaseMatrix operator+(const BaseMatrix& rhs) const
+	{
+		return elementwise(rhs, [](float a, float b) { return a + b; }, std::make_index_sequence<T * S>());
+	}
+	constexpr BaseMatrix operator-(const BaseMatrix& rhs) const
+	{
+		return elementwise(rhs, [](float a, float b) { return a - b; }, std::make_index_sequence<T * S>());
+	}
+	constexpr BaseMatrix componentwise(const BaseMatrix& rhs) const//Hadamard product
+	{
+		return elementwise(rhs, [](float a, float b) { return a * b; }, std::make_index_sequence<T * S>());
+	}
+	constexpr BaseMatrix operator*(float s) const
+	{
+		return elementwise(*this, [s](float a, float) { return a * s; }, std::make_index_sequence<T * S>());
+	}
+	friend constexpr BaseMatrix operator*(float s, const BaseMatrix& rhs) { return rhs * s; }
+	friend constexpr bool operator==(const BaseMatrix& A, const BaseMatrix& B)
+	{
+		return equal(A, B, std::make_index_sequence<T * S>());
+	}
+	std::string getInfo() const
+	{
+		//Same format as ParallelMatrix::getInfo, so results of the two print alike
+		std::string temp = "[";
+		for (size_t i = 0; i < T * S; ++i)
+		{
+			if (i % S == 0)
+			{
+				if (i != 0) temp += '\n';
+			}
+			else temp += ",";
+			temp += std::to_string(data[i]);
+		}
+		temp += ']';
+		return temp;
+	}
+	template <size_t, size_t>
+	friend class BaseMatrix;
 private:
-	float columns[S];
-	float rows[T];
-
+	float data[T * S];
+	template <size_t... I>
+	constexpr void copy(const std::array<std::array<float, S>, T>& values, std::index_sequence<I...>)
+	{
+		((data[I] = values[I / S][I % S]), ...);
+	}
+	//One dot product per element of the result, row I / V of this against column I % V of rhs
+	template <size_t V, size_t... I>
+	constexpr void multiply(const BaseMatrix<S, V>& rhs, BaseMatrix<T, V>& result, std::index_sequence<I...>) const
+	{
+		((result.data[I] = dot<V>(rhs, I / V, I % V, std::make_index_sequence<S>())), ...);
+	}
+	template <size_t V, size_t... K>
+	constexpr float dot(const BaseMatrix<S, V>& rhs, size_t row, size_t column, std::index_sequence<K...>) const
+	{
+		return ((data[row * S + K] * rhs.data[K * V + column]) + ...);
+	}
+	template <size_t... I>
+	constexpr void transpose(BaseMatrix<S, T>& result, std::index_sequence<I...>) const
+	{
+		((result.data[(I % S) * T + I / S] = data[I]), ...);
+	}
+	template <typename F, size_t... I>
+	constexpr BaseMatrix elementwise(const BaseMatrix& rhs, F op, std::index_sequence<I...>) const
+	{
+		BaseMatrix temp;
+		((temp.data[I] = op(data[I], rhs.data[I])), ...);
+		return temp;
+	}
+	template <size_t... I>
+	static constexpr bool equal(const BaseMatrix& A, const BaseMatrix& B, std::index_sequence<I...>)
+	{
+		return ((A.data[I] == B.data[I]) && ...);
+	}
 };
 
+template <size_t T, size_t S>
+std::ostream& operator<<(std::ostream& out, const BaseMatrix<T, S>& mat)
+{
+	return out << mat.getInfo();
+}
+
 
 #endif // !__PARALLEL_MATRIX__
\ No newline at end of file
@@ -1,6 +1,6 @@
 /*
 Author: Dan Rehberg
-Date Modified: 8/5/2021
+Date Modified: 10/19/2026
 Notes: While from a single use case, creating the unique locks in the sleep sync method
 		can be seen as taking an exorbitant amount of time, empirically testing the
 		single creation of unique locks (for the main and Daemon threads) proved to average
@@ -67,20 +67,39 @@ ThreadPool::~ThreadPool()
 	{
 	}
 	f = nullptr;
+	fRange = nullptr;
 	delete[] threads;
 }
 
-void ThreadPool::dispatch(uint32_t taskCount, void(*task)(std::mutex&, unsigned int))
+void ThreadPool::dispatch(uint64_t taskCount, void(*task)(std::mutex&, uint64_t))
 {
-	if (!init)initialized();
-	N = taskCount;
-	n = (N + (threadCount - 1)) / threadCount;
 	if (task == nullptr)
 	{
 		std::cerr << "Invalid function given to dispatch call\n";
 		return;
 	}
 	f = task;
+	fRange = nullptr;
+	run(taskCount);
+}
+
+void ThreadPool::dispatch(uint64_t taskCount, void(*task)(std::mutex&, uint64_t, uint64_t))
+{
+	if (task == nullptr)
+	{
+		std::cerr << "Invalid function given to dispatch call\n";
+		return;
+	}
+	f = nullptr;
+	fRange = task;
+	run(taskCount);
+}
+
+void ThreadPool::run(uint64_t taskCount)
+{
+	if (!init)initialized();
+	N = taskCount;
+	n = (N + (threadCount - 1)) / threadCount;
 	blockIsFinished = false;
 	blockIsMain = false;// true;
 	completeCounter.store(0, std::memory_order_relaxed);
@@ -132,8 +151,8 @@ void ThreadPool::g(const unsigned int i)//the ith thread in the argument
 		}
 #endif
 		//distribute tasks
-		uint32_t t0 = static_cast<uint32_t>(i) * n;
-		uint32_t t1 = t0 + n;
+		uint64_t t0 = static_cast<uint64_t>(i) * n;
+		uint64_t t1 = t0 + n;
 		if (t0 >= N)
 		{
 			t0 = 0;
@@ -144,9 +163,16 @@ void ThreadPool::g(const unsigned int i)//the ith thread in the argument
 			t1 = N;
 		}
 		//Execute on tasks
-		for (uint32_t j = t0; j < t1; ++j)
+		if (fRange != nullptr)
+		{
+			if (t0 != t1)fRange(lockShared, t0, t1);
+		}
+		else
 		{
-			f(lockShared, j);
+			for (uint64_t j = t0; j < t1; ++j)
+			{
+				f(lockShared, j);
+			}
 		}
 
 		//Finish line
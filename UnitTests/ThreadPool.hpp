@@ -1,6 +1,6 @@
 /*
 Author: Dan Rehberg
-Date Modified: 8/4/2021
+Date Modified: 10/19/2026
 */
 
 #ifndef __THREAD_POOL__
@@ -23,7 +23,8 @@ public:
 	~ThreadPool();
 	ThreadPool(const ThreadPool&) = delete;
 	ThreadPool& operator=(const ThreadPool&) = delete;
-	void dispatch(uint32_t taskCount, void(*task)(std::mutex&, unsigned int));
+	void dispatch(uint64_t taskCount, void(*task)(std::mutex&, uint64_t));
+	void dispatch(uint64_t taskCount, void(*task)(std::mutex&, uint64_t, uint64_t));//Range based, each thread is given its [start, end) once
 	void initialized();
 private:
 	std::condition_variable blockFinish;
@@ -35,13 +36,15 @@ private:
 	std::condition_variable blockStart;
 	volatile bool close = false;//If the thread pool needs to stop running -- set destructor explicitly to verify threads terminated before destroying threads array
 	std::atomic_uint32_t completeCounter;//How many threads have finished something...
-	void(*f)(std::mutex&, unsigned int) = nullptr;
+	void(*f)(std::mutex&, uint64_t) = nullptr;
+	void(*fRange)(std::mutex&, uint64_t, uint64_t) = nullptr;
 	void g(const unsigned int i);//The function for the thread(s) to exist in until the program needs to close
 	bool init = false;
 	std::mutex lockShared;
 	std::mutex lockThreads;
-	volatile uint32_t n = 0;//This is the number of tasks a thread might work on - maximum
-	volatile uint32_t N = 0;//Total number of tasks in a Dispatch call
+	void run(uint64_t taskCount);//Releases the threads on the current task function and waits for them
+	volatile uint64_t n = 0;//This is the number of tasks a thread might work on - maximum
+	volatile uint64_t N = 0;//Total number of tasks in a Dispatch call
 	std::atomic_uint32_t terminated;
 	const unsigned int threadCount;
 	std::thread* threads = nullptr;//Thread pool itself
@@ -1,6 +1,6 @@
 /*
 Author: Dan Rehberg
-Modified Date: 12/9/2022
+Modified Date: 10/19/2026
 */
 #include <iostream>
 #include <stdexcept>
@@ -185,6 +185,69 @@ int main()
 	catch (...)
 	{
 	}
+
+	std::cout << "\nFixed size matrix multiplication, transpose and elementwise\n";
+	try
+	{
+		constexpr BaseMatrix<3, 2> A{ { { {-1.f,2.f},{3.f,2.f},{2.f,3.f} } } };
+		constexpr BaseMatrix<2, 3> B{ { { {4.f,5.f,6.f},{6.f,-5.f,4.f} } } };
+		constexpr BaseMatrix<3, 3> C = A * B;//Evaluated by the compiler
+		static_assert(C.at(0, 0) == 8.f && C.at(1, 1) == 5.f && C.at(2, 2) == 24.f, "(BaseMatrix) constexpr product");
+		static_assert(A.transpose().at(1, 0) == 2.f && A.transpose().transpose() == A, "(BaseMatrix) constexpr transpose");
+		std::cout << C << "\n";
+		Mat D = Mat({ {-1.f,2.f},{3.f,2.f},{2.f,3.f} }) * Mat({ {4.f,5.f,6.f},{6.f,-5.f,4.f} });
+		std::cout << "Same as ParallelMatrix result: " << ((C.getInfo() == D.getInfo()) ? "true" : "false") << '\n';
+		std::cout << "Transpose:\n" << A.transpose() << "\nSum: " << (A + A) << "\nDifference: " << (A - A) <<
+			"\nComponentwise: " << A.componentwise(A) << "\nScaled: " << (0.5f * A) << '\n';
+	}
+	catch (...)
+	{
+	}
+
+	std::cout << "\nFixed size against heap matrix, forward pass of a 1-{3,2}-1 network\n";
+	try
+	{
+		//Bias folded in as a leading 1 on every layer's input, so the weights are (inputs + 1) x outputs
+		const unsigned int trials = 1000000;
+		std::chrono::time_point<std::chrono::steady_clock> startTime, endTime;
+		BaseMatrix<1, 2> x{ { { {1.f, 0.5f} } } };
+		BaseMatrix<2, 3> w0{ { { {0.1f, -0.2f, 0.3f}, {0.4f, 0.5f, -0.6f} } } };
+		BaseMatrix<4, 2> w1{ { { {0.1f, 0.2f}, {-0.3f, 0.4f}, {0.5f, -0.6f}, {0.7f, 0.8f} } } };
+		BaseMatrix<3, 1> w2{ { { {0.2f}, {-0.4f}, {0.6f} } } };
+		Mat px({ {1.f, 0.5f} });
+		Mat pw0({ {0.1f, -0.2f, 0.3f}, {0.4f, 0.5f, -0.6f} });
+		Mat pw1({ {0.1f, 0.2f}, {-0.3f, 0.4f}, {0.5f, -0.6f}, {0.7f, 0.8f} });
+		Mat pw2({ {0.2f}, {-0.4f}, {0.6f} });
+		float fixedSum = 0.f, heapSum = 0.f;//Consumed, so the passes are not optimized away
+		startTime = std::chrono::steady_clock::now();
+		for (unsigned int i = 0; i < trials; ++i)
+		{
+			x.at(0, 1) = static_cast<float>(i & 7) * 0.125f;
+			BaseMatrix<1, 3> h0 = x * w0;
+			BaseMatrix<1, 4> b0{ { { {1.f, h0.at(0, 0), h0.at(0, 1), h0.at(0, 2)} } } };
+			BaseMatrix<1, 2> h1 = b0 * w1;
+			BaseMatrix<1, 3> b1{ { { {1.f, h1.at(0, 0), h1.at(0, 1)} } } };
+			fixedSum += (b1 * w2).at(0, 0);
+		}
+		endTime = std::chrono::steady_clock::now();
+		unsigned int timeA = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+		startTime = std::chrono::steady_clock::now();
+		for (unsigned int i = 0; i < trials; ++i)
+		{
+			px = std::vector<std::vector<float>>({ {1.f, static_cast<float>(i & 7) * 0.125f} });
+			Mat h0 = px * pw0;
+			Mat h1 = Mat({ {1.f, h0.at(0, 0), h0.at(0, 1), h0.at(0, 2)} }) * pw1;
+			Mat out = Mat({ {1.f, h1.at(0, 0), h1.at(0, 1)} }) * pw2;
+			heapSum += out.at(0, 0);
+		}
+		endTime = std::chrono::steady_clock::now();
+		unsigned int timeB = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+		std::cout << "Same outputs: " << ((fixedSum == heapSum) ? "true" : "false") << "; Fixed time: " << timeA << " ms; Heap time: " <<
+			timeB << " ms; " << trials << " passes\n";
+	}
+	catch (...)
+	{
+	}
 	{
 		ThreadPool pool(std::thread::hardware_concurrency() - 1);
 
@@ -194,7 +257,7 @@ int main()
 			Mat A({ {-1.f,2.f},{3.f,2.f},{2.f,3.f} });
 			Mat B({ {4.f,5.f,6.f},{6.f,-5.f,4.f} });
 			Mat::setParallelMatrixOps(A, B, true);
-			unsigned int tempSize = A.getDimensions().first * B.getDimensions().second;
+			size_t tempSize = A.getDimensions().first * B.getDimensions().second;
 			std::cout << "pool begin\n";
 			pool.dispatch(tempSize, &(Mat::parallelTrialA));
 			std::cout << "pool end\n";
@@ -228,7 +291,7 @@ int main()
 				//	The setup work should in fact be near identical as they both merely instantiated a ParallelMatrix object of certin dimensions.
 				Mat::setParallelMatrixOps(A, B, true);
 				Mat C(A.getDimensions().first, B.getDimensions().second);
-				unsigned int tempSize = A.getDimensions().first * B.getDimensions().second;
+				size_t tempSize = A.getDimensions().first * B.getDimensions().second;
 				startTime = std::chrono::steady_clock::now();
 				for (unsigned int i = 0; i < trials; ++i)
 					pool.dispatch(tempSize, &(Mat::parallelTrialA));
@@ -239,7 +302,7 @@ int main()
 					C = A * B;
 				endTime = std::chrono::steady_clock::now();
 				unsigned int timeB = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
-				unsigned int scale = testing.getDimensions().first;
+				size_t scale = testing.getDimensions().first;
 				std::cout << "Matrix Multiplication of: " << scale << "x" << scale << "; Parallel time: " << timeA << " (" << (static_cast<float>(timeA) / static_cast<float>(trials)) << ")" << " ms; Serial time: " <<
 					timeB << " (" << (static_cast<float>(timeB) / static_cast<float>(trials)) << ")" << " ms\n";
 			}
@@ -258,14 +321,14 @@ int main()
 			Mat B({ {7.f,8.f,9.f},{10.f,11.f,12.f} });
 			//Mat A({ {1,2,3}, {4,5,6} });
 			//Mat B({ {7,8}, {9,10}, {11, 12} });
-			unsigned int cSize = A.getDimensions().first * B.getDimensions().second;
+			size_t cSize = A.getDimensions().first * B.getDimensions().second;
 			Mat::setParallelMatrixOps(A, B, true);
 			pool.dispatch(A.getDimensions().second, &(Mat::parallelTrialB0));
 			std::cout << "Total multiplications: " << Mat::multiplications.load(std::memory_order_relaxed) << "\n";
 			std::cout << "mD: " << Mat::getMD() << "\n";
 			Mat C = A * B;
 			std::cout << "\nC:" << C << "\n";
-			unsigned int N = A.getDimensions().second;// cSize;
+			size_t N = A.getDimensions().second;// cSize;
 			std::cout << "size: " << N << "\n";
 			Mat::setTrialB1(N);
 			N = (N + 1) >> 1;
@@ -297,7 +360,7 @@ int main()
 		{
 			Mat A({ {1.f,2.f},{3.f,4.f},{5.f,6.f} });
 			Mat B({ {7.f,8.f,9.f},{10.f,11.f,12.f} });
-			unsigned int cSize = A.getDimensions().first * B.getDimensions().second;
+			size_t cSize = A.getDimensions().first * B.getDimensions().second;
 			Mat::setParallelMatrixOps(A, B, true);
 			pool.dispatch(A.getDimensions().second, &(Mat::parallelTrialC0));
 			pool.dispatch(cSize, &(Mat::parallelTrialC1));
@@ -327,12 +390,12 @@ int main()
 				Mat B = testing;
 				Mat::setParallelMatrixOps(A, B, true);
 				Mat C(A.getDimensions().first, B.getDimensions().second);
-				unsigned int tempSize = A.getDimensions().first * B.getDimensions().second;
+				size_t tempSize = A.getDimensions().first * B.getDimensions().second;
 				startTime = std::chrono::steady_clock::now();
 				for (unsigned int i = 0; i < trials; ++i)
 				{
 					pool.dispatch(A.getDimensions().second, &(Mat::parallelTrialB0));
-					unsigned int N = A.getDimensions().second;
+					size_t N = A.getDimensions().second;
 					Mat::setTrialB1(N, true);
 					N = (N + 1) >> 1;
 					while (N > 1)
@@ -354,7 +417,7 @@ int main()
 				endTime = std::chrono::steady_clock::now();
 				std::cout << "Same as serial result: " << ((C == Mat::getParallelResult()) ? "true" : "false") << '\n';
 				unsigned int timeB = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
-				unsigned int scale = testing.getDimensions().first;
+				size_t scale = testing.getDimensions().first;
 				std::cout << "Matrix Multiplication of: " << scale << "x" << scale << "; Parallel time: " << timeA << " (" << (static_cast<float>(timeA) / static_cast<float>(trials)) << ")" << " ms; Serial time: " <<
 					timeB << " (" << (static_cast<float>(timeB) / static_cast<float>(trials)) << ")" << " ms\n";
 			}
@@ -381,8 +444,8 @@ int main()
 				Mat B = testing;
 				Mat::setParallelMatrixOps(A, B, true);
 				Mat C(A.getDimensions().first, B.getDimensions().second);
-				unsigned int tempSize = A.getDimensions().first * B.getDimensions().second;
-				unsigned int totalSums = tempSize * A.getDimensions().second;
+				size_t tempSize = A.getDimensions().first * B.getDimensions().second;
+				uint64_t totalSums = tempSize * A.getDimensions().second;
 				startTime = std::chrono::steady_clock::now();
 				for (unsigned int i = 0; i < trials; ++i)
 				{
@@ -403,7 +466,7 @@ int main()
 				//Will fluctuate between equivalence and not due to int->float changes
 				//std::cout << "Same as serial result: " << ((C == Mat::getParallelResult()) ? "true" : "false") << '\n';
 				unsigned int timeB = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
-				unsigned int scale = testing.getDimensions().first;
+				size_t scale = testing.getDimensions().first;
 				std::cout << "Matrix Multiplication of: " << scale << "x" << scale << "; Parallel time: " << timeA << " (" << (static_cast<float>(timeA) / static_cast<float>(trials)) << ")" << " ms; Serial time: " <<
 					timeB << " (" << (static_cast<float>(timeB) / static_cast<float>(trials)) << ")" << " ms\n";
 			}